@@ -0,0 +1,90 @@
+// Times the version upgrade chain of a save two ways: alternating the two buffers between the
+// steps (runPatchPlan), and copying the whole save before and after every step like the chain
+// did before the buffers alternated.
+//
+// usage: chain_bench <old save> [iterations]
+#include "core/SaveBinary.h"
+#include "core/Logging.h"
+#include "core/PatcherConstants.h"
+#include "patching/PatchPlanner.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <vector>
+
+// run the plan's steps, copying the whole save into the destination before each step and back
+// into the source after it
+static bool runCopyingChain(const PatchPlan& plan, SaveBinary& oldSave, SaveBinary& newSave) {
+	for (const PatchEdge* edge : plan.edges) {
+		newSave = oldSave;
+		if (!edge->patch(oldSave, newSave)) {
+			return false;
+		}
+		oldSave = newSave;
+	}
+	return true;
+}
+
+// time iterations runs of chain on a fresh copy of data, returning the median in milliseconds
+template <typename Chain>
+static double timeChain(const std::vector<uint8_t>& data, const PatchPlan& plan, int iterations, Chain chain) {
+	std::vector<double> times;
+	for (int i = 0; i < iterations; i++) {
+		std::ostringstream log;
+		LogRedirect redirect(log);
+		auto start = std::chrono::steady_clock::now();
+		SaveBinary oldSave(data.data(), data.size());
+		SaveBinary newSave(oldSave);
+		if (!chain(plan, oldSave, newSave)) {
+			std::cerr << log.str();
+			std::exit(1);
+		}
+		times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+	}
+	std::sort(times.begin(), times.end());
+	return times[times.size() / 2];
+}
+
+int main(int argc, char* argv[]) {
+	if (argc < 2) {
+		std::cerr << "Usage: " << argv[0] << " <old save> [iterations]" << std::endl;
+		return 1;
+	}
+	int iterations = argc > 2 ? std::max(1, std::atoi(argv[2])) : 200;
+	std::ifstream file(argv[1], std::ios::binary);
+	std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	if (data.size() < MIN_SAVE_SIZE) {
+		std::cerr << "Not a save file: " << argv[1] << std::endl;
+		return 1;
+	}
+	uint16_t version = static_cast<uint16_t>((data[SAVE_VERSION_ABS_ADDRESS] << 8) | data[SAVE_VERSION_ABS_ADDRESS + 1]);
+	// chain the single version upgrades
+	PatchPlan plan = { version, version, 0, true, 0, {} };
+	for (bool extended = true; extended;) {
+		extended = false;
+		for (const PatchEdge& edge : getPatchEdges()) {
+			if (edge.fix == 0 && edge.sourceVersion == plan.targetVersion && edge.targetVersion == plan.targetVersion + 1) {
+				plan.edges.push_back(&edge);
+				plan.targetVersion = edge.targetVersion;
+				extended = true;
+			}
+		}
+	}
+	if (plan.edges.empty()) {
+		std::cerr << "No upgrade from save version " << version << std::endl;
+		return 1;
+	}
+
+	// the first runs build the symbol databases and cached plans
+	timeChain(data, plan, 3, runPatchPlan);
+	double alternating = timeChain(data, plan, iterations, runPatchPlan);
+	double copying = timeChain(data, plan, iterations, runCopyingChain);
+	std::cout << "save version " << version << " to " << plan.targetVersion << ", " << plan.edges.size() << " steps, median of " << iterations << " runs" << std::endl;
+	std::cout << "alternating buffers: " << alternating << " ms" << std::endl;
+	std::cout << "copying buffers:     " << copying << " ms" << std::endl;
+	return 0;
+}
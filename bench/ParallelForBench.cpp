@@ -0,0 +1,142 @@
+// Times parallelFor against the serial loop: the cost of a call with the box check's shape
+// (one job per 32 box mons), on the shared pool and spawning threads per call like parallelFor
+// first did, patchNewboxBanks with one worker and with several, and the upgrade of a save with
+// one worker and with several.
+//
+// usage: ParallelForBench [save] [workers] [iterations]
+#include "core/CommonPatchFunctions.h"
+#include "core/Logging.h"
+#include "core/PatcherConstants.h"
+#include "core/SaveBinary.h"
+#include "core/ThreadPool.h"
+#include "patching/PatchPlanner.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+// parallelFor as it first was, starting and joining its threads on every call
+static void spawningParallelFor(size_t count, const std::function<void(size_t)>& job) {
+	size_t workers = std::min<size_t>(getWorkerCount(), count);
+	std::atomic<size_t> next(0);
+	auto work = [&next, count, &job]() {
+		for (size_t i = next++; i < count; i = next++) {
+			job(i);
+		}
+	};
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < workers; i++) {
+		threads.emplace_back(work);
+	}
+	work();
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+}
+
+// time iterations runs of job, returning the median in milliseconds
+template <typename Job>
+static double timeMedian(int iterations, Job job) {
+	std::vector<double> times;
+	for (int i = 0; i < iterations; i++) {
+		auto start = std::chrono::steady_clock::now();
+		job();
+		times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+	}
+	std::sort(times.begin(), times.end());
+	return times[times.size() / 2];
+}
+
+int main(int argc, char* argv[]) {
+	unsigned workers = argc > 2 ? static_cast<unsigned>(std::max(2, std::atoi(argv[2]))) : std::max(2u, std::thread::hardware_concurrency());
+	int iterations = argc > 3 ? std::max(1, std::atoi(argv[3])) : 200;
+	std::cout << std::thread::hardware_concurrency() << " hardware threads, " << workers << " workers, median of " << iterations << " runs" << std::endl;
+
+	// check the checksums of 20 banks of box mons, split like the box check
+	std::vector<uint8_t> mons(20 * 40 * NEWBOX_MON_SIZE);
+	for (size_t i = 0; i < mons.size(); i++) {
+		mons[i] = static_cast<uint8_t>(i * 7);
+	}
+	size_t monCount = mons.size() / NEWBOX_MON_SIZE;
+	size_t shards = (monCount + 31) / 32;
+	std::vector<uint32_t> matched(shards);
+	auto shard = [&mons, &matched, monCount](size_t i) {
+		matched[i] = 0;
+		for (size_t j = i * 32; j < std::min(monCount, i * 32 + 32); j++) {
+			const uint8_t* mon = mons.data() + j * NEWBOX_MON_SIZE;
+			matched[i] += calculateNewboxChecksum(mon) == extractStoredNewboxChecksum(mon);
+		}
+	};
+	setWorkerCount(1);
+	double serial = timeMedian(iterations, [&]() { parallelFor(shards, shard); });
+	setWorkerCount(workers);
+	double pooled = timeMedian(iterations, [&]() { parallelFor(shards, shard); });
+	double spawning = timeMedian(iterations, [&]() { spawningParallelFor(shards, shard); });
+	std::cout << "box check, " << shards << " jobs" << std::endl;
+	std::cout << "  serial:          " << serial << " ms" << std::endl;
+	std::cout << "  shared pool:     " << pooled << " ms" << std::endl;
+	std::cout << "  spawned threads: " << spawning << " ms" << std::endl;
+
+	// patch the same mons as 20 banks of a save, with valid checksums so every mon is patched
+	std::vector<uint8_t> saveData(std::max<size_t>(MIN_SAVE_SIZE, mons.size()));
+	std::copy(mons.begin(), mons.end(), saveData.begin());
+	std::vector<NewboxBank> banks;
+	for (uint32_t i = 0; i < 20; i++) {
+		banks.push_back({"bank", i * 40 * NEWBOX_MON_SIZE, 40});
+		for (uint32_t j = 0; j < 40; j++) {
+			writeNewboxChecksum(saveData.data() + (i * 40 + j) * NEWBOX_MON_SIZE);
+		}
+	}
+	SaveBinary boxSave(saveData.data(), saveData.size());
+	auto patchBanks = [&boxSave, &banks]() {
+		std::ostringstream log;
+		LogRedirect redirect(log);
+		patchNewboxBanks(boxSave, banks, [](uint8_t* mon, size_t index) {
+			mon[0x1F] ^= static_cast<uint8_t>(index);
+		});
+	};
+	setWorkerCount(1);
+	double patchBanksSerial = timeMedian(iterations, patchBanks);
+	setWorkerCount(workers);
+	double patchBanksPooled = timeMedian(iterations, patchBanks);
+	std::cout << "box patch, " << monCount << " mons" << std::endl;
+	std::cout << "  1 worker:        " << patchBanksSerial << " ms" << std::endl;
+	std::cout << "  " << workers << " workers:       " << patchBanksPooled << " ms" << std::endl;
+
+	if (argc < 2) {
+		return 0;
+	}
+	std::ifstream file(argv[1], std::ios::binary);
+	std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	if (data.size() < MIN_SAVE_SIZE) {
+		std::cerr << "Not a save file: " << argv[1] << std::endl;
+		return 1;
+	}
+	uint16_t version = static_cast<uint16_t>((data[SAVE_VERSION_ABS_ADDRESS] << 8) | data[SAVE_VERSION_ABS_ADDRESS + 1]);
+	const PatchPlan& plan = getPatchPlan(version, getLatestSaveVersion(), 0);
+	auto patch = [&data, &plan]() {
+		std::ostringstream log;
+		LogRedirect redirect(log);
+		SaveBinary oldSave(data.data(), data.size());
+		SaveBinary newSave(oldSave);
+		if (!runPatchPlan(plan, oldSave, newSave)) {
+			std::cerr << log.str();
+			std::exit(1);
+		}
+	};
+	setWorkerCount(1);
+	patch();
+	double patchSerial = timeMedian(iterations, patch);
+	setWorkerCount(workers);
+	double patchPooled = timeMedian(iterations, patch);
+	std::cout << "upgrade of " << argv[1] << " from version " << version << std::endl;
+	std::cout << "  1 worker:        " << patchSerial << " ms" << std::endl;
+	std::cout << "  " << workers << " workers:       " << patchPooled << " ms" << std::endl;
+	return 0;
+}
@@ -0,0 +1,112 @@
+// Times loading the version 7 to 10 symbol files: the std::regex parser the patcher started out
+// with against the single pass scanner SymbolDatabase parses text .sym files with, and checks
+// both find the same symbols. The embedded tables the patcher uses are timed for reference.
+//
+// usage: SymbolParseBench [iterations] [resources dir]
+#include "core/SymbolDatabase.h"
+#include "core/SymbolDatabaseContents.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct RegexSymbol {
+	uint8_t bank;
+	uint16_t address;
+	std::string name;
+};
+
+// the original parser: a std::regex match and std::stoi per line
+static std::unordered_map<std::string, RegexSymbol> parseWithRegex(const std::string& data) {
+	std::unordered_map<std::string, RegexSymbol> symbols;
+	std::istringstream stream(data);
+	std::string line;
+	std::regex symbolRegex(R"((\w{2}):(\w{4})\s([A-Za-z0-9_.]+))");
+	std::smatch match;
+	while (std::getline(stream, line)) {
+		if (!line.empty() && line.back() == '\r') {
+			line.pop_back();
+		}
+		if (!std::regex_match(line, match, symbolRegex)) {
+			continue;
+		}
+		RegexSymbol symbol;
+		symbol.bank = static_cast<uint8_t>(std::stoi(match[1].str(), nullptr, 16));
+		symbol.address = static_cast<uint16_t>(std::stoi(match[2].str(), nullptr, 16));
+		symbol.name = match[3].str();
+		symbols[symbol.name] = symbol;
+	}
+	return symbols;
+}
+
+// time iterations runs of job, returning the median in milliseconds
+template <typename Job>
+static double timeMedian(int iterations, Job job) {
+	std::vector<double> times;
+	for (int i = 0; i < iterations; i++) {
+		auto start = std::chrono::steady_clock::now();
+		job();
+		times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+	}
+	std::sort(times.begin(), times.end());
+	return times[times.size() / 2];
+}
+
+// check that the scanner found every symbol the regex parser did, with the same bank and address
+static bool sameSymbols(const std::unordered_map<std::string, RegexSymbol>& expected, const SymbolDatabase& database) {
+	if (expected.size() != database.size()) {
+		return false;
+	}
+	for (const auto& entry : expected) {
+		const SymbolDatabase::Symbol* symbol = database.findSymbol(entry.first);
+		if (symbol == nullptr || symbol->bank != entry.second.bank || symbol->address != entry.second.address) {
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char* argv[]) {
+	int iterations = argc > 1 ? std::max(1, std::atoi(argv[1])) : 10;
+	std::string resources = argc > 2 ? argv[2] : "resources";
+	const unsigned char* tables[] = { version7_sym_data, version8_sym_data, version9_sym_data, version10_sym_data };
+	const unsigned tableLengths[] = { version7_sym_len, version8_sym_len, version9_sym_len, version10_sym_len };
+
+	bool success = true;
+	std::cout << "median of " << iterations << " runs (ms)" << std::endl;
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << std::left << std::setw(16) << "file" << std::right << std::setw(8) << "symbols" << std::setw(10) << "regex" << std::setw(10) << "scanner" << std::setw(10) << "embedded" << std::endl;
+	for (int version = 7; version <= 10; version++) {
+		std::string path = resources + "/version" + std::to_string(version) + "/version" + std::to_string(version) + ".sym";
+		std::ifstream file(path, std::ios::binary);
+		if (!file.is_open()) {
+			std::cerr << "Failed to open " << path << std::endl;
+			return 1;
+		}
+		std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data.data());
+
+		std::unordered_map<std::string, RegexSymbol> expected = parseWithRegex(data);
+		SymbolDatabase scanned(bytes, data.size());
+		if (!sameSymbols(expected, scanned)) {
+			std::cerr << "The parsers disagree on " << path << std::endl;
+			success = false;
+		}
+
+		double regex = timeMedian(iterations, [&data]() { parseWithRegex(data); });
+		double scanner = timeMedian(iterations, [bytes, &data]() { SymbolDatabase database(bytes, data.size()); });
+		const unsigned char* table = tables[version - 7];
+		unsigned tableLength = tableLengths[version - 7];
+		double embedded = timeMedian(iterations, [table, tableLength]() { SymbolDatabase database(symbol_names_pool_data, symbol_names_pool_len, table, tableLength); });
+		std::cout << std::left << std::setw(16) << path.substr(path.rfind('/') + 1) << std::right << std::setw(8) << expected.size() << std::setw(10) << regex << std::setw(10) << scanner << std::setw(10) << embedded << std::endl;
+	}
+	return success ? 0 : 1;
+}
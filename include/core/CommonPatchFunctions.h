@@ -1,8 +1,14 @@
 #ifndef COMMON_PATCH_FUNCTIONS_H
 #define COMMON_PATCH_FUNCTIONS_H
 #include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include "SaveBinary.h"
+#include "SaveChecksum.h"
 #include "SymbolDatabase.h"
+#include "SymbolSet.h"
 #include "PatcherConstants.h"
 #include "Logging.h"
 
@@ -14,8 +20,21 @@ struct SourceDest {
 	const SymbolDatabase &destSym;
 };
 
-// calculateSaveChecksum function
-uint16_t calculateSaveChecksum(SaveBinary save, uint32_t start, uint32_t end);
+// Each patch step reads from one buffer and writes into the other, which must already
+// hold a copy of the source. Between steps the two buffers swap roles, and the buffer
+// that becomes the new destination only catches up on the blocks the last step wrote,
+// so no full copies are made after the initial load.
+void swapChainBuffers(SaveBinary*& source, SaveBinary*& dest);
+
+// calculate the checksum of the save data in [start, end), e.g. sGameData to sGameDataEnd
+uint16_t calculateSaveChecksum(const SaveBinary& save, uint32_t start, uint32_t end);
+
+// keep the sGameData and sBackupGameData checksums of save up to date as it is written, so
+// the final calculateSaveChecksum calls only cost as much as the bytes that changed
+void trackGameDataChecksums(SaveBinary& save, const SymbolDatabase& sym);
+
+// same as above when the current checksums are already known (e.g. just verified)
+void trackGameDataChecksums(SaveBinary& save, const SymbolDatabase& sym, uint16_t checksum, uint16_t backupChecksum);
 
 // copy length bytes from source to dest
 void copyDataBlock(SourceDest &sd, uint32_t source, uint32_t dest, int length);
@@ -53,35 +72,187 @@ uint16_t extractStoredNewboxChecksum(const SaveBinary& save, uint32_t startAddre
 // Write the newbox checksum for the given mon
 void writeNewboxChecksum(SaveBinary& save, uint32_t startAddress);
 
+// the bytes of a newbox mon (savemon_struct), all covered by its checksum
+constexpr uint32_t NEWBOX_MON_SIZE = 0x31;
+
+// Calculate the newbox checksum of the NEWBOX_MON_SIZE bytes of a mon
+uint16_t calculateNewboxChecksum(const uint8_t* mon);
+
+// Extract the stored newbox checksum from the NEWBOX_MON_SIZE bytes of a mon
+uint16_t extractStoredNewboxChecksum(const uint8_t* mon);
+
+// Write the newbox checksum into the NEWBOX_MON_SIZE bytes of a mon
+void writeNewboxChecksum(uint8_t* mon);
+
+// a bank of count newbox mons starting at address (e.g. sBoxMons1A)
+struct NewboxBank {
+	const char* name;
+	uint32_t address;
+	uint32_t count;
+};
+
+// patch every mon of the banks whose stored checksum matches with patch, which changes the mon's
+// NEWBOX_MON_SIZE bytes in place and gets the mon's index counting through all the banks, then
+// write its new checksum. The banks are disjoint, so they are patched in shards on the worker
+// threads (see ThreadPool.h): patch must only change state of its own mon index. The shards'
+// messages are kept and the mons written in order on the calling thread, leaving the save and
+// the log as if patched one by one.
+bool patchNewboxBanks(SaveBinary& save, const std::vector<NewboxBank>& banks, const std::function<void(uint8_t*, size_t)>& patch);
+
+// same as above, with patch converting the mons as T (e.g. savemon_struct_v8), taking the mon's
+// index as well if it needs one
+template <typename T, typename Patch>
+bool patchNewboxBanks(SaveBinary& save, const std::vector<NewboxBank>& banks, Patch patch) {
+	static_assert(sizeof(T) == NEWBOX_MON_SIZE, "patchNewboxBanks requires a newbox mon struct");
+	return patchNewboxBanks(save, banks, [&patch](uint8_t* data, size_t index) {
+		T mon;
+		std::memcpy(&mon, data, sizeof(T));
+		if constexpr (std::is_invocable_v<Patch&, const T&, size_t>) {
+			mon = patch(mon, index);
+		}
+		else {
+			(void)index;
+			mon = patch(mon);
+		}
+		std::memcpy(data, &mon, sizeof(T));
+	});
+}
+
+// read-only view of a packed struct (e.g. savemon_struct_v8) laid over the save data in place.
+// The range is bounds checked once on construction, an out of bounds view reads as a zeroed struct.
 template <typename T>
-T loadStruct(SaveBinary::Iterator& it, uint32_t address) {
-	T data;
-	it.seek(address);
+class StructView {
+	static_assert(std::is_trivially_copyable<T>::value, "StructView requires a trivially copyable struct");
+	static_assert(alignof(T) == 1, "StructView requires a packed struct");
+public:
+	// view the sizeof(T) bytes starting at address
+	StructView(const SaveBinary& save, uint32_t address)
+		: m_data(save.validateRange(address, address + sizeof(T)) ? reinterpret_cast<const T*>(save.getData() + address) : nullptr) {}
+	// check if the struct lies within the save data
+	bool isValid() const { return m_data != nullptr; }
+	// access the struct in place
+	const T& operator*() const { return m_data != nullptr ? *m_data : empty(); }
+	const T* operator->() const { return &**this; }
+	// copy the struct out of the save data
+	T load() const { return **this; }
 
-	// Access the raw memory of the struct
-	uint8_t* structPtr = reinterpret_cast<uint8_t*>(&data);
+private:
+	static const T& empty() {
+		static const T zeroed{};
+		return zeroed;
+	}
+	const T* m_data;
+};
 
-	// Copy data byte-by-byte into the struct
-	for (int i = 0; i < sizeof(T); i++) {
-		structPtr[i] = it.getByte();
-		it.next();
+// writable handle on a packed struct in the save data. The range is bounds checked once on
+// construction, then the struct is read with a single memcpy and written back with a single
+// tracked copy (keeping the dirty blocks and checksums in sync) instead of byte by byte.
+template <typename T>
+class StructRef {
+	static_assert(std::is_trivially_copyable<T>::value, "StructRef requires a trivially copyable struct");
+public:
+	// refer to the sizeof(T) bytes starting at address
+	StructRef(SaveBinary& save, uint32_t address)
+		: m_save(save), m_address(address), m_valid(save.validateRange(address, address + sizeof(T))) {}
+	// check if the struct lies within the save data
+	bool isValid() const { return m_valid; }
+	// get the address of the struct
+	uint32_t getAddress() const { return m_address; }
+	// copy the struct out of the save data, a zeroed struct if out of bounds
+	T load() const {
+		T data{};
+		if (m_valid) {
+			std::memcpy(&data, m_save.getData() + m_address, sizeof(T));
+		}
+		return data;
+	}
+	// write the struct back to the save data
+	bool store(const T& data) {
+		return m_valid && m_save.storeBytes(m_address, &data, sizeof(T));
 	}
 
+private:
+	SaveBinary& m_save;
+	uint32_t m_address;
+	bool m_valid;
+};
+
+// load the struct at address, leaving the iterator just past it
+template <typename T>
+T loadStruct(SaveBinary::Iterator& it, uint32_t address) {
+	T data = StructRef<T>(it.getSaveBinary(), address).load();
+	it.seek(address + sizeof(T));
 	return data;
 }
 
+// write the struct to address, leaving the iterator just past it
 template <typename T>
 void writeStruct(SaveBinary::Iterator& it, uint32_t address, const T& data) {
-	it.seek(address);
+	StructRef<T>(it.getSaveBinary(), address).store(data);
+	it.seek(address + sizeof(T));
+}
 
-	// Access the raw memory of the struct
-	const uint8_t* structPtr = reinterpret_cast<const uint8_t*>(&data);
+// a flag_array of count flags in the save data (e.g. wEventFlags), loaded as 64-bit words so runs
+// of flags can be tested and copied at once. Flag i is bit i % 8 of byte i / 8, i.e. bit i % 64 of
+// word i / 64. Changes stay in the view until store() writes them back with a single tracked copy.
+class FlagArrayView {
+public:
+	// view the flag_array(count) bytes starting at address, with every flag cleared
+	FlagArrayView(uint32_t address, uint32_t count);
+	// view the flag_array(count) bytes starting at address, loaded from save.
+	// The range is bounds checked once, an out of bounds view reads as all flags cleared.
+	FlagArrayView(const SaveBinary& save, uint32_t address, uint32_t count);
+	// check if the flags were loaded from within the save data
+	bool isValid() const { return m_valid; }
+	// get the number of flags
+	uint32_t getCount() const { return m_count; }
+	// check if the flag is set
+	bool test(uint32_t flag) const;
+	// set the flag, returns false if it was already set (or is out of range)
+	bool set(uint32_t flag);
+	// clear the flag
+	void reset(uint32_t flag);
+	// get the set flags, lowest first
+	std::vector<uint32_t> getSetFlags() const;
+	// the flags as words, the bits past count are always clear
+	const std::vector<uint64_t>& getWords() const { return m_words; }
+	std::vector<uint64_t>& getWords() { return m_words; }
+	// write the flags back to the save data, keeping the bits past count in the last byte
+	bool store(SaveBinary& save) const;
 
-	// Write data byte-by-byte
-	for (size_t i = 0; i < sizeof(T); i++) {
-		it.setByte(structPtr[i]);
-		it.next();
-	}
-}
+private:
+	// check that the flag is within the array, reporting it otherwise
+	bool checkFlag(uint32_t flag) const;
+	uint32_t m_address;
+	uint32_t m_count;
+	bool m_valid;
+	std::vector<uint64_t> m_words;
+};
+
+// converts the flags of a flag_array of one version to the flag_array of another, e.g. wEventFlags
+// with mapV7EventFlagToV8. The converted index of every flag is looked up once into a permutation
+// table. Source words whose flags all keep their index are then copied whole, and only the set
+// flags of the remaining words are moved one by one.
+class FlagRemap {
+public:
+	// converted index of the flags without a counterpart in the destination
+	static constexpr uint32_t DROPPED = 0xFFFFFFFF;
+	// called with the (flag, converted flag) of every set flag that is moved or dropped
+	using Report = std::function<void(uint32_t, uint32_t)>;
+
+	// build the table converting sourceCount flags to destCount flags with convert, which returns
+	// the converted index of a flag or DROPPED
+	FlagRemap(uint32_t sourceCount, uint32_t destCount, const std::function<uint32_t(uint32_t)>& convert);
+	// set the converted flags of source in dest, dest must start out clear where flags are copied
+	bool apply(const FlagArrayView& source, FlagArrayView& dest, const Report& report = nullptr) const;
+
+private:
+	uint32_t m_sourceCount;
+	uint32_t m_destCount;
+	// converted index of every source flag
+	std::vector<uint32_t> m_table;
+	// whether every flag of a source word keeps its index
+	std::vector<bool> m_copyWord;
+};
 
 #endif
@@ -0,0 +1,175 @@
+#ifndef INDEX_MAP_H
+#define INDEX_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Dense lookup tables converting the indexes of one save version to another (items, event
+// flags, maps, ...), built at compile time from the entry lists tools/map_*.py print.
+// A lookup is a single array read, and the entry lists are checked at compile time, e.g.
+//
+//	static constexpr IndexMapEntry<uint8_t, uint8_t> entries[] = {
+//		{0x00, 0x01},  // BICYCLE
+//		...
+//	};
+//	static_assert(hasUniqueIndexes(entries) && isInjective(entries, 0xFF), "...");
+//	static constexpr IndexMap<uint8_t, uint8_t, indexMapSize(entries)> indexMap(entries, 0xFF);
+//	return indexMap(v7);
+
+// a pair of indexes, e.g. a (group, map) map or a (species, form) pair
+struct IndexPair {
+	uint8_t first;
+	uint8_t second;
+};
+
+// an entry converting the index from to to
+template <typename From, typename To>
+struct IndexMapEntry {
+	From from;
+	To to;
+};
+
+namespace indexMapDetail {
+	// keeps a parameter out of template argument deduction, e.g. an int literal fallback
+	template <typename T>
+	struct NonDeduced {
+		using type = T;
+	};
+
+	// the index of a value in the seen bitset below
+	constexpr uint32_t flatIndex(uint8_t value) { return value; }
+	constexpr uint32_t flatIndex(uint16_t value) { return value; }
+	constexpr uint32_t flatIndex(IndexPair value) { return (value.first << 8) | value.second; }
+
+	// count the entries whose index (from) or converted index (to) repeats an earlier entry's
+	template <typename From, typename To, size_t N>
+	constexpr size_t countRepeated(const IndexMapEntry<From, To> (&entries)[N], bool to) {
+		uint64_t seen[0x10000 / 64] = {};
+		size_t repeated = 0;
+		for (size_t i = 0; i < N; i++) {
+			uint32_t index = to ? flatIndex(entries[i].to) : flatIndex(entries[i].from);
+			uint64_t bit = uint64_t(1) << (index % 64);
+			if (seen[index / 64] & bit) {
+				repeated++;
+			}
+			seen[index / 64] |= bit;
+		}
+		return repeated;
+	}
+}
+
+// check that every index is converted by a single entry
+template <typename From, typename To, size_t N>
+constexpr bool hasUniqueIndexes(const IndexMapEntry<From, To> (&entries)[N]) {
+	return indexMapDetail::countRepeated(entries, false) == 0;
+}
+
+// count the entries converted to the same index as an earlier entry, i.e. merged indexes
+template <typename From, typename To, size_t N>
+constexpr size_t countMergedIndexes(const IndexMapEntry<From, To> (&entries)[N]) {
+	return indexMapDetail::countRepeated(entries, true);
+}
+
+// check that no two entries are converted to the same index, nor to the fallback of unconverted ones
+template <typename From, typename To, size_t N>
+constexpr bool isInjective(const IndexMapEntry<From, To> (&entries)[N], typename indexMapDetail::NonDeduced<To>::type fallback) {
+	for (size_t i = 0; i < N; i++) {
+		if (indexMapDetail::flatIndex(entries[i].to) == indexMapDetail::flatIndex(fallback)) {
+			return false;
+		}
+	}
+	return countMergedIndexes(entries) == 0;
+}
+
+// the size of a table holding every index of entries
+template <typename From, typename To, size_t N>
+constexpr size_t indexMapSize(const IndexMapEntry<From, To> (&entries)[N]) {
+	size_t size = 0;
+	for (size_t i = 0; i < N; i++) {
+		if (size_t(entries[i].from) + 1 > size) {
+			size = size_t(entries[i].from) + 1;
+		}
+	}
+	return size;
+}
+
+// the (rows, columns) size of a table holding every index pair of entries
+template <typename To, size_t N>
+constexpr IndexPair indexMap2DSize(const IndexMapEntry<IndexPair, To> (&entries)[N]) {
+	IndexPair size = {0, 0};
+	for (size_t i = 0; i < N; i++) {
+		if (entries[i].from.first >= size.first) {
+			size.first = entries[i].from.first + 1;
+		}
+		if (entries[i].from.second >= size.second) {
+			size.second = entries[i].from.second + 1;
+		}
+	}
+	return size;
+}
+
+// a table converting the indexes [0, Size)
+template <typename From, typename To, size_t Size>
+class IndexMap {
+public:
+	// indexes without an entry convert to the fallback
+	template <size_t N>
+	constexpr IndexMap(const IndexMapEntry<From, To> (&entries)[N], To fallback) : m_values{}, m_fallback(fallback), m_identity(false) {
+		for (size_t i = 0; i < Size; i++) {
+			m_values[i] = fallback;
+		}
+		for (size_t i = 0; i < N; i++) {
+			m_values[entries[i].from] = entries[i].to;
+		}
+	}
+
+	// indexes without an entry convert to themselves
+	template <size_t N>
+	constexpr explicit IndexMap(const IndexMapEntry<From, To> (&entries)[N]) : m_values{}, m_fallback{}, m_identity(true) {
+		for (size_t i = 0; i < Size; i++) {
+			m_values[i] = To(i);
+		}
+		for (size_t i = 0; i < N; i++) {
+			m_values[entries[i].from] = entries[i].to;
+		}
+	}
+
+	constexpr To operator()(From index) const {
+		if (size_t(index) < Size) {
+			return m_values[index];
+		}
+		return m_identity ? To(index) : m_fallback;
+	}
+
+private:
+	To m_values[Size];
+	To m_fallback;
+	bool m_identity;
+};
+
+// a table converting the index pairs [0, Rows) x [0, Columns), pairs without an entry convert to the fallback
+template <typename To, size_t Rows, size_t Columns>
+class IndexMap2D {
+public:
+	template <size_t N>
+	constexpr IndexMap2D(const IndexMapEntry<IndexPair, To> (&entries)[N], To fallback) : m_values{}, m_fallback(fallback) {
+		for (size_t row = 0; row < Rows; row++) {
+			for (size_t column = 0; column < Columns; column++) {
+				m_values[row][column] = fallback;
+			}
+		}
+		for (size_t i = 0; i < N; i++) {
+			m_values[entries[i].from.first][entries[i].from.second] = entries[i].to;
+		}
+	}
+
+	constexpr To operator()(size_t row, size_t column) const {
+		return row < Rows && column < Columns ? m_values[row][column] : m_fallback;
+	}
+
+private:
+	To m_values[Rows][Columns];
+	To m_fallback;
+};
+
+#endif
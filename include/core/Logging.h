@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <streambuf>
+#include <string>
 #include <vector>
 #ifndef CLI_VERSION
 #include <emscripten/emscripten.h>
@@ -27,8 +28,46 @@ private:
 	void logToJs(const std::string& message);
 };
 
-extern std::ostream js_info; // output stream for info messages
-extern std::ostream js_warning; // output stream for warning messages
-extern std::ostream js_error; // output stream for error messages
+// Every thread has its own streams, so messages (and std::hex and the like) of patches running
+// at the same time (batch mode) don't mix.
+extern thread_local std::ostream js_info; // output stream for info messages
+extern thread_local std::ostream js_warning; // output stream for warning messages
+extern thread_local std::ostream js_error; // output stream for error messages
+
+// send the messages logged on the calling thread to sink instead of the console while alive
+// (e.g. to keep the log of each save in batch mode)
+class LogRedirect {
+public:
+	explicit LogRedirect(std::ostream& sink);
+	~LogRedirect();
+	LogRedirect(const LogRedirect&) = delete;
+	LogRedirect& operator=(const LogRedirect&) = delete;
+private:
+	std::ostream* m_previous;
+};
+
+// a message kept by LogCapture
+struct LogMessage {
+	LogLevel level;
+	std::string text;
+	// the format flags (std::hex and the like) of the stream once the message was logged
+	std::ios_base::fmtflags flags;
+};
+
+// keep the messages logged on the calling thread in messages instead of sending them anywhere
+// while alive (e.g. so a job on a worker thread can have its log written in order afterwards)
+class LogCapture {
+public:
+	explicit LogCapture(std::vector<LogMessage>& messages);
+	~LogCapture();
+	LogCapture(const LogCapture&) = delete;
+	LogCapture& operator=(const LogCapture&) = delete;
+private:
+	std::vector<LogMessage>* m_previous;
+};
+
+// log messages kept by a LogCapture on the calling thread, as if they were logged here (leaving
+// the streams' format flags as the messages did)
+void replayLog(const std::vector<LogMessage>& messages);
 
 #endif // LOGGING_H
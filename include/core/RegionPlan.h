@@ -0,0 +1,104 @@
+#ifndef REGIONPLAN_H
+#define REGIONPLAN_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "CommonPatchFunctions.h"
+
+// The region operations of a patch step (copies, clears, fills and conversions from the source
+// save to the destination save), built once and then executed on every save. Compiling the plan
+// resolves the copies, clears and fills into the bytes they finally leave, as if run in order,
+// and merges them into the fewest copy and fill runs. Each run is bounds checked once and
+// written with a single copyBytes or fillBytes. The conversions then run in the order added, and
+// every operation is logged in that order once its bytes are written (or reported if they failed).
+// Operations with an empty description aren't logged.
+//
+//	static RegionPlan plan = [] {
+//		RegionPlan plan;
+//		plan.copy(sym::v8::wCurBox_PlayerData, sym::v9::wCurBox_PlayerData, 1, "wCurBox");
+//		...
+//		return plan;
+//	}();
+//	static const bool compiled = plan.compile();
+//	if (!compiled || !plan.execute(save8, save9)) {
+//		return false;
+//	}
+
+class RegionPlan {
+public:
+	// converted value of the bytes without a counterpart, which are kept as they are
+	static constexpr int UNMAPPED = -1;
+	// called with the (byte, converted byte) of every byte that is changed or UNMAPPED
+	using ByteReport = std::function<void(uint8_t, int)>;
+
+	// copy length bytes from source in the source save to dest
+	void copy(uint32_t source, uint32_t dest, uint32_t length, std::string description);
+	// clear (0x00) length bytes starting at dest
+	void clear(uint32_t dest, uint32_t length, std::string description);
+	// fill length bytes starting at dest with value
+	void fill(uint32_t dest, uint32_t length, uint8_t value, std::string description);
+	// convert the bytes [source, source + length) with convert (the converted byte or UNMAPPED),
+	// writing the ones that change to dest. Stops at the first terminator byte if it is >= 0.
+	void remapBytes(uint32_t source, uint32_t dest, uint32_t length, int terminator, const std::function<int(uint8_t)>& convert, std::string description, ByteReport report = nullptr);
+	// convert the flag_array of sourceCount flags at source with remap into the destCount flags at
+	// dest. dest must start out clear.
+	void remapFlags(const FlagRemap& remap, uint32_t source, uint32_t sourceCount, uint32_t dest, uint32_t destCount, std::string description, FlagRemap::Report report = nullptr);
+	// clear flags in the flag_array of count flags at dest, calling report with each flag first
+	void resetFlags(uint32_t dest, uint32_t count, std::vector<uint32_t> flags, std::string description, std::function<void(uint32_t)> report = nullptr);
+	// convert the count structs at source to the structs at dest with convert
+	template <typename From, typename To>
+	void convertStructs(uint32_t source, uint32_t dest, uint32_t count, To (*convert)(const From&), std::string description);
+	// resolve and merge the copies, clears and fills into runs. Returns false (reporting it) if a
+	// conversion is followed by a region operation overwriting its destination.
+	bool compile();
+	// run the plan from source into dest, which must already hold a copy of source
+	bool execute(const SaveBinary& source, SaveBinary& dest) const;
+	// get the number of copy and fill runs the plan compiled into
+	size_t getRunCount() const { return m_runs.size(); }
+
+private:
+	// a copy, clear or fill, or the destination of a conversion
+	struct Operation {
+		uint32_t dest;
+		uint32_t length;
+		// the source address of a copy
+		uint32_t source;
+		uint8_t value;
+		bool isCopy;
+		bool isConversion;
+		std::string description;
+		// run the conversion
+		std::function<bool(const SaveBinary&, SaveBinary&)> convert;
+	};
+	// a copy or fill of consecutive bytes
+	struct Run {
+		uint32_t dest;
+		uint32_t length;
+		uint32_t source;
+		uint8_t value;
+		bool isCopy;
+	};
+
+	std::vector<Operation> m_operations;
+	std::vector<Run> m_runs;
+	bool m_compiled = false;
+
+	// add a conversion writing [dest, dest + length)
+	void addConversion(uint32_t dest, uint32_t length, std::string description, std::function<bool(const SaveBinary&, SaveBinary&)> convert);
+};
+
+template <typename From, typename To>
+void RegionPlan::convertStructs(uint32_t source, uint32_t dest, uint32_t count, To (*convert)(const From&), std::string description) {
+	addConversion(dest, count * sizeof(To), std::move(description), [source, dest, count, convert](const SaveBinary& sourceSave, SaveBinary& destSave) {
+		for (uint32_t i = 0; i < count; i++) {
+			if (!StructRef<To>(destSave, dest + i * sizeof(To)).store(convert(*StructView<From>(sourceSave, source + i * sizeof(From))))) {
+				return false;
+			}
+		}
+		return true;
+	});
+}
+
+#endif // REGIONPLAN_H
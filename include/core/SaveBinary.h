@@ -3,17 +3,75 @@
 
 #include <string>
 #include <vector>
+#include <cstddef>
 #include <cstdint>
+#include <algorithm>
+
+// the CLI build on POSIX systems can map save files directly instead of reading them
+// into a heap buffer. Other builds (web, Windows) fall back to regular file I/O.
+#if defined(CLI_VERSION) && !defined(_WIN32) && (defined(__unix__) || defined(__APPLE__))
+#define SAVEBINARY_USE_MMAP 1
+#endif
+
+// access policies for BasicSaveBinary
+// CheckedAccess validates the lock state and bounds of every access and reports failures
+struct CheckedAccess {
+	static constexpr bool checked = true;
+};
+// UncheckedAccess skips the per access bounds checks, the caller validates the ranges it uses
+// up front (see validateRange). Writes still check the lock state and read-only mappings, and
+// bulk operations such as copyBytes are always checked.
+struct UncheckedAccess {
+	static constexpr bool checked = false;
+};
+
+class SymbolDatabase;
+
+// error reporting shared by every access policy, kept out of line so the accessors stay small.
+// Addresses are annotated with the symbol they fall in when the save has a symbol database.
+namespace saveBinaryDetail {
+	void reportOutOfBounds(uint32_t address, const SymbolDatabase* symbols);
+	void reportOutOfBounds(uint32_t address, uint32_t length, const SymbolDatabase* symbols);
+	void reportLocked();
+	void reportReadOnly();
+}
 
 // This class is used to store the save binary data. The save file is 2Mib in size.
-// it can be initiated by inputing the path to the save file.
+// it can be initiated by inputing the path to the save file, or directly from
+// an in-memory buffer so callers (e.g. the browser) can skip the filesystem.
+// In the CLI build the file can also be memory mapped (see MapMode).
+// The access policy decides whether every access is checked (see SaveBinary below).
 
-class SaveBinary {
+template <typename AccessPolicy>
+class BasicSaveBinary {
 public:
+	// how a save file is mapped into memory
+	enum class MapMode {
+		// read-only view of the file, writes are rejected
+		READ_ONLY,
+		// copy-on-write view, writes stay in memory until save() is called
+		PRIVATE
+	};
+
 	// Constructor
-	SaveBinary(const std::string& saveFilePath);
+	BasicSaveBinary(const std::string& saveFilePath);
+	// Constructor mapping the save file with the requested mode.
+	// Falls back to reading the file into memory where mapping is unavailable.
+	BasicSaveBinary(const std::string& saveFilePath, MapMode mode);
+	// Constructor from an in-memory buffer (the bytes are copied once)
+	BasicSaveBinary(const uint8_t* data, size_t length);
+	// Constructor taking ownership of an existing buffer (no copy)
+	BasicSaveBinary(std::vector<uint8_t>&& data);
+	// Copy constructor (the copy always owns its own in-memory buffer)
+	BasicSaveBinary(const BasicSaveBinary& other);
+	// Move constructor
+	BasicSaveBinary(BasicSaveBinary&& other) noexcept;
+	// Copy assignment (writes into a private mapping of the same size)
+	BasicSaveBinary& operator=(const BasicSaveBinary& other);
+	// Move assignment
+	BasicSaveBinary& operator=(BasicSaveBinary&& other) noexcept;
 	// Destructor
-	~SaveBinary();
+	~BasicSaveBinary();
 	// Get the byte at the specified address
 	uint8_t getByte(uint32_t address) const;
 	// get the word at the specified address (little endian)
@@ -26,18 +84,52 @@ public:
 	void setWord(uint32_t address, uint16_t value);
 	// update the word at the specified address (big endian)
 	void setWordBE(uint32_t address, uint16_t value);
+	// copy length bytes from source starting at sourceAddress to address, checking bounds and lock state once
+	bool copyBytes(uint32_t address, const BasicSaveBinary& source, uint32_t sourceAddress, uint32_t length);
+	// set length bytes starting at address to value, checking bounds and lock state once
+	bool fillBytes(uint32_t address, uint8_t value, uint32_t length);
+	// copy length bytes starting at address into dest, checking bounds once
+	bool loadBytes(uint32_t address, void* dest, uint32_t length) const;
+	// copy length bytes from src to address, checking bounds and lock state once
+	bool storeBytes(uint32_t address, const void* src, uint32_t length);
 	// lock the class to prevent further modification
 	void lock();
 	// unlock the class to allow modification
 	void unlock();
-	// save the data to the specified file
-	void save(const std::string& saveFilePath) const;
+	// save the data to the specified file, returns false if it could not be written
+	bool save(const std::string& saveFilePath) const;
+	// get a pointer to the raw save data
+	const uint8_t* getData() const;
+	// get the size of the save data in bytes
+	size_t getSize() const;
+	// check that [start, end) lies within the save data, reporting it otherwise
+	bool validateRange(uint32_t start, uint32_t end) const;
+	// move the save data out of the class, leaving it empty
+	std::vector<uint8_t> releaseData();
+	// check if the save data is backed by a file mapping
+	bool isMapped() const;
+	// forget which blocks have been written so far
+	void clearDirtyBlocks();
+	// copy every block written in either save since the last clearDirtyBlocks() from other,
+	// bringing this save up to date without copying the whole buffer
+	void copyDirtyBlocksFrom(const BasicSaveBinary& other);
+	// keep the checksum (16-bit byte sum) of [start, end) up to date on every write from now on
+	void trackChecksum(uint32_t start, uint32_t end);
+	// same as above when the current checksum of the range is already known (e.g. just verified)
+	void trackChecksum(uint32_t start, uint32_t end, uint16_t checksum);
+	// get the running checksum of a tracked range, returns false if the range isn't tracked
+	bool getTrackedChecksum(uint32_t start, uint32_t end, uint16_t& checksum) const;
+	// stop tracking all checksums
+	void clearTrackedChecksums();
+	// use the symbol database of the save's layout to annotate the addresses in error reports
+	// (nullptr reports plain addresses)
+	void setSymbols(const SymbolDatabase* symbols);
 
 	// Iterator for the save binary data
 	class Iterator {
 		public:
 			// Iterator constructor
-			Iterator(SaveBinary& saveBinary, uint32_t address);
+			Iterator(BasicSaveBinary& saveBinary, uint32_t address);
 			// Iterator destructor
 			~Iterator();
 			// Get the byte at the current address
@@ -90,17 +182,457 @@ public:
 			void copy(Iterator& it, uint32_t numBytes);
 			// copy specified number of bytes from input iterator to this iterator starting at specified address
 			void copy(Iterator& it, uint32_t address, uint32_t numBytes);
+			// set specified number of bytes to value starting at current address
+			void fill(uint8_t value, uint32_t numBytes);
 			// Return the current address
 			uint32_t getAddress();
+			// get the save binary the iterator walks
+			BasicSaveBinary& getSaveBinary() const;
 
 		private:
-			SaveBinary& m_saveBinary;
+			BasicSaveBinary& m_saveBinary;
 			uint32_t m_address;
 	};
 
 private:
+	// owned storage, unused while the data is mapped
 	std::vector<uint8_t> m_data;
+	// view of the active storage (m_data or the mapping)
+	uint8_t* m_bytes;
+	size_t m_size;
 	bool m_locked;
+	// one bit per DIRTY_BLOCK_SIZE bytes, set when the block is written
+	static constexpr uint32_t DIRTY_BLOCK_SIZE = 64;
+	std::vector<uint64_t> m_dirtyBlocks;
+	// ranges whose checksum is kept up to date on every write
+	struct TrackedChecksum {
+		uint32_t start;
+		uint32_t end;
+		uint16_t checksum;
+	};
+	std::vector<TrackedChecksum> m_trackedChecksums;
+	// mapping state
+	void* m_mapping;
+	size_t m_mappingSize;
+	MapMode m_mapMode;
+	// symbols of the save's layout for error reports, may be nullptr
+	const SymbolDatabase* m_symbols;
+	// validate the loaded buffer, clearing it if it is too small to be a save
+	bool validateSize(const std::string& source);
+	// point the view at m_data
+	void useOwnedData();
+	// check that the save data may be modified, reporting why not otherwise
+	bool checkWritable() const;
+	// size the dirty block bitmap to the current data and clear it
+	void resetDirtyBlocks();
+	// mark the block containing address as written
+	void markDirty(uint32_t address);
+	// account for the byte at address changing from oldValue to newValue in the tracked checksums
+	void updateTrackedChecksums(uint32_t address, uint8_t oldValue, uint8_t newValue);
+	// overwrite length bytes at address, keeping the dirty blocks and tracked checksums in sync
+	void writeBytes(uint32_t address, const uint8_t* src, size_t length);
+	// set length bytes at address to value, keeping the dirty blocks and tracked checksums in sync
+	void setBytes(uint32_t address, uint8_t value, size_t length);
+	// mark every block overlapping [address, address + length) as written
+	void markDirtyRange(uint32_t address, size_t length);
+	// recalculate every tracked checksum from the data
+	void recalculateTrackedChecksums();
+	// map the save file, returns false if it could not be mapped
+	bool mapFile(const std::string& saveFilePath, MapMode mode);
+	// release the mapping (if any)
+	void unmap();
+	// read the whole save file into m_data
+	void readFile(const std::string& saveFilePath);
 };
 
+// mark the block containing address as written
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::markDirty(uint32_t address) {
+	uint32_t block = address / DIRTY_BLOCK_SIZE;
+	m_dirtyBlocks[block >> 6] |= uint64_t(1) << (block & 63);
+}
+
+// check that the save data may be modified, reporting why not otherwise
+template <typename AccessPolicy>
+bool BasicSaveBinary<AccessPolicy>::checkWritable() const {
+	// error if locked
+	if (m_locked) {
+		saveBinaryDetail::reportLocked();
+		return false;
+	}
+	// error if the file is mapped read-only
+	if (m_mapping != nullptr && m_mapMode == MapMode::READ_ONLY) {
+		saveBinaryDetail::reportReadOnly();
+		return false;
+	}
+	return true;
+}
+
+// Get the byte at the specified address
+template <typename AccessPolicy>
+uint8_t BasicSaveBinary<AccessPolicy>::getByte(uint32_t address) const {
+	if constexpr (AccessPolicy::checked) {
+		if (address >= m_size) {
+			saveBinaryDetail::reportOutOfBounds(address, m_symbols);
+			return 0;
+		}
+	}
+	return m_bytes[address];
+}
+
+// get the word at the specified address (little endian)
+template <typename AccessPolicy>
+uint16_t BasicSaveBinary<AccessPolicy>::getWord(uint32_t address) const {
+	if constexpr (AccessPolicy::checked) {
+		if (address + 1 >= m_size) {
+			saveBinaryDetail::reportOutOfBounds(address, m_symbols);
+			return 0;
+		}
+	}
+	return m_bytes[address] | (m_bytes[address + 1] << 8);
+}
+
+// get the word at the specified address (big endian)
+template <typename AccessPolicy>
+uint16_t BasicSaveBinary<AccessPolicy>::getWordBE(uint32_t address) const {
+	if constexpr (AccessPolicy::checked) {
+		if (address + 1 >= m_size) {
+			saveBinaryDetail::reportOutOfBounds(address, m_symbols);
+			return 0;
+		}
+	}
+	return (m_bytes[address] << 8) | m_bytes[address + 1];
+}
+
+// update the byte at the specified address
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::setByte(uint32_t address, uint8_t value) {
+	// error if locked or read-only, in every policy since a store to a read-only mapping faults
+	if (!checkWritable()) {
+		return;
+	}
+	if constexpr (AccessPolicy::checked) {
+		// error if address out of bounds
+		if (address >= m_size) {
+			saveBinaryDetail::reportOutOfBounds(address, m_symbols);
+			return;
+		}
+	}
+	updateTrackedChecksums(address, m_bytes[address], value);
+	m_bytes[address] = value;
+	markDirty(address);
+}
+
+// update the word at the specified address (little endian)
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::setWord(uint32_t address, uint16_t value) {
+	// error if locked or read-only
+	if (!checkWritable()) {
+		return;
+	}
+	if constexpr (AccessPolicy::checked) {
+		// error if address out of bounds
+		if (address + 1 >= m_size) {
+			saveBinaryDetail::reportOutOfBounds(address, m_symbols);
+			return;
+		}
+	}
+	updateTrackedChecksums(address, m_bytes[address], value & 0xFF);
+	updateTrackedChecksums(address + 1, m_bytes[address + 1], (value >> 8) & 0xFF);
+	m_bytes[address] = value & 0xFF;
+	m_bytes[address + 1] = (value >> 8) & 0xFF;
+	markDirty(address);
+	markDirty(address + 1);
+}
+
+// update the word at the specified address (big endian)
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::setWordBE(uint32_t address, uint16_t value) {
+	// error if locked or read-only
+	if (!checkWritable()) {
+		return;
+	}
+	if constexpr (AccessPolicy::checked) {
+		// error if address out of bounds
+		if (address + 1 >= m_size) {
+			saveBinaryDetail::reportOutOfBounds(address, m_symbols);
+			return;
+		}
+	}
+	updateTrackedChecksums(address, m_bytes[address], (value >> 8) & 0xFF);
+	updateTrackedChecksums(address + 1, m_bytes[address + 1], value & 0xFF);
+	m_bytes[address] = (value >> 8) & 0xFF;
+	m_bytes[address + 1] = value & 0xFF;
+	markDirty(address);
+	markDirty(address + 1);
+}
+
+// lock the class to prevent further modification
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::lock() {
+	m_locked = true;
+}
+
+// unlock the class to allow modification
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::unlock() {
+	m_locked = false;
+}
+
+// get a pointer to the raw save data
+template <typename AccessPolicy>
+const uint8_t* BasicSaveBinary<AccessPolicy>::getData() const {
+	return m_bytes;
+}
+
+// get the size of the save data in bytes
+template <typename AccessPolicy>
+size_t BasicSaveBinary<AccessPolicy>::getSize() const {
+	return m_size;
+}
+
+// check if the save data is backed by a file mapping
+template <typename AccessPolicy>
+bool BasicSaveBinary<AccessPolicy>::isMapped() const {
+	return m_mapping != nullptr;
+}
+
+// account for the byte at address changing from oldValue to newValue in the tracked checksums
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::updateTrackedChecksums(uint32_t address, uint8_t oldValue, uint8_t newValue) {
+	for (TrackedChecksum& tracked : m_trackedChecksums) {
+		if (address >= tracked.start && address < tracked.end) {
+			tracked.checksum += newValue - oldValue;
+		}
+	}
+}
+
+// Iterator constructor
+template <typename AccessPolicy>
+BasicSaveBinary<AccessPolicy>::Iterator::Iterator(BasicSaveBinary& saveBinary, uint32_t address) : m_saveBinary(saveBinary), m_address(address) {
+}
+
+// Iterator destructor
+template <typename AccessPolicy>
+BasicSaveBinary<AccessPolicy>::Iterator::~Iterator() {
+}
+
+// Get the byte at the current address
+template <typename AccessPolicy>
+uint8_t BasicSaveBinary<AccessPolicy>::Iterator::getByte() const {
+	return m_saveBinary.getByte(m_address);
+}
+
+// Get the byte at the requested address
+template <typename AccessPolicy>
+uint8_t BasicSaveBinary<AccessPolicy>::Iterator::getByte(uint32_t address) {
+	// seek to address
+	seek(address);
+	return m_saveBinary.getByte(m_address);
+}
+
+// Get the word at the current address (little endian)
+template <typename AccessPolicy>
+uint16_t BasicSaveBinary<AccessPolicy>::Iterator::getWord() const {
+	return m_saveBinary.getWord(m_address);
+}
+
+// Get the word at the requested address (little endian)
+template <typename AccessPolicy>
+uint16_t BasicSaveBinary<AccessPolicy>::Iterator::getWord(uint32_t address) {
+	// seek to address
+	seek(address);
+	return m_saveBinary.getWord(m_address);
+}
+
+// Get the word at the current address (big endian)
+template <typename AccessPolicy>
+uint16_t BasicSaveBinary<AccessPolicy>::Iterator::getWordBE() const {
+	return m_saveBinary.getWordBE(m_address);
+}
+
+// Get the word at the requested address (big endian)
+template <typename AccessPolicy>
+uint16_t BasicSaveBinary<AccessPolicy>::Iterator::getWordBE(uint32_t address) {
+	// seek to address
+	seek(address);
+	return m_saveBinary.getWordBE(m_address);
+}
+
+// get the specified bit from the byte at the current address
+template <typename AccessPolicy>
+bool BasicSaveBinary<AccessPolicy>::Iterator::getBit(uint8_t bit) const {
+	return m_saveBinary.getByte(m_address) & (1 << bit);
+}
+
+// get the specified bit from the byte at the requested address
+template <typename AccessPolicy>
+bool BasicSaveBinary<AccessPolicy>::Iterator::getBit(uint32_t address, uint8_t bit) {
+	// seek to address
+	seek(address);
+	return m_saveBinary.getByte(m_address) & (1 << bit);
+}
+
+// Update the byte at the current address
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::Iterator::setByte(uint8_t value) {
+	m_saveBinary.setByte(m_address, value);
+}
+
+// Update the byte at the requested address
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::Iterator::setByte(uint32_t address, uint8_t value) {
+	// seek to address
+	seek(address);
+	m_saveBinary.setByte(m_address, value);
+}
+
+// Update the word at the current address (little endian)
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::Iterator::setWord(uint16_t value) {
+	m_saveBinary.setWord(m_address, value);
+}
+
+// Update the word at the requested address (little endian)
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::Iterator::setWord(uint32_t address, uint16_t value) {
+	// seek to address
+	seek(address);
+	m_saveBinary.setWord(m_address, value);
+}
+
+// Update the word at the current address (big endian)
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::Iterator::setWordBE(uint16_t value) {
+	m_saveBinary.setWordBE(m_address, value);
+}
+
+// Update the word at the requested address (big endian)
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::Iterator::setWordBE(uint32_t address, uint16_t value) {
+	// seek to address
+	seek(address);
+	m_saveBinary.setWordBE(m_address, value);
+}
+
+// set the specified bit in the byte at the current address
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::Iterator::setBit(uint8_t bit) {
+	uint8_t value = m_saveBinary.getByte(m_address);
+	value |= (1 << bit);
+	m_saveBinary.setByte(m_address, value);
+}
+
+// reset the specified bit in the byte at the current address
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::Iterator::resetBit(uint8_t bit) {
+	uint8_t value = m_saveBinary.getByte(m_address);
+	value &= ~(1 << bit);
+	m_saveBinary.setByte(m_address, value);
+}
+
+// reset the specified bit in the byte at the requested address
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::Iterator::resetBit(uint32_t address, uint8_t bit) {
+	// seek to address
+	seek(address);
+	uint8_t value = m_saveBinary.getByte(m_address);
+	value &= ~(1 << bit);
+	m_saveBinary.setByte(m_address, value);
+}
+
+// set the specified bit in the byte at the requested address
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::Iterator::setBit(uint32_t address, uint8_t bit) {
+	// seek to address
+	seek(address);
+	uint8_t value = m_saveBinary.getByte(m_address);
+	value |= (1 << bit);
+	m_saveBinary.setByte(m_address, value);
+}
+
+// Move the iterator to the next byte
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::Iterator::next() {
+	++m_address;
+}
+
+// Move the iterator to the previous byte
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::Iterator::prev() {
+	--m_address;
+}
+
+// Move the iterator to the specified address
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::Iterator::seek(uint32_t address) {
+	if (m_address == address) {
+		//js_error <<  "Iterator is already at the requested address: " << std::hex << address << std::endl;
+		return;
+	}
+	m_address = address;
+}
+
+// Get the current address
+template <typename AccessPolicy>
+uint32_t BasicSaveBinary<AccessPolicy>::Iterator::getAddress() const {
+	return m_address;
+}
+
+// Check if the iterator is at the end
+template <typename AccessPolicy>
+bool BasicSaveBinary<AccessPolicy>::Iterator::isEnd() const {
+	return m_address >= m_saveBinary.m_size;
+}
+
+// copy specified number of bytes from input iterator to this iterator starting at current address
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::Iterator::copy(Iterator& it, uint32_t numBytes) {
+	// stop at the end of the input
+	size_t available = it.isEnd() ? 0 : it.m_saveBinary.m_size - it.m_address;
+	uint32_t length = static_cast<uint32_t>(std::min<size_t>(numBytes, available));
+	// copy bytes
+	m_saveBinary.copyBytes(m_address, it.m_saveBinary, it.m_address, length);
+	it.m_address += length;
+	m_address += length;
+}
+
+// copy specified number of bytes from input iterator to this iterator starting at specified address
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::Iterator::copy(Iterator& it, uint32_t address, uint32_t numBytes) {
+	// move to specified address
+	seek(address);
+	// copy bytes
+	copy(it, numBytes);
+}
+
+// set specified number of bytes to value starting at current address
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::Iterator::fill(uint8_t value, uint32_t numBytes) {
+	m_saveBinary.fillBytes(m_address, value, numBytes);
+	m_address += numBytes;
+}
+
+// Return the current address
+template <typename AccessPolicy>
+uint32_t BasicSaveBinary<AccessPolicy>::Iterator::getAddress() {
+	return m_address;
+}
+
+// get the save binary the iterator walks
+template <typename AccessPolicy>
+BasicSaveBinary<AccessPolicy>& BasicSaveBinary<AccessPolicy>::Iterator::getSaveBinary() const {
+	return m_saveBinary;
+}
+
+// the save type used by the patcher. Accesses are checked unless the build opts into
+// SAVEBINARY_UNCHECKED_ACCESS (make release does), in which case patch_save validates the save
+// size up front (every SRAM symbol lies below MIN_SAVE_SIZE) and the accessors compile down to
+// plain loads and stores behind the writable check.
+#ifdef SAVEBINARY_UNCHECKED_ACCESS
+using SaveBinary = BasicSaveBinary<UncheckedAccess>;
+#else
+using SaveBinary = BasicSaveBinary<CheckedAccess>;
+#endif
+
 #endif // SAVEBINARY_H
@@ -0,0 +1,18 @@
+#ifndef SAVE_CHECKSUM_H
+#define SAVE_CHECKSUM_H
+
+#include <cstddef>
+#include <cstdint>
+
+// read-only view of a contiguous range of bytes
+struct ConstByteSpan {
+	const uint8_t* data;
+	size_t size;
+};
+
+// 16-bit wraparound sum of every byte in the span. This is the checksum the game keeps for
+// sGameData and sBackupGameData. Uses AVX2 or SSE2 where the CPU supports it, and a plain
+// loop everywhere else (including the web build).
+uint16_t calculateByteSumChecksum(ConstByteSpan bytes);
+
+#endif
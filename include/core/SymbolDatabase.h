@@ -3,53 +3,226 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <mutex>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <vector>
 
 // This class is used to store the symbols that are used in the save patcher.
 // each symbol consists of bank, address, and name.
-// it is initiated from an embedded symbol blob.
+// The names of every save version are interned once in a shared name pool, and each version's
+// table holds a small record per name id. Both are embedded blobs written by
+// tools/build_symtab.py and used in place, without parsing or copying. A database can also be
+// initiated from a text .sym file, which is parsed into the same layout. Numbered symbols such
+// as sNewBox1, sNewBox2, ... are also grouped into families that resolve by number without
+// building names.
 
 class SymbolDatabase {
 public:
+	// one fixed-width record of a version's symbol table. A table holds a record for every name
+	// in the pool, indexed by name id, so the record doesn't store the name itself.
+	// The tables are little endian, like every platform the patcher targets.
+#pragma pack(push, 1)
 	struct Symbol {
-		uint8_t bank;
 		uint16_t address;
-		std::string name;
+		uint8_t bank;
+		// SYMBOL_DEFINED if the version has the symbol
+		uint8_t flags;
+	};
+
+	// a family of numbered symbols sharing a name pattern, e.g. "sNewBox#Name" for sNewBox1Name,
+	// sNewBox2Name, ... Families are sorted by pattern and list the name id of each member by number.
+	struct Family {
+		// offset of the pattern in the pool's strings
+		uint32_t nameOffset;
+		// offset of the member name ids in the pool
+		uint32_t membersOffset;
+		uint16_t count;
+		uint8_t first;
+		uint8_t nameLength;
+	};
+#pragma pack(pop)
+	static constexpr uint8_t SYMBOL_DEFINED = 0x01;
+
+	// memory region a symbol lives in
+	enum class Region : uint8_t {
+		ROM,
+		VRAM,
+		SRAM,
+		WRAM,
+		// echo RAM, OAM and I/O registers
+		OTHER,
+		HRAM
+	};
+
+	// the SRAM blocks WRAM data is saved to. Each block mirrors WRAM from a base symbol on
+	// (e.g. wPlayerData is saved at sPlayerData).
+	enum class SaveBlock : uint8_t {
+		OPTIONS,
+		PLAYER_DATA,
+		MAP_DATA,
+		POKEMON_DATA
+	};
+	static constexpr int NUM_SAVE_BLOCKS = 4;
+
+	// a symbol resolved to an absolute save address
+	struct Address {
+		// absolute save address (up to 2MiB), 0 if the symbol couldn't be resolved
+		uint32_t value;
+		// region the symbol itself lives in
+		Region region;
+		bool valid;
+		explicit operator bool() const { return valid; }
 	};
 
-	// Constructor
+	// an absolute save address located within a symbol
+	struct Location {
+		// the sram symbol the address lies in, or the wram symbol saved there for addresses
+		// within a save block. nullptr if the address is before every symbol
+		const Symbol* symbol;
+		// distance of the address from the start of the symbol
+		uint32_t offset;
+		explicit operator bool() const { return symbol != nullptr; }
+	};
+
+	// get the shared symbol database of a save version (7 to 10). Each version is built at most
+	// once, on first use, and is safe to use from several threads at once.
+	static const SymbolDatabase& forVersion(int version);
+	// build every version's symbol database up front (e.g. before starting worker threads)
+	static void warmup();
+
+	// Constructor from a text .sym blob
 	SymbolDatabase(const unsigned char* buffer, size_t length);
+	// Constructor from a name pool and a version table built against it, both used in place
+	SymbolDatabase(const unsigned char* pool, size_t poolLength, const unsigned char* table, size_t tableLength);
 	// Destructor
 	~SymbolDatabase();
-	// Get the symbol by name
-	const Symbol* getSymbol(const std::string& name) const;
+	// Get the symbol by name, reporting it if missing
+	const Symbol* getSymbol(std::string_view name) const;
+	// Get the symbol by name, nullptr if missing
+	const Symbol* findSymbol(std::string_view name) const;
+	// Get the name of a symbol
+	std::string_view getName(const Symbol& symbol) const;
+	// Get a family of numbered symbols by pattern (e.g. "wObject#Struct"), nullptr if missing
+	const Family* findFamily(std::string_view pattern) const;
+	// Get the pattern of a family
+	std::string_view getName(const Family& family) const;
+	// Get the member of a family by number, nullptr if the family has no such member
+	const Symbol* getMember(const Family& family, int number) const;
+	// Get the number of symbols the version defines
+	size_t size() const;
+	// Get the region a symbol lives in
+	static Region getRegion(const Symbol& symbol);
 	// Returns if symbol by name is within rom
-	bool isROM(const std::string& name) const;
+	bool isROM(std::string_view name) const;
 	// Returns if symbol by name is within vram
-	bool isVRAM(const std::string& name) const;
+	bool isVRAM(std::string_view name) const;
 	// Returns if symbol by name is within sram
-	bool isSRAM(const std::string& name) const;
+	bool isSRAM(std::string_view name) const;
 	// Returns if symbol by name is within wram
-	bool isWRAM(const std::string& name) const;
+	bool isWRAM(std::string_view name) const;
 	// Returns if symbol by name is within hram
-	bool isHRAM(const std::string& name) const;
+	bool isHRAM(std::string_view name) const;
+	// resolve an sram symbol to its absolute sram address with a single lookup
+	Address resolveSRAM(std::string_view name) const;
+	// resolve a wram symbol to its address in the sram block it is saved to with a single lookup
+	Address resolveWRAM(std::string_view wram_symbol_name, SaveBlock block) const;
+	// same as resolveSRAM without reporting failures
+	Address findSRAM(std::string_view name) const;
+	// same as resolveWRAM without reporting failures
+	Address findWRAM(std::string_view wram_symbol_name, SaveBlock block) const;
+	// resolve an already found sram symbol (may be nullptr) without reporting failures
+	Address findSRAM(const Symbol* symbol) const;
+	// resolve an already found wram symbol (may be nullptr) without reporting failures
+	Address findWRAM(const Symbol* symbol, SaveBlock block) const;
 	// Returns abosolute sram address (up to 2MiB) of symbol by name
-	uint32_t getSRAMAddress(const std::string& name) const;
+	uint32_t getSRAMAddress(std::string_view name) const;
+	// locate an absolute save address within the closest symbol at or before it, in O(log n)
+	Location locate(uint32_t address) const;
+	// describe an absolute save address as symbol+offset (e.g. "wPartyMons+0x2a"), or only in
+	// hex if it isn't within a symbol
+	std::string describe(uint32_t address) const;
 
 	// Todo: These may get moved to CommonPatchFunctions.h
 	// Returns the distance of the wram symbol from wOptions and adds it to the address of sOptions
-	uint32_t getOptionsAddress(const std::string& wram_symbol_name) const;
+	uint32_t getOptionsAddress(std::string_view wram_symbol_name) const;
 	// Returns the distance of the wram symbol from wPlayerData and adds it to the address of sPlayerData
-	uint32_t getPlayerDataAddress(const std::string& wram_symbol_name) const;
+	uint32_t getPlayerDataAddress(std::string_view wram_symbol_name) const;
 	// Returns the distance of the wram symbol from wMapData and adds it to the address of sMapData
-	uint32_t getMapDataAddress(const std::string& wram_symbol_name) const;
+	uint32_t getMapDataAddress(std::string_view wram_symbol_name) const;
 	// Returns the distance of the wram symbol from wPokemonData and adds it to the address of sPokemonData
-	uint32_t getPokemonDataAddress(const std::string& wram_symbol_name) const;
+	uint32_t getPokemonDataAddress(std::string_view wram_symbol_name) const;
 
 private:
-	std::unordered_map<std::string, Symbol> m_symbols;
-	void processSymbolString(const std::string& data);
+	// name pool and version table layouts, see tools/build_symtab.py
+	static constexpr uint32_t POOL_MAGIC = 0x4E595350; // "PSYN"
+	static constexpr uint16_t POOL_VERSION = 1;
+	static constexpr size_t POOL_HEADER_SIZE = 24;
+	static constexpr uint32_t TABLE_MAGIC = 0x4D595350; // "PSYM"
+	static constexpr uint16_t TABLE_VERSION = 3;
+	static constexpr size_t TABLE_HEADER_SIZE = 16;
+	static constexpr uint32_t NO_MEMBER = 0xFFFFFFFF;
+
+	// an entry of the name pool, indexed by name id
+#pragma pack(push, 1)
+	struct Name {
+		// offset of the name in the pool's strings
+		uint32_t offset;
+		uint8_t length;
+	};
+#pragma pack(pop)
+
+	// the name pool and the records, either embedded or built from text into the owned buffers
+	const unsigned char* m_pool;
+	const Symbol* m_records;
+	std::vector<unsigned char> m_ownedPool;
+	std::vector<Symbol> m_ownedRecords;
+	uint32_t m_nameCount;
+	uint32_t m_familyCount;
+	uint32_t m_familyOffset;
+	uint32_t m_stringsOffset;
+	// number of symbols the version defines
+	uint32_t m_count;
+	// base addresses of each save block, resolved once on construction
+	struct SaveBlockBase {
+		uint16_t wramAddress;
+		uint32_t sramAddress;
+		// size of the wram data saved to the block, 0 if its end symbol is missing
+		uint16_t size;
+		bool valid;
+	};
+	SaveBlockBase m_saveBlocks[NUM_SAVE_BLOCKS];
+	// the reverse index, sorted by address: every sram symbol, and every wram symbol saved to a
+	// save block at its address in the block. Only error reports use it, so it is built on the
+	// first locate() (once, even if several threads get there together).
+	struct IndexEntry {
+		uint32_t address;
+		uint32_t nameId;
+	};
+	mutable std::vector<IndexEntry> m_sramIndex;
+	mutable std::vector<IndexEntry> m_mirrorIndex;
+	mutable std::once_flag m_indexBuilt;
+
+	// get the sorted names
+	const Name* names() const;
+	// get the sorted families
+	const Family* families() const;
+	// get a string of the pool
+	std::string_view getString(uint32_t offset, uint8_t length) const;
+	// get the id of a name, NO_MEMBER if the pool doesn't have it
+	uint32_t findNameId(std::string_view name) const;
+	// get the record of a name id if the version defines it, nullptr otherwise
+	const Symbol* getDefined(uint32_t nameId) const;
+	// use the pool in place if it is valid
+	bool usePool(const unsigned char* pool, size_t length);
+	// use the table in place if it is valid and was built against the pool
+	bool useTable(const unsigned char* table, size_t length, const unsigned char* pool, size_t poolLength);
+	// parse a text .sym blob into m_ownedPool and m_ownedRecords
+	void processSymbolData(const unsigned char* data, size_t length);
+	// resolve the base addresses of the save blocks
+	void resolveSaveBlocks();
+	// build the reverse index from the records and the save blocks
+	void buildReverseIndex() const;
 };
 
 #endif // SYMBOLDATABASE_H
@@ -1,3 +1,5 @@
+extern const unsigned symbol_names_pool_len;
+extern const unsigned char symbol_names_pool_data[];
 extern const unsigned version7_sym_len;
 extern const unsigned char version7_sym_data[];
 extern const unsigned version8_sym_len;
@@ -0,0 +1,69 @@
+#ifndef SYMBOLSET_H
+#define SYMBOLSET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+#include "SymbolDatabase.h"
+
+// A list of the symbols a patch step needs, resolved and validated together up front.
+// Every name that can't be resolved is reported in a single error, after which the step
+// reads the resolved addresses as plain integers by the index they were added at.
+// Literal names known at build time should use the generated sym::vN constants instead.
+
+class SymbolSet {
+public:
+	// a symbol to resolve, either an sram symbol or a wram symbol saved to a save block.
+	// A family entry (e.g. "sNewBox#Name" from 1 to 20) resolves count members by number.
+	struct Entry {
+		std::string name;
+		bool wram;
+		SymbolDatabase::SaveBlock block;
+		// first number of a family entry, -1 for a single symbol
+		int first;
+		int count;
+		// index of the entry's first address
+		size_t index;
+		// an sram symbol
+		Entry(std::string name);
+		// a wram symbol saved to block
+		Entry(std::string name, SymbolDatabase::SaveBlock block);
+	};
+
+	// Constructor
+	explicit SymbolSet(const SymbolDatabase& sym);
+	// Constructor with the entries to resolve
+	SymbolSet(const SymbolDatabase& sym, std::initializer_list<Entry> entries);
+	// add an sram symbol, returns its index
+	size_t addSRAM(std::string name);
+	// add a wram symbol saved to block, returns its index
+	size_t addWRAM(std::string name, SymbolDatabase::SaveBlock block);
+	// add the members first to last of an sram family, returns the index of first
+	size_t addSRAMFamily(std::string pattern, int first, int last);
+	// add the members first to last of a wram family saved to block, returns the index of first
+	size_t addWRAMFamily(std::string pattern, int first, int last, SymbolDatabase::SaveBlock block);
+	// resolve every entry, reporting all the unresolved names at once. Returns false if any failed
+	bool resolve();
+	// Returns if every entry was resolved
+	bool isResolved() const;
+	// Get the resolved address at index
+	uint32_t operator[](size_t index) const { return m_addresses[index]; }
+	// Get the name of the symbol at index
+	std::string getName(size_t index) const;
+	// Get the number of addresses
+	size_t size() const { return m_size; }
+
+private:
+	const SymbolDatabase& m_sym;
+	std::vector<Entry> m_entries;
+	std::vector<uint32_t> m_addresses;
+	size_t m_size;
+	bool m_resolved;
+
+	// add an entry, returns the index of its first address
+	size_t add(Entry entry, int first, int count);
+};
+
+#endif // SYMBOLSET_H
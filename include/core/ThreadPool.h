@@ -0,0 +1,80 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <cstddef>
+#include <functional>
+#include <deque>
+#include <memory>
+#include <vector>
+
+// Worker threads for patch work that splits into independent shards (e.g. the sBoxMons banks).
+// The jobs only read the saves and write their own shard's results, the caller then applies the
+// results in shard order on its own thread, so the patched save and the log are the same as
+// when running serially. Without thread support (the web build unless built with WEB_THREADS=1)
+// every job runs on the calling thread.
+#if defined(CLI_VERSION) || defined(__EMSCRIPTEN_PTHREADS__)
+#define PATCHER_THREADS 1
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+// get the number of threads parallelFor spreads jobs over, 1 runs them on the calling thread
+unsigned getWorkerCount();
+
+// set the number of threads parallelFor spreads jobs over, 0 uses one per hardware thread.
+// Defaults to 1.
+void setWorkerCount(unsigned count);
+
+// run job(0) to job(count - 1) on the calling thread and the threads of a pool shared by every
+// call (started on first use), returning once every job is done. Jobs must not call parallelFor.
+void parallelFor(size_t count, const std::function<void(size_t)>& job);
+
+// A pool of worker threads for independent jobs of uneven length (e.g. one save each in batch
+// mode). Every worker has its own queue, taking its newest job first, and steals the oldest job
+// of another worker's queue when its own runs dry, so no worker idles while jobs are left.
+// Without thread support the jobs run on the calling thread as they are submitted.
+class ThreadPool {
+public:
+	// start threads workers, 0 for one per hardware thread
+	explicit ThreadPool(unsigned threads);
+	// finish the submitted jobs and stop the workers
+	~ThreadPool();
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	// queue job, the workers' queues take turns
+	void submit(std::function<void()> job);
+	// wait until every submitted job is done
+	void wait();
+	// get the number of worker threads
+	unsigned getThreadCount() const;
+
+#ifdef PATCHER_THREADS
+private:
+	// the jobs queued on one worker
+	struct Queue {
+		std::mutex mutex;
+		std::deque<std::function<void()>> jobs;
+	};
+
+	// take the newest job of the worker's queue, or else steal the oldest job of another queue
+	bool takeJob(size_t worker, std::function<void()>& job);
+	// run jobs until the pool stops
+	void work(size_t worker);
+
+	std::vector<std::unique_ptr<Queue>> m_queues;
+	std::vector<std::thread> m_threads;
+	// guards the counts below, workers sleep on m_wake until jobs are queued
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::condition_variable m_done;
+	// jobs waiting in the queues, and jobs not finished yet
+	size_t m_queued = 0;
+	size_t m_pending = 0;
+	// the queue the next job goes to
+	size_t m_next = 0;
+	bool m_stopping = false;
+#endif
+};
+
+#endif // THREADPOOL_H
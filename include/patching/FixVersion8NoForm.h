@@ -5,6 +5,7 @@
 #include "core/SymbolDatabase.h"
 #include "core/PatcherConstants.h"
 #include "core/CommonPatchFunctions.h"
+#include <tuple>
 
 namespace fixVersion8NoFormNamespace {
 	using namespace fixVersion8NoFormNamespace;
@@ -193,6 +194,7 @@ namespace fixVersion8NoFormNamespace {
 
 #pragma pack(pop)
 
+	// patchedsave must already hold a copy of oldsave
 	bool fixVersion8NoForm(SaveBinary& oldsave, SaveBinary& patchedsave);
 
 	savemon_struct_v8 patchSavemonV8(const savemon_struct_v8& savemon);
@@ -132,6 +132,7 @@ namespace fixVersion9MagikarpPlainFormNamespace {
 
 #pragma pack(pop)
 
+	// patchedsave must already hold a copy of oldsave
 	bool fixVersion9MagikarpPlainForm(SaveBinary& oldsave, SaveBinary& patchedsave);
 
 	savemon_struct_v9 patchSavemonV9(const savemon_struct_v9& savemon);
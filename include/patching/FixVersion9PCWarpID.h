@@ -41,6 +41,7 @@ namespace fixVersion9PCWarpIDNamespace {
 		{ 36,  5 }, // SNOWTOP_POKECENTER_1F
 	};
 
+	// patchedsave must already hold a copy of oldsave
 	bool fixVersion9PCWarpID(SaveBinary& oldsave, SaveBinary& patchedsave);
 }
 
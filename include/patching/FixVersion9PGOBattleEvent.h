@@ -13,6 +13,7 @@ namespace fixVersion9PGOBattleEventNamespace {
 	constexpr int EVENT_BEAT_CANDELA = 0x596;
 	constexpr int EVENT_BEAT_BLANCHE = 0x597;
 	constexpr int EVENT_BEAT_SPARK = 0x598;
+	// patchedsave must already hold a copy of oldsave
 	bool fixVersion9PGOBattleEvent(SaveBinary& oldsave, SaveBinary& patchedsave);
 
 }
@@ -9,6 +9,7 @@
 
 namespace fixVersion9RegisteredKeyItemsNamespace {
 	using namespace fixVersion9RegisteredKeyItemsNamespace;
+	// patchedsave must already hold a copy of oldsave
 	bool fixVersion9RegisteredKeyItems(SaveBinary& oldsave, SaveBinary& patchedsave);
 }
 #endif
\ No newline at end of file
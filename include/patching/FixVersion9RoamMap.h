@@ -6,6 +6,7 @@
 #include "core/SymbolDatabase.h"
 #include "core/PatcherConstants.h"
 #include "core/CommonPatchFunctions.h"
+#include <tuple>
 
 namespace fixVersion9RoamMapNamespace {
 	using namespace fixVersion9RoamMapNamespace;
@@ -19,6 +20,7 @@ namespace fixVersion9RoamMapNamespace {
 	constexpr uint8_t CAUGHT_GENDER_MASK = 0b10000000;
 	constexpr uint8_t CAUGHT_TIME_MASK = 0b01100000;
 	constexpr uint8_t CAUGHT_BALL_MASK = 0b00011111;
+	// patchedsave must already hold a copy of oldsave
 	bool fixVersion9RoamMap(SaveBinary& oldsave, SaveBinary& patchedsave);
 
 	struct roam_struct_v9 {
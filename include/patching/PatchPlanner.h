@@ -0,0 +1,60 @@
+#ifndef PATCHPLANNER_H
+#define PATCHPLANNER_H
+
+#include <cstdint>
+#include <vector>
+#include "core/SaveBinary.h"
+
+// The patch steps between save versions form a graph: every upgrade (e.g. version 7 to 8) and
+// every dev fix (which keeps the version) is an edge. A plan is the cheapest route of edges from
+// a source version to a target version applying a set of fixes. Plans are found once per
+// (source, target, fixes) and cached, so patching many saves of the same version only plans the
+// first one.
+
+// a patch step from sourceVersion to targetVersion
+struct PatchEdge {
+	uint16_t sourceVersion;
+	uint16_t targetVersion;
+	// relative cost of running the step, the planner picks the cheapest route
+	int cost;
+	// the dev fix (dev_type) the step applies, 0 for an upgrade
+	int fix;
+	// name of the step for the log
+	const char* name;
+	// patch source into dest, which must already hold a copy of source
+	bool (*patch)(SaveBinary& source, SaveBinary& dest);
+};
+
+// a route of patch edges
+struct PatchPlan {
+	uint16_t sourceVersion;
+	uint16_t targetVersion;
+	// the fixes to apply, bit n is dev_type n
+	uint32_t fixes;
+	// false if no route reaches the target
+	bool found;
+	int cost;
+	std::vector<const PatchEdge*> edges;
+};
+
+// get every registered patch edge
+const std::vector<PatchEdge>& getPatchEdges();
+
+// check if an upgrade starts at version
+bool isPatchableVersion(uint16_t version);
+
+// check if a dev fix is registered for dev_type
+bool isDevFix(int devType);
+
+// get the latest save version an upgrade leads to
+uint16_t getLatestSaveVersion();
+
+// get the cheapest plan from sourceVersion to targetVersion applying fixes (bit n is dev_type n).
+// Plans are cached, so the reference stays valid for the rest of the run.
+const PatchPlan& getPatchPlan(uint16_t sourceVersion, uint16_t targetVersion, uint32_t fixes);
+
+// run plan on oldSave into newSave (which starts as a copy of oldSave). The buffers swap roles
+// between steps, oldSave is used as scratch space and doesn't keep its contents.
+bool runPatchPlan(const PatchPlan& plan, SaveBinary& oldSave, SaveBinary& newSave);
+
+#endif
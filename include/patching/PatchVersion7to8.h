@@ -5,6 +5,7 @@
 #include "core/SymbolDatabase.h"
 #include "core/PatcherConstants.h"
 #include "core/CommonPatchFunctions.h"
+#include <tuple>
 
 namespace patchVersion7to8Namespace {
 	using namespace patchVersion7to8Namespace;
@@ -279,15 +280,6 @@ namespace patchVersion7to8Namespace {
 	// converts a version 7 Pokémon index to a version 8 Pokémon index
 	uint16_t mapV7PkmnToV8(uint16_t v7);
 
-	// struct for hashing tuples
-	struct TupleHash {
-		template <typename T>
-		std::size_t operator()(const T& tuple) const {
-			auto [first, second] = tuple;
-			return std::hash<unsigned char>()(first) ^ std::hash<unsigned char>()(second);
-		}
-	};
-
 	// converts a version 7 (uint8_t group, uint8_t map) tuple to a version 8 (uint8_t group, uint8_t map) tuple
 	std::tuple<uint8_t, uint8_t> mapv7toV8(uint8_t v7_group, uint8_t v7_map);
 
@@ -306,8 +298,9 @@ namespace patchVersion7to8Namespace {
 	// Writes the default box name for the given box number
 	void writeDefaultBoxName(SaveBinary::Iterator& it, int boxNum);
 
-	// Migrate the newbox box data from version 7 to version 8
-	void migrateBoxData(SourceDest& sd, const std::string& prefix);
+	// Migrate the newbox box data from version 7 to version 8, given the box symbol families
+	// (e.g. "sNewBox#", "sNewBox#Name" and "sNewBox#Theme")
+	void migrateBoxData(SourceDest& sd, const std::string& boxFamily, const std::string& nameFamily, const std::string& themeFamily);
 
 	// a helper function to convert item lists
 	void convertItemList(SourceDest& sd, uint32_t numItemsAddr7, uint32_t itemsAddr7, uint32_t numItemsAddr8, uint32_t itemsAddr8, const std::string& itemListName);
@@ -316,6 +309,7 @@ namespace patchVersion7to8Namespace {
 	void mapAndWriteMapGroupNumber(SourceDest& sd, uint32_t mapGroupAddr7, uint32_t mapGroupAddr8, uint32_t mapNumberAddr7, uint32_t mapNumberAddr8, const std::string& mapName);
 
 	// bool patchVersion7to8 takes in arguments SaveBinary save7 and SaveBinary save8
+	// save8 must already hold a copy of save7, only the converted data is written
 	bool patchVersion7to8(SaveBinary& save7, SaveBinary& save8);
 
 	savemon_struct_v8 convertSavemonV7toV8(const savemon_struct_v8& savemon, std::vector<uint16_t>& seen_mons, std::vector<uint16_t>& caught_mons);
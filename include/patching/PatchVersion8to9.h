@@ -2,6 +2,7 @@
 #define PATCHVERSION8TO9_H
 
 #include "core/SaveBinary.h"
+#include "core/CommonPatchFunctions.h"
 
 namespace patchVersion8to9Namespace {
 	using namespace patchVersion8to9Namespace;
@@ -48,7 +49,8 @@ namespace patchVersion8to9Namespace {
 	// converts a version 8 key item to a version 8 key item
 	uint8_t mapV8KeyItemToV9(uint8_t v8);
 
-	// bool patchVersion8to9 takes in arguments SaveBinary save7 and SaveBinary save8
+	// bool patchVersion8to9 takes in arguments SaveBinary save8 and SaveBinary save9
+	// save9 must already hold a copy of save8, only the converted data is written
 	bool patchVersion8to9(SaveBinary& save8, SaveBinary& save9);
 }
 
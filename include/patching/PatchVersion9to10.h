@@ -2,6 +2,7 @@
 #define PATCHVERSION9TO10_H
 
 #include "core/SaveBinary.h"
+#include "core/CommonPatchFunctions.h"
 
 namespace patchVersion9to10Namespace {
 	using namespace patchVersion9to10Namespace;
@@ -61,6 +62,8 @@ namespace patchVersion9to10Namespace {
 	// Converts a version 9 event flag to a version 10 event flag
 	uint16_t mapV9EventFlagToV10(uint16_t v9);
 
+	// bool patchVersion9to10 takes in arguments SaveBinary save9 and SaveBinary save10
+	// save10 must already hold a copy of save9, only the converted data is written
 	bool patchVersion9to10(SaveBinary& save9, SaveBinary& save10);
 
 	mailmsg_struct_v10 convertMailmsgV9toV10(const mailmsg_struct_v10& mailmsg);
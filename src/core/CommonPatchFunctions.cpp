@@ -1,16 +1,69 @@
 #include "core/CommonPatchFunctions.h"
+#include "core/ThreadPool.h"
+#include <algorithm>
 
 // calculate save checksum
-uint16_t calculateSaveChecksum(SaveBinary save, uint32_t start, uint32_t end) {
+uint16_t calculateSaveChecksum(const SaveBinary& save, uint32_t start, uint32_t end) {
 	if (start >= end) {
 		js_error << "Invalid start and end addresses for calculateSaveChecksum:  " << start << " " << end << std::endl;
 		return 0;
 	}
-	uint16_t checksum = 0;
-	for (uint32_t i = start; i < end; i++) {
-		checksum += save.getByte(i);
+	// check the range once, then sum the raw bytes directly
+	if (end > save.getSize()) {
+		js_error << "Address out of bounds: " << std::hex << end - 1 << std::endl;
+		return 0;
 	}
-	return checksum;
+	// use the running checksum if the range is being tracked
+	uint16_t checksum;
+	if (save.getTrackedChecksum(start, end, checksum)) {
+		return checksum;
+	}
+	return calculateByteSumChecksum({save.getData() + start, end - start});
+}
+
+// the game data ranges covered by the save checksums
+enum GameDataSymbols {
+	GAME_DATA,
+	GAME_DATA_END,
+	BACKUP_GAME_DATA,
+	BACKUP_GAME_DATA_END
+};
+
+// add the game data ranges to gameData and resolve them, returns false if any is missing
+static bool resolveGameData(SymbolSet& gameData) {
+	gameData.addSRAM("sGameData");
+	gameData.addSRAM("sGameDataEnd");
+	gameData.addSRAM("sBackupGameData");
+	gameData.addSRAM("sBackupGameDataEnd");
+	return gameData.resolve();
+}
+
+// keep the sGameData and sBackupGameData checksums of save up to date as it is written
+void trackGameDataChecksums(SaveBinary& save, const SymbolDatabase& sym) {
+	SymbolSet gameData(sym);
+	if (!resolveGameData(gameData)) {
+		return;
+	}
+	save.trackChecksum(gameData[GAME_DATA], gameData[GAME_DATA_END]);
+	save.trackChecksum(gameData[BACKUP_GAME_DATA], gameData[BACKUP_GAME_DATA_END]);
+}
+
+// keep the sGameData and sBackupGameData checksums of save up to date, starting from known checksums
+void trackGameDataChecksums(SaveBinary& save, const SymbolDatabase& sym, uint16_t checksum, uint16_t backupChecksum) {
+	SymbolSet gameData(sym);
+	if (!resolveGameData(gameData)) {
+		return;
+	}
+	save.trackChecksum(gameData[GAME_DATA], gameData[GAME_DATA_END], checksum);
+	save.trackChecksum(gameData[BACKUP_GAME_DATA], gameData[BACKUP_GAME_DATA_END], backupChecksum);
+}
+
+// make the last destination the source of the next patch step
+void swapChainBuffers(SaveBinary*& source, SaveBinary*& dest) {
+	std::swap(source, dest);
+	dest->copyDirtyBlocksFrom(*source);
+	source->clearDirtyBlocks();
+	dest->clearDirtyBlocks();
 }
 
 // copy length bytes from source to dest
@@ -38,10 +91,7 @@ void clearDataBlock(SourceDest &sd, uint32_t dest, int length) {
 		return;
 	}
 	sd.destSave.seek(dest);
-	for (int i = 0; i < length; i++) {
-		sd.destSave.setByte(0);
-		sd.destSave.next();
-	}
+	sd.destSave.fill(0, length);
 }
 
 // fill length bytes starting at dest with value
@@ -51,10 +101,7 @@ void fillDataBlock(SourceDest &sd, uint32_t dest, int length, uint8_t value) {
 		return;
 	}
 	sd.destSave.seek(dest);
-	for (int i = 0; i < length; i++) {
-		sd.destSave.setByte(value);
-		sd.destSave.next();
-	}
+	sd.destSave.fill(value, length);
 }
 
 // assert that the iterator is at the specified address
@@ -114,6 +161,144 @@ bool isFlagBitSet(SaveBinary::Iterator &it, uint32_t baseAddress, int bitIndex)
 	return (it.getByte(byteAddress) & mask) != 0;
 }
 
+// index of the lowest set bit of a non-zero word
+static uint32_t lowestSetBit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctzll(word);
+#else
+	uint32_t bit = 0;
+	while ((word & 1) == 0) {
+		word >>= 1;
+		bit++;
+	}
+	return bit;
+#endif
+}
+
+// view the flag_array(count) bytes starting at address, with every flag cleared
+FlagArrayView::FlagArrayView(uint32_t address, uint32_t count)
+	: m_address(address), m_count(count), m_valid(true), m_words((count + 63) / 64, 0) {}
+
+// view the flag_array(count) bytes starting at address, loaded from save
+FlagArrayView::FlagArrayView(const SaveBinary& save, uint32_t address, uint32_t count) : FlagArrayView(address, count) {
+	std::vector<uint8_t> bytes((count + 7) / 8);
+	m_valid = save.loadBytes(address, bytes.data(), bytes.size());
+	if (!m_valid) {
+		return;
+	}
+	for (size_t i = 0; i < bytes.size(); i++) {
+		m_words[i / 8] |= uint64_t(bytes[i]) << (8 * (i % 8));
+	}
+	// the bits past count aren't flags
+	if (count % 64 != 0) {
+		m_words.back() &= (uint64_t(1) << (count % 64)) - 1;
+	}
+}
+
+// check that the flag is within the array, reporting it otherwise
+bool FlagArrayView::checkFlag(uint32_t flag) const {
+	if (flag >= m_count) {
+		js_error << "Flag " << std::dec << flag << " is out of range of the " << m_count << " flag array at " << std::hex << m_address << std::endl;
+		return false;
+	}
+	return true;
+}
+
+// check if the flag is set
+bool FlagArrayView::test(uint32_t flag) const {
+	return checkFlag(flag) && (m_words[flag / 64] >> (flag % 64)) & 1;
+}
+
+// set the flag, returns false if it was already set (or is out of range)
+bool FlagArrayView::set(uint32_t flag) {
+	if (!checkFlag(flag)) {
+		return false;
+	}
+	uint64_t bit = uint64_t(1) << (flag % 64);
+	bool wasSet = m_words[flag / 64] & bit;
+	m_words[flag / 64] |= bit;
+	return !wasSet;
+}
+
+// clear the flag
+void FlagArrayView::reset(uint32_t flag) {
+	if (checkFlag(flag)) {
+		m_words[flag / 64] &= ~(uint64_t(1) << (flag % 64));
+	}
+}
+
+// get the set flags, lowest first
+std::vector<uint32_t> FlagArrayView::getSetFlags() const {
+	std::vector<uint32_t> flags;
+	for (size_t i = 0; i < m_words.size(); i++) {
+		for (uint64_t word = m_words[i]; word != 0; word &= word - 1) {
+			flags.push_back(i * 64 + lowestSetBit(word));
+		}
+	}
+	return flags;
+}
+
+// write the flags back to the save data, keeping the bits past count in the last byte
+bool FlagArrayView::store(SaveBinary& save) const {
+	std::vector<uint8_t> bytes((m_count + 7) / 8);
+	for (size_t i = 0; i < bytes.size(); i++) {
+		bytes[i] = uint8_t(m_words[i / 8] >> (8 * (i % 8)));
+	}
+	if (m_count % 8 != 0 && !bytes.empty()) {
+		uint32_t lastAddress = m_address + bytes.size() - 1;
+		if (lastAddress < save.getSize()) {
+			bytes.back() |= save.getData()[lastAddress] & uint8_t(0xFF << (m_count % 8));
+		}
+	}
+	return save.storeBytes(m_address, bytes.data(), bytes.size());
+}
+
+// build the table converting sourceCount flags to destCount flags
+FlagRemap::FlagRemap(uint32_t sourceCount, uint32_t destCount, const std::function<uint32_t(uint32_t)>& convert)
+	: m_sourceCount(sourceCount), m_destCount(destCount), m_table(sourceCount), m_copyWord((sourceCount + 63) / 64, true) {
+	for (uint32_t flag = 0; flag < sourceCount; flag++) {
+		uint32_t converted = convert(flag);
+		if (converted != DROPPED && converted >= destCount) {
+			js_error << "Flag " << std::dec << flag << " converts to " << converted << ", out of range of the " << destCount << " flag array" << std::endl;
+			converted = DROPPED;
+		}
+		m_table[flag] = converted;
+		if (converted != flag) {
+			m_copyWord[flag / 64] = false;
+		}
+	}
+}
+
+// set the converted flags of source in dest
+bool FlagRemap::apply(const FlagArrayView& source, FlagArrayView& dest, const Report& report) const {
+	if (source.getCount() != m_sourceCount || dest.getCount() != m_destCount) {
+		js_error << "Flag remap of " << std::dec << m_sourceCount << " to " << m_destCount << " flags applied to "
+			<< source.getCount() << " to " << dest.getCount() << " flags" << std::endl;
+		return false;
+	}
+	const std::vector<uint64_t>& sourceWords = source.getWords();
+	std::vector<uint64_t>& destWords = dest.getWords();
+	for (size_t i = 0; i < sourceWords.size(); i++) {
+		uint64_t word = sourceWords[i];
+		if (m_copyWord[i]) {
+			destWords[i] |= word;
+			continue;
+		}
+		// visit the set flags only, lowest first
+		for (; word != 0; word &= word - 1) {
+			uint32_t flag = i * 64 + lowestSetBit(word);
+			uint32_t converted = m_table[flag];
+			if (converted != DROPPED) {
+				destWords[converted / 64] |= uint64_t(1) << (converted % 64);
+			}
+			if (report && converted != flag) {
+				report(flag, converted);
+			}
+		}
+	}
+	return true;
+}
+
 // Calculate the newbox checksum for the given mon
 // Reference: https://github.com/Rangi42/polishedcrystal/blob/9bit/docs/newbox_format.md#checksum
 uint16_t calculateNewboxChecksum(const SaveBinary& save, uint32_t startAddress) {
@@ -161,3 +346,102 @@ void writeNewboxChecksum(SaveBinary& save, uint32_t startAddress) {
 		save.setByte(startAddress + 0x20 + i, byte);
 	}
 }
+
+// Calculate the newbox checksum of the NEWBOX_MON_SIZE bytes of a mon
+uint16_t calculateNewboxChecksum(const uint8_t* mon) {
+	uint16_t checksum = 127;
+	for (int i = 0; i <= 0x1F; ++i) {
+		checksum += mon[i] * (i + 1);
+	}
+	for (int i = 0x20; i <= 0x30; ++i) {
+		checksum += (mon[i] & 0x7F) * (i + 2);
+	}
+	return checksum;
+}
+
+// Extract the stored newbox checksum from the NEWBOX_MON_SIZE bytes of a mon
+uint16_t extractStoredNewboxChecksum(const uint8_t* mon) {
+	uint16_t storedChecksum = 0;
+	for (int i = 0; i <= 0xF; ++i) {
+		storedChecksum |= ((mon[0x20 + i] & 0x80) >> 7) << (0xF - i);
+	}
+	return storedChecksum;
+}
+
+// Write the newbox checksum into the NEWBOX_MON_SIZE bytes of a mon
+void writeNewboxChecksum(uint8_t* mon) {
+	uint16_t checksum = calculateNewboxChecksum(mon);
+	for (int i = 0; i <= 0xF; ++i) {
+		mon[0x20 + i] = (mon[0x20 + i] & 0x7F) | (((checksum >> (0xF - i)) & 0x1) << 7);
+	}
+}
+
+// the mons of a bank patched by one job
+struct NewboxShard {
+	size_t bank;
+	uint32_t first;
+	uint32_t count;
+	// index of the shard's first mon counting through all the banks
+	size_t index;
+	std::vector<uint8_t> mons;
+	// whether the stored checksum of each mon matched, so the mon was patched
+	std::vector<bool> matched;
+	// the messages logged while patching the shard
+	std::vector<LogMessage> log;
+};
+
+// the number of mons a job patches
+static constexpr uint32_t NEWBOX_SHARD_MONS = 32;
+
+// patch every mon of the banks whose stored checksum matches and write its new checksum
+bool patchNewboxBanks(SaveBinary& save, const std::vector<NewboxBank>& banks, const std::function<void(uint8_t*, size_t)>& patch) {
+	// split the banks into shards, checking the ranges up front so the jobs can't fail
+	std::vector<NewboxShard> shards;
+	size_t index = 0;
+	for (size_t i = 0; i < banks.size(); i++) {
+		const NewboxBank& bank = banks[i];
+		if (!save.validateRange(bank.address, bank.address + bank.count * NEWBOX_MON_SIZE)) {
+			js_error << "Newbox bank " << bank.name << " is out of bounds." << std::endl;
+			return false;
+		}
+		for (uint32_t first = 0; first < bank.count; first += NEWBOX_SHARD_MONS) {
+			shards.push_back({i, first, std::min(NEWBOX_SHARD_MONS, bank.count - first), index + first, {}, {}, {}});
+		}
+		index += bank.count;
+	}
+
+	// read, check and patch the shards into their own buffers and logs, nothing is written to the
+	// save until every job is done
+	parallelFor(shards.size(), [&save, &banks, &shards, &patch](size_t i) {
+		NewboxShard& shard = shards[i];
+		LogCapture capture(shard.log);
+		shard.mons.resize(shard.count * NEWBOX_MON_SIZE);
+		save.loadBytes(banks[shard.bank].address + shard.first * NEWBOX_MON_SIZE, shard.mons.data(), shard.count * NEWBOX_MON_SIZE);
+		shard.matched.resize(shard.count);
+		for (uint32_t j = 0; j < shard.count; j++) {
+			uint8_t* mon = shard.mons.data() + j * NEWBOX_MON_SIZE;
+			shard.matched[j] = calculateNewboxChecksum(mon) == extractStoredNewboxChecksum(mon);
+			if (shard.matched[j]) {
+				patch(mon, shard.index + j);
+				writeNewboxChecksum(mon);
+			}
+		}
+	});
+
+	// write the patched mons and their logs in order
+	bool success = true;
+	size_t i = 0;
+	for (size_t b = 0; b < banks.size(); b++) {
+		js_info << "Checking " << banks[b].name << " checksums..." << std::endl;
+		for (; i < shards.size() && shards[i].bank == b; i++) {
+			NewboxShard& shard = shards[i];
+			replayLog(shard.log);
+			for (uint32_t j = 0; j < shard.count; j++) {
+				if (shard.matched[j]) {
+					success = save.storeBytes(banks[b].address + (shard.first + j) * NEWBOX_MON_SIZE, shard.mons.data() + j * NEWBOX_MON_SIZE, NEWBOX_MON_SIZE) && success;
+				}
+			}
+		}
+	}
+	return success;
+}
@@ -58,8 +58,43 @@ void JSStreambuf::flushBuffer() {
 	}
 }
 
+// where the messages of the thread go instead of the console, if anywhere
+static thread_local std::ostream* t_logSink = nullptr;
+
+// send the messages logged on the calling thread to sink while alive
+LogRedirect::LogRedirect(std::ostream& sink) : m_previous(t_logSink) {
+	t_logSink = &sink;
+}
+
+LogRedirect::~LogRedirect() {
+	t_logSink = m_previous;
+}
+
+// where the messages of the thread are kept instead of being logged, if anywhere
+static thread_local std::vector<LogMessage>* t_logCapture = nullptr;
+
+// keep the messages logged on the calling thread in messages while alive
+LogCapture::LogCapture(std::vector<LogMessage>& messages) : m_previous(t_logCapture) {
+	t_logCapture = &messages;
+}
+
+LogCapture::~LogCapture() {
+	t_logCapture = m_previous;
+}
+
 // Logs the message to the appropriate JavaScript function based on the log level
 void JSStreambuf::logToJs(const std::string& message) {
+	if (t_logCapture != nullptr) {
+		// the streams are per thread, so look them up on every call
+		std::ostream* const streams[] = {&js_info, &js_warning, &js_error};
+		t_logCapture->push_back({level, message, streams[static_cast<int>(level)]->flags()});
+		return;
+	}
+	if (t_logSink != nullptr) {
+		static const char* const levels[] = {"info", "warning", "error"};
+		*t_logSink << levels[static_cast<int>(level)] << ": " << message;
+		return;
+	}
 	switch (level) {
 		case LogLevel::INFO:
 			js_log_message(message.c_str(), "info");
@@ -73,12 +108,32 @@ void JSStreambuf::logToJs(const std::string& message) {
 	}
 }
 
-// Create JSStreambuf objects for different log levels
-JSStreambuf js_info_buf(LogLevel::INFO);
-JSStreambuf js_warning_buf(LogLevel::WARNING);
-JSStreambuf js_error_buf(LogLevel::ERROR);
+// Create JSStreambuf objects for different log levels, one set per thread
+thread_local JSStreambuf js_info_buf(LogLevel::INFO);
+thread_local JSStreambuf js_warning_buf(LogLevel::WARNING);
+thread_local JSStreambuf js_error_buf(LogLevel::ERROR);
 
 // Create std::ostream objects that use the JSStreambuf objects for logging
-std::ostream js_info(&js_info_buf);
-std::ostream js_warning(&js_warning_buf);
-std::ostream js_error(&js_error_buf);
+thread_local std::ostream js_info(&js_info_buf);
+thread_local std::ostream js_warning(&js_warning_buf);
+thread_local std::ostream js_error(&js_error_buf);
+
+// log messages kept by a LogCapture on the calling thread
+void replayLog(const std::vector<LogMessage>& messages) {
+	for (const LogMessage& message : messages) {
+		switch (message.level) {
+			case LogLevel::INFO:
+				js_info.flags(message.flags);
+				js_info << message.text;
+				break;
+			case LogLevel::WARNING:
+				js_warning.flags(message.flags);
+				js_warning << message.text;
+				break;
+			case LogLevel::ERROR:
+				js_error.flags(message.flags);
+				js_error << message.text;
+				break;
+		}
+	}
+}
@@ -0,0 +1,190 @@
+#include "core/RegionPlan.h"
+#include <algorithm>
+
+// copy length bytes from source in the source save to dest
+void RegionPlan::copy(uint32_t source, uint32_t dest, uint32_t length, std::string description) {
+	m_operations.push_back({dest, length, source, 0, true, false, std::move(description), nullptr});
+	m_compiled = false;
+}
+
+// clear (0x00) length bytes starting at dest
+void RegionPlan::clear(uint32_t dest, uint32_t length, std::string description) {
+	fill(dest, length, 0x00, std::move(description));
+}
+
+// fill length bytes starting at dest with value
+void RegionPlan::fill(uint32_t dest, uint32_t length, uint8_t value, std::string description) {
+	m_operations.push_back({dest, length, 0, value, false, false, std::move(description), nullptr});
+	m_compiled = false;
+}
+
+// add a conversion writing [dest, dest + length)
+void RegionPlan::addConversion(uint32_t dest, uint32_t length, std::string description, std::function<bool(const SaveBinary&, SaveBinary&)> convert) {
+	m_operations.push_back({dest, length, 0, 0, false, true, std::move(description), std::move(convert)});
+	m_compiled = false;
+}
+
+// convert the bytes [source, source + length), writing the ones that change to dest
+void RegionPlan::remapBytes(uint32_t source, uint32_t dest, uint32_t length, int terminator, const std::function<int(uint8_t)>& convert, std::string description, ByteReport report) {
+	// look every byte up once
+	std::vector<int> table(0x100);
+	for (int i = 0; i < 0x100; i++) {
+		table[i] = convert(static_cast<uint8_t>(i));
+	}
+	addConversion(dest, length, std::move(description), [source, dest, length, terminator, table, report](const SaveBinary& sourceSave, SaveBinary& destSave) {
+		std::vector<uint8_t> bytes(length);
+		std::vector<uint8_t> converted(length);
+		if (!sourceSave.loadBytes(source, bytes.data(), length) || !destSave.loadBytes(dest, converted.data(), length)) {
+			return false;
+		}
+		for (uint32_t i = 0; i < length; i++) {
+			if (terminator >= 0 && bytes[i] == terminator) {
+				break;
+			}
+			int value = table[bytes[i]];
+			if (value != bytes[i]) {
+				if (value != UNMAPPED) {
+					converted[i] = static_cast<uint8_t>(value);
+				}
+				if (report) {
+					report(bytes[i], value);
+				}
+			}
+		}
+		return destSave.storeBytes(dest, converted.data(), length);
+	});
+}
+
+// convert the flag_array at source with remap into the flag_array at dest
+void RegionPlan::remapFlags(const FlagRemap& remap, uint32_t source, uint32_t sourceCount, uint32_t dest, uint32_t destCount, std::string description, FlagRemap::Report report) {
+	addConversion(dest, flag_array(destCount), std::move(description), [remap, source, sourceCount, dest, destCount, report](const SaveBinary& sourceSave, SaveBinary& destSave) {
+		FlagArrayView sourceFlags(sourceSave, source, sourceCount);
+		FlagArrayView destFlags(dest, destCount);
+		bool success = remap.apply(sourceFlags, destFlags, report);
+		return destFlags.store(destSave) && success;
+	});
+}
+
+// clear flags in the flag_array at dest
+void RegionPlan::resetFlags(uint32_t dest, uint32_t count, std::vector<uint32_t> flags, std::string description, std::function<void(uint32_t)> report) {
+	addConversion(dest, flag_array(count), std::move(description), [dest, count, flags, report](const SaveBinary&, SaveBinary& destSave) {
+		FlagArrayView destFlags(destSave, dest, count);
+		for (uint32_t flag : flags) {
+			if (report) {
+				report(flag);
+			}
+			destFlags.reset(flag);
+		}
+		return destFlags.isValid() && destFlags.store(destSave);
+	});
+}
+
+// resolve and merge the copies, clears and fills into runs
+bool RegionPlan::compile() {
+	m_runs.clear();
+	m_compiled = false;
+
+	// a conversion runs after every copy, clear and fill, so none may write its destination later
+	bool valid = true;
+	for (size_t i = 0; i < m_operations.size(); i++) {
+		const Operation& conversion = m_operations[i];
+		if (!conversion.isConversion) {
+			continue;
+		}
+		for (size_t j = i + 1; j < m_operations.size(); j++) {
+			const Operation& later = m_operations[j];
+			if (!later.isConversion && later.dest < conversion.dest + conversion.length && conversion.dest < later.dest + later.length) {
+				js_error << "Region plan: \"" << later.description << "\" overwrites the destination of \"" << conversion.description << "\"" << std::endl;
+				valid = false;
+			}
+		}
+	}
+	if (!valid) {
+		return false;
+	}
+
+	// split the destination at every region boundary, each piece is written last by a single operation
+	std::vector<uint32_t> boundaries;
+	for (const Operation& operation : m_operations) {
+		if (!operation.isConversion && operation.length > 0) {
+			boundaries.push_back(operation.dest);
+			boundaries.push_back(operation.dest + operation.length);
+		}
+	}
+	std::sort(boundaries.begin(), boundaries.end());
+	boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+
+	for (size_t i = 0; i + 1 < boundaries.size(); i++) {
+		uint32_t start = boundaries[i];
+		uint32_t end = boundaries[i + 1];
+		// find the last operation writing the piece
+		const Operation* last = nullptr;
+		for (auto it = m_operations.rbegin(); it != m_operations.rend(); ++it) {
+			if (!it->isConversion && it->dest <= start && end <= it->dest + it->length) {
+				last = &*it;
+				break;
+			}
+		}
+		if (last == nullptr) {
+			continue;
+		}
+		Run piece = {start, end - start, last->source + (start - last->dest), last->value, last->isCopy};
+		// extend the previous run if the piece continues it
+		if (!m_runs.empty()) {
+			Run& run = m_runs.back();
+			if (run.dest + run.length == piece.dest && run.isCopy == piece.isCopy &&
+					(run.isCopy ? run.source + run.length == piece.source : run.value == piece.value)) {
+				run.length += piece.length;
+				continue;
+			}
+		}
+		m_runs.push_back(piece);
+	}
+
+	m_compiled = true;
+	return true;
+}
+
+// run the plan from source into dest
+bool RegionPlan::execute(const SaveBinary& source, SaveBinary& dest) const {
+	if (!m_compiled) {
+		js_error << "Region plan executed before it was compiled" << std::endl;
+		return false;
+	}
+
+	// write the runs, keeping the ones that failed to report the operations they came from
+	std::vector<const Run*> failedRuns;
+	for (const Run& run : m_runs) {
+		bool written = run.isCopy ? dest.copyBytes(run.dest, source, run.source, run.length) : dest.fillBytes(run.dest, run.value, run.length);
+		if (!written) {
+			failedRuns.push_back(&run);
+		}
+	}
+
+	// log the operations in the order they were added, once their bytes are written. The
+	// conversions run after every run, in order, so their logs follow the operations before them.
+	bool success = failedRuns.empty();
+	for (const Operation& operation : m_operations) {
+		bool logged = !operation.description.empty();
+		if (operation.isConversion) {
+			if (logged) {
+				js_info << operation.description << std::endl;
+			}
+			if (!operation.convert(source, dest)) {
+				js_error << "Failed: " << (logged ? operation.description : "region conversion") << std::endl;
+				success = false;
+			}
+			continue;
+		}
+		bool failed = std::any_of(failedRuns.begin(), failedRuns.end(), [&operation](const Run* run) {
+			return run->dest < operation.dest + operation.length && operation.dest < run->dest + run->length;
+		});
+		if (failed) {
+			js_error << "Failed: " << (logged ? operation.description : "region write") << std::endl;
+		}
+		else if (logged) {
+			js_info << operation.description << std::endl;
+		}
+	}
+	return success;
+}
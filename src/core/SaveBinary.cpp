@@ -1,12 +1,168 @@
 // Include necessary headers
 #include <iostream>
 #include <fstream>
-#include "core/PatcherConstants.h"
+#include <utility>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
 #include "core/SaveBinary.h"
+#include "core/SaveChecksum.h"
+#include "core/SymbolDatabase.h"
+#ifdef SAVEBINARY_USE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "core/PatcherConstants.h"
 #include "core/Logging.h"
 
+namespace saveBinaryDetail {
+	// report an access outside of the save data
+	void reportOutOfBounds(uint32_t address, const SymbolDatabase* symbols) {
+		js_error <<  "Address out of bounds: " << std::hex << address;
+		if (symbols != nullptr) {
+			js_error << " (" << symbols->describe(address) << ")";
+		}
+		js_error << std::endl;
+	}
+
+	// report a range of length bytes from address reaching outside of the save data
+	void reportOutOfBounds(uint32_t address, uint32_t length, const SymbolDatabase* symbols) {
+		js_error <<  "Address out of bounds: " << std::hex << address + length - 1;
+		if (symbols != nullptr) {
+			js_error << " (" << std::dec << length << " bytes from " << symbols->describe(address) << ")";
+		}
+		js_error << std::endl;
+	}
+
+	// report a write to a locked save
+	void reportLocked() {
+		js_error <<  "Save file is locked" << std::endl;
+	}
+
+	// report a write to a read-only mapping
+	void reportReadOnly() {
+		js_error <<  "Save file is mapped read-only" << std::endl;
+	}
+}
+
 // Constructor
-SaveBinary::SaveBinary(const std::string& saveFilePath) : m_locked(false) {
+template <typename AccessPolicy>
+BasicSaveBinary<AccessPolicy>::BasicSaveBinary(const std::string& saveFilePath) : m_bytes(nullptr), m_size(0), m_locked(false), m_mapping(nullptr), m_mappingSize(0), m_mapMode(MapMode::PRIVATE), m_symbols(nullptr) {
+	readFile(saveFilePath);
+}
+
+// Constructor mapping the save file with the requested mode
+template <typename AccessPolicy>
+BasicSaveBinary<AccessPolicy>::BasicSaveBinary(const std::string& saveFilePath, MapMode mode) : m_bytes(nullptr), m_size(0), m_locked(false), m_mapping(nullptr), m_mappingSize(0), m_mapMode(mode), m_symbols(nullptr) {
+	if (mapFile(saveFilePath, mode)) {
+		return;
+	}
+	readFile(saveFilePath);
+}
+
+// Constructor from an in-memory buffer
+template <typename AccessPolicy>
+BasicSaveBinary<AccessPolicy>::BasicSaveBinary(const uint8_t* data, size_t length) : m_bytes(nullptr), m_size(0), m_locked(false), m_mapping(nullptr), m_mappingSize(0), m_mapMode(MapMode::PRIVATE), m_symbols(nullptr) {
+	if (data == nullptr) {
+		js_error <<  "Save buffer is null" << std::endl;
+		return;
+	}
+	m_data.assign(data, data + length);
+	validateSize("<memory>");
+	useOwnedData();
+}
+
+// Constructor taking ownership of an existing buffer
+template <typename AccessPolicy>
+BasicSaveBinary<AccessPolicy>::BasicSaveBinary(std::vector<uint8_t>&& data) : m_data(std::move(data)), m_bytes(nullptr), m_size(0), m_locked(false), m_mapping(nullptr), m_mappingSize(0), m_mapMode(MapMode::PRIVATE), m_symbols(nullptr) {
+	validateSize("<memory>");
+	useOwnedData();
+}
+
+// Copy constructor
+template <typename AccessPolicy>
+BasicSaveBinary<AccessPolicy>::BasicSaveBinary(const BasicSaveBinary& other) : m_data(other.m_bytes, other.m_bytes + other.m_size), m_bytes(nullptr), m_size(0), m_locked(other.m_locked), m_mapping(nullptr), m_mappingSize(0), m_mapMode(MapMode::PRIVATE), m_symbols(other.m_symbols) {
+	useOwnedData();
+	m_trackedChecksums = other.m_trackedChecksums;
+}
+
+// Move constructor
+template <typename AccessPolicy>
+BasicSaveBinary<AccessPolicy>::BasicSaveBinary(BasicSaveBinary&& other) noexcept : m_data(std::move(other.m_data)), m_bytes(other.m_bytes), m_size(other.m_size), m_locked(other.m_locked), m_mapping(other.m_mapping), m_mappingSize(other.m_mappingSize), m_mapMode(other.m_mapMode), m_symbols(other.m_symbols) {
+	if (m_mapping == nullptr) {
+		useOwnedData();
+	}
+	m_dirtyBlocks = std::move(other.m_dirtyBlocks);
+	m_trackedChecksums = std::move(other.m_trackedChecksums);
+	other.m_data.clear();
+	other.m_bytes = nullptr;
+	other.m_size = 0;
+	other.m_mapping = nullptr;
+	other.m_mappingSize = 0;
+	other.m_trackedChecksums.clear();
+}
+
+// Copy assignment
+template <typename AccessPolicy>
+BasicSaveBinary<AccessPolicy>& BasicSaveBinary<AccessPolicy>::operator=(const BasicSaveBinary& other) {
+	if (this == &other) {
+		return *this;
+	}
+	if (m_mapping != nullptr && m_mapMode != MapMode::READ_ONLY && m_size == other.m_size) {
+		// write into the mapping, only the pages that weren't copied yet get copied
+		if (m_size != 0) {
+			std::memcpy(m_bytes, other.m_bytes, m_size);
+		}
+	} else {
+		std::vector<uint8_t> data(other.m_bytes, other.m_bytes + other.m_size);
+		unmap();
+		m_data = std::move(data);
+		useOwnedData();
+	}
+	// every byte has been replaced
+	std::fill(m_dirtyBlocks.begin(), m_dirtyBlocks.end(), ~uint64_t(0));
+	recalculateTrackedChecksums();
+	m_locked = other.m_locked;
+	m_symbols = other.m_symbols;
+	return *this;
+}
+
+// Move assignment
+template <typename AccessPolicy>
+BasicSaveBinary<AccessPolicy>& BasicSaveBinary<AccessPolicy>::operator=(BasicSaveBinary&& other) noexcept {
+	if (this == &other) {
+		return *this;
+	}
+	unmap();
+	m_data = std::move(other.m_data);
+	m_locked = other.m_locked;
+	m_mapping = other.m_mapping;
+	m_mappingSize = other.m_mappingSize;
+	m_mapMode = other.m_mapMode;
+	m_symbols = other.m_symbols;
+	if (m_mapping != nullptr) {
+		m_bytes = other.m_bytes;
+		m_size = other.m_size;
+	} else {
+		useOwnedData();
+	}
+	m_dirtyBlocks = std::move(other.m_dirtyBlocks);
+	m_trackedChecksums = std::move(other.m_trackedChecksums);
+	other.m_data.clear();
+	other.m_bytes = nullptr;
+	other.m_size = 0;
+	other.m_mapping = nullptr;
+	other.m_mappingSize = 0;
+	other.m_trackedChecksums.clear();
+	return *this;
+}
+
+// read the whole save file into m_data
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::readFile(const std::string& saveFilePath) {
 	// Open the file
 	std::ifstream file(saveFilePath, std::ios::binary);
 	if (!file.is_open()) {
@@ -28,284 +184,422 @@ SaveBinary::SaveBinary(const std::string& saveFilePath) : m_locked(false) {
 	file.seekg(0, std::ios::beg);
 	file.read(reinterpret_cast<char*>(m_data.data()), m_data.size());
 	file.close();
+	useOwnedData();
 }
 
-// Destructor
-SaveBinary::~SaveBinary() {
-}
-
-// Get the byte at the specified address
-uint8_t SaveBinary::getByte(uint32_t address) const {
-	if (address >= m_data.size()) {
-		js_error <<  "Address out of bounds: " << std::hex << address << std::endl;
-		return 0;
+// map the save file, returns false if it could not be mapped
+template <typename AccessPolicy>
+bool BasicSaveBinary<AccessPolicy>::mapFile(const std::string& saveFilePath, MapMode mode) {
+#ifdef SAVEBINARY_USE_MMAP
+	// both modes only read the file, a private mapping keeps its writes in memory
+	int fd = ::open(saveFilePath.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+	struct stat st;
+	if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+		::close(fd);
+		return false;
+	}
+	size_t fileSize = static_cast<size_t>(st.st_size);
+	if (fileSize < MIN_SAVE_SIZE) {
+		js_error <<  "Save file size is too small: " << saveFilePath << ". Expected minimum size: " << MIN_SAVE_SIZE << ", Actual size: " << fileSize << std::endl;
+		::close(fd);
+		// the size error has been reported, don't retry with a regular read
+		return true;
+	}
+	int prot = (mode == MapMode::READ_ONLY) ? PROT_READ : (PROT_READ | PROT_WRITE);
+	void* mapping = ::mmap(nullptr, fileSize, prot, MAP_PRIVATE, fd, 0);
+	// the mapping keeps its own reference to the file
+	::close(fd);
+	if (mapping == MAP_FAILED) {
+		return false;
+	}
+	m_data.clear();
+	m_mapping = mapping;
+	m_mappingSize = fileSize;
+	m_mapMode = mode;
+	m_bytes = static_cast<uint8_t*>(mapping);
+	m_size = fileSize;
+	resetDirtyBlocks();
+	return true;
+#else
+	(void)saveFilePath;
+	(void)mode;
+	return false;
+#endif
+}
+
+// release the mapping (if any)
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::unmap() {
+#ifdef SAVEBINARY_USE_MMAP
+	if (m_mapping != nullptr) {
+		::munmap(m_mapping, m_mappingSize);
 	}
-	return m_data[address];
+#endif
+	m_mapping = nullptr;
+	m_mappingSize = 0;
+	useOwnedData();
+}
+
+// point the view at m_data
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::useOwnedData() {
+	m_bytes = m_data.data();
+	m_size = m_data.size();
+	resetDirtyBlocks();
+}
+
+// size the dirty block bitmap to the current data and clear it
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::resetDirtyBlocks() {
+	size_t numBlocks = (m_size + DIRTY_BLOCK_SIZE - 1) / DIRTY_BLOCK_SIZE;
+	m_dirtyBlocks.assign((numBlocks + 63) / 64, 0);
+}
+
+// validate the loaded buffer, clearing it if it is too small to be a save
+template <typename AccessPolicy>
+bool BasicSaveBinary<AccessPolicy>::validateSize(const std::string& source) {
+	if (m_data.size() < MIN_SAVE_SIZE) {
+		js_error <<  "Save file size is too small: " << source << ". Expected minimum size: " << MIN_SAVE_SIZE << ", Actual size: " << m_data.size() << std::endl;
+		m_data.clear();
+		return false;
+	}
+	return true;
 }
 
-// get the word at the specified address (little endian)
-uint16_t SaveBinary::getWord(uint32_t address) const {
-	if (address + 1 >= m_data.size()) {
-		js_error <<  "Address out of bounds: " << std::hex << address << std::endl;
-		return 0;
-	}
-	return m_data[address] | (m_data[address + 1] << 8);
+// Destructor
+template <typename AccessPolicy>
+BasicSaveBinary<AccessPolicy>::~BasicSaveBinary() {
+	unmap();
 }
 
-// get the word at the specified address (big endian)
-uint16_t SaveBinary::getWordBE(uint32_t address) const {
-	if (address + 1 >= m_data.size()) {
-		js_error <<  "Address out of bounds: " << std::hex << address << std::endl;
-		return 0;
+// copy length bytes from source starting at sourceAddress to address
+template <typename AccessPolicy>
+bool BasicSaveBinary<AccessPolicy>::copyBytes(uint32_t address, const BasicSaveBinary& source, uint32_t sourceAddress, uint32_t length) {
+	if (length == 0) {
+		return true;
+	}
+	// error if locked or read-only
+	if (!checkWritable()) {
+		return false;
+	}
+	// error if either range is out of bounds
+	if (static_cast<size_t>(sourceAddress) + length > source.m_size) {
+		saveBinaryDetail::reportOutOfBounds(sourceAddress, length, source.m_symbols);
+		return false;
+	}
+	if (static_cast<size_t>(address) + length > m_size) {
+		saveBinaryDetail::reportOutOfBounds(address, length, m_symbols);
+		return false;
+	}
+	if (&source == this && sourceAddress < address && address < sourceAddress + length) {
+		// a forward byte copy onto an overlapping later range repeats the leading bytes,
+		// keep that behavior instead of memmove's
+		for (uint32_t i = 0; i < length; ++i) {
+			setByte(address + i, m_bytes[sourceAddress + i]);
+		}
+		return true;
 	}
-	return (m_data[address] << 8) | m_data[address + 1];
+	writeBytes(address, source.m_bytes + sourceAddress, length);
+	return true;
 }
 
-// update the byte at the specified address
-void SaveBinary::setByte(uint32_t address, uint8_t value) {
-	// error if locked
-	if (m_locked) {
-		js_error <<  "Save file is locked" << std::endl;
-		return;
+// set length bytes starting at address to value
+template <typename AccessPolicy>
+bool BasicSaveBinary<AccessPolicy>::fillBytes(uint32_t address, uint8_t value, uint32_t length) {
+	if (length == 0) {
+		return true;
+	}
+	// error if locked or read-only
+	if (!checkWritable()) {
+		return false;
 	}
 	// error if address out of bounds
-	if (address >= m_data.size()) {
-		js_error <<  "Address out of bounds: " << std::hex << address << std::endl;
-		return;
+	if (static_cast<size_t>(address) + length > m_size) {
+		saveBinaryDetail::reportOutOfBounds(address, length, m_symbols);
+		return false;
 	}
-	m_data[address] = value;
+	setBytes(address, value, length);
+	return true;
 }
 
-// update the word at the specified address (little endian)
-void SaveBinary::setWord(uint32_t address, uint16_t value) {
-	// error if locked
-	if (m_locked) {
-		js_error <<  "Save file is locked" << std::endl;
-		return;
+// copy length bytes starting at address into dest
+template <typename AccessPolicy>
+bool BasicSaveBinary<AccessPolicy>::loadBytes(uint32_t address, void* dest, uint32_t length) const {
+	if (length == 0) {
+		return true;
 	}
 	// error if address out of bounds
-	if (address + 1 >= m_data.size()) {
-		js_error <<  "Address out of bounds: " << std::hex << address << std::endl;
-		return;
+	if (static_cast<size_t>(address) + length > m_size) {
+		saveBinaryDetail::reportOutOfBounds(address, length, m_symbols);
+		return false;
 	}
-	m_data[address] = value & 0xFF;
-	m_data[address + 1] = (value >> 8) & 0xFF;
+	std::memcpy(dest, m_bytes + address, length);
+	return true;
 }
 
-// update the word at the specified address (big endian)
-void SaveBinary::setWordBE(uint32_t address, uint16_t value) {
-	// error if locked
-	if (m_locked) {
-		js_error <<  "Save file is locked" << std::endl;
-		return;
+// copy length bytes from src to address
+template <typename AccessPolicy>
+bool BasicSaveBinary<AccessPolicy>::storeBytes(uint32_t address, const void* src, uint32_t length) {
+	if (length == 0) {
+		return true;
+	}
+	// error if locked or read-only
+	if (!checkWritable()) {
+		return false;
 	}
 	// error if address out of bounds
-	if (address + 1 >= m_data.size()) {
-		js_error <<  "Address out of bounds: " << std::hex << address << std::endl;
-		return;
+	if (static_cast<size_t>(address) + length > m_size) {
+		saveBinaryDetail::reportOutOfBounds(address, length, m_symbols);
+		return false;
 	}
-	m_data[address] = (value >> 8) & 0xFF;
-	m_data[address + 1] = value & 0xFF;
-}
-
-// lock the class to prevent further modification
-void SaveBinary::lock() {
-	m_locked = true;
-}
-
-// unlock the class to allow modification
-void SaveBinary::unlock() {
-	m_locked = false;
-}
-
-// save the data to the specified file
-void SaveBinary::save(const std::string& saveFilePath) const {
+	writeBytes(address, static_cast<const uint8_t*>(src), length);
+	return true;
+}
+
+// save the data to the specified file, returns false if it could not be written
+template <typename AccessPolicy>
+bool BasicSaveBinary<AccessPolicy>::save(const std::string& saveFilePath) const {
+#ifdef SAVEBINARY_USE_MMAP
+	// write through a symlink to the file it points to, as writing the file in place does
+	std::string path = saveFilePath;
+	if (char* resolved = ::realpath(saveFilePath.c_str(), nullptr)) {
+		path = resolved;
+		std::free(resolved);
+	}
+	struct stat target;
+	bool targetExists = ::stat(path.c_str(), &target) == 0;
+	// the target may be the file a mapping reads from (under any name), truncating it would
+	// pull the pages out from under us, so write a new file next to it and swap it in. A file
+	// that doesn't exist yet can't be mapped and is created directly, the umask applying as usual.
+	std::string writePath = targetExists ? path + ".XXXXXX" : path;
+	int fd = targetExists ? ::mkstemp(&writePath[0]) : ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	if (fd < 0) {
+		js_error <<  "Failed to open save file: " << saveFilePath << std::endl;
+		return false;
+	}
+	if (targetExists) {
+		::fchmod(fd, target.st_mode & 07777);
+	}
+	const uint8_t* data = m_bytes;
+	size_t left = m_size;
+	while (left > 0) {
+		ssize_t written = ::write(fd, data, left);
+		if (written <= 0) {
+			js_error <<  "Failed to write save file: " << saveFilePath << std::endl;
+			::close(fd);
+			::unlink(writePath.c_str());
+			return false;
+		}
+		data += written;
+		left -= static_cast<size_t>(written);
+	}
+	if (::close(fd) != 0) {
+		js_error <<  "Failed to write save file: " << saveFilePath << std::endl;
+		::unlink(writePath.c_str());
+		return false;
+	}
+	if (targetExists && std::rename(writePath.c_str(), path.c_str()) != 0) {
+		js_error <<  "Failed to replace save file: " << saveFilePath << std::endl;
+		::unlink(writePath.c_str());
+		return false;
+	}
+	return true;
+#else
 	// Open the file
 	std::ofstream file(saveFilePath, std::ios::binary);
 	if (!file.is_open()) {
 		js_error <<  "Failed to open save file: " << saveFilePath << std::endl;
-		return;
+		return false;
 	}
 	// Write the data
-	file.write(reinterpret_cast<const char*>(m_data.data()), m_data.size());
+	file.write(reinterpret_cast<const char*>(m_bytes), m_size);
 	file.close();
+	if (file.fail()) {
+		js_error <<  "Failed to write save file: " << saveFilePath << std::endl;
+		return false;
+	}
+	return true;
+#endif
+}
+
+// move the save data out of the class, leaving it empty
+template <typename AccessPolicy>
+std::vector<uint8_t> BasicSaveBinary<AccessPolicy>::releaseData() {
+	std::vector<uint8_t> data;
+	if (m_mapping != nullptr) {
+		// a mapping can't be handed out, copy it instead
+		data.assign(m_bytes, m_bytes + m_size);
+		unmap();
+	} else {
+		data = std::move(m_data);
+	}
+	m_data.clear();
+	useOwnedData();
+	m_trackedChecksums.clear();
+	return data;
+}
+
+// check that [start, end) lies within the save data
+template <typename AccessPolicy>
+bool BasicSaveBinary<AccessPolicy>::validateRange(uint32_t start, uint32_t end) const {
+	if (start > end || end > m_size) {
+		js_error <<  "Invalid range: " << std::hex << start << " " << end << ", save size: " << m_size << std::endl;
+		return false;
+	}
+	return true;
 }
 
-// Iterator constructor
-SaveBinary::Iterator::Iterator(SaveBinary& saveBinary, uint32_t address) : m_saveBinary(saveBinary), m_address(address) {
-}
-
-// Iterator destructor
-SaveBinary::Iterator::~Iterator() {
-}
-
-// Get the byte at the current address
-uint8_t SaveBinary::Iterator::getByte() const {
-	return m_saveBinary.getByte(m_address);
-}
-
-// Get the byte at the requested address
-uint8_t SaveBinary::Iterator::getByte(uint32_t address) {
-	// seek to address
-	seek(address);
-	return m_saveBinary.getByte(m_address);
-}
-
-// Get the word at the current address (little endian)
-uint16_t SaveBinary::Iterator::getWord() const {
-	return m_saveBinary.getWord(m_address);
-}
-
-// Get the word at the requested address (little endian)
-uint16_t SaveBinary::Iterator::getWord(uint32_t address) {
-	// seek to address
-	seek(address);
-	return m_saveBinary.getWord(m_address);
-}
-
-// Get the word at the current address (big endian)
-uint16_t SaveBinary::Iterator::getWordBE() const {
-	return m_saveBinary.getWordBE(m_address);
-}
-
-// Get the word at the requested address (big endian)
-uint16_t SaveBinary::Iterator::getWordBE(uint32_t address) {
-	// seek to address
-	seek(address);
-	return m_saveBinary.getWordBE(m_address);
-}
-
-// get the specified bit from the byte at the current address
-bool SaveBinary::Iterator::getBit(uint8_t bit) const {
-	return m_saveBinary.getByte(m_address) & (1 << bit);
-}
-
-// get the specified bit from the byte at the requested address
-bool SaveBinary::Iterator::getBit(uint32_t address, uint8_t bit) {
-	// seek to address
-	seek(address);
-	return m_saveBinary.getByte(m_address) & (1 << bit);
-}
-
-// Update the byte at the current address
-void SaveBinary::Iterator::setByte(uint8_t value) {
-	m_saveBinary.setByte(m_address, value);
-}
-
-// Update the byte at the requested address
-void SaveBinary::Iterator::setByte(uint32_t address, uint8_t value) {
-	// seek to address
-	seek(address);
-	m_saveBinary.setByte(m_address, value);
-}
-
-// Update the word at the current address (little endian)
-void SaveBinary::Iterator::setWord(uint16_t value) {
-	m_saveBinary.setWord(m_address, value);
-}
-
-// Update the word at the requested address (little endian)
-void SaveBinary::Iterator::setWord(uint32_t address, uint16_t value) {
-	// seek to address
-	seek(address);
-	m_saveBinary.setWord(m_address, value);
-}
-
-// Update the word at the current address (big endian)
-void SaveBinary::Iterator::setWordBE(uint16_t value) {
-	m_saveBinary.setWordBE(m_address, value);
-}
-
-// Update the word at the requested address (big endian)
-void SaveBinary::Iterator::setWordBE(uint32_t address, uint16_t value) {
-	// seek to address
-	seek(address);
-	m_saveBinary.setWordBE(m_address, value);
+// forget which blocks have been written so far
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::clearDirtyBlocks() {
+	std::fill(m_dirtyBlocks.begin(), m_dirtyBlocks.end(), 0);
 }
 
-// set the specified bit in the byte at the current address
-void SaveBinary::Iterator::setBit(uint8_t bit) {
-	uint8_t value = m_saveBinary.getByte(m_address);
-	value |= (1 << bit);
-	m_saveBinary.setByte(m_address, value);
+// copy every block written in either save since the last clearDirtyBlocks() from other
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::copyDirtyBlocksFrom(const BasicSaveBinary& other) {
+	if (!checkWritable()) {
+		return;
+	}
+	if (m_size != other.m_size) {
+		js_error <<  "Save sizes differ: " << m_size << " and " << other.m_size << std::endl;
+		return;
+	}
+	for (size_t word = 0; word < m_dirtyBlocks.size(); ++word) {
+		uint64_t dirty = m_dirtyBlocks[word] | other.m_dirtyBlocks[word];
+		while (dirty != 0) {
+			// find the next run of dirty blocks and copy it in one go
+			uint32_t first = 0;
+			while (!(dirty & (uint64_t(1) << first))) {
+				++first;
+			}
+			uint32_t last = first;
+			while (last < 64 && (dirty & (uint64_t(1) << last))) {
+				++last;
+			}
+			size_t begin = (word * 64 + first) * DIRTY_BLOCK_SIZE;
+			size_t end = std::min<size_t>((word * 64 + last) * DIRTY_BLOCK_SIZE, m_size);
+			writeBytes(static_cast<uint32_t>(begin), other.m_bytes + begin, end - begin);
+			dirty &= (last == 64) ? 0 : (~uint64_t(0) << last);
+		}
+	}
 }
 
-// reset the specified bit in the byte at the current address
-void SaveBinary::Iterator::resetBit(uint8_t bit) {
-	uint8_t value = m_saveBinary.getByte(m_address);
-	value &= ~(1 << bit);
-	m_saveBinary.setByte(m_address, value);
+// use the symbol database of the save's layout to annotate the addresses in error reports
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::setSymbols(const SymbolDatabase* symbols) {
+	m_symbols = symbols;
 }
 
-// reset the specified bit in the byte at the requested address
-void SaveBinary::Iterator::resetBit(uint32_t address, uint8_t bit) {
-	// seek to address
-	seek(address);
-	uint8_t value = m_saveBinary.getByte(m_address);
-	value &= ~(1 << bit);
-	m_saveBinary.setByte(m_address, value);
+// overwrite length bytes at address, keeping the dirty blocks and tracked checksums in sync
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::writeBytes(uint32_t address, const uint8_t* src, size_t length) {
+	if (length == 0) {
+		return;
+	}
+	// swap the old bytes of each overlapping tracked range for the new ones
+	for (TrackedChecksum& tracked : m_trackedChecksums) {
+		uint32_t begin = std::max<uint32_t>(tracked.start, address);
+		uint32_t end = static_cast<uint32_t>(std::min<size_t>(tracked.end, address + length));
+		if (begin < end) {
+			tracked.checksum -= calculateByteSumChecksum({m_bytes + begin, end - begin});
+			tracked.checksum += calculateByteSumChecksum({src + (begin - address), end - begin});
+		}
+	}
+	std::memmove(m_bytes + address, src, length);
+	markDirtyRange(address, length);
 }
 
-// set the specified bit in the byte at the requested address
-void SaveBinary::Iterator::setBit(uint32_t address, uint8_t bit) {
-	// seek to address
-	seek(address);
-	uint8_t value = m_saveBinary.getByte(m_address);
-	value |= (1 << bit);
-	m_saveBinary.setByte(m_address, value);
+// set length bytes at address to value, keeping the dirty blocks and tracked checksums in sync
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::setBytes(uint32_t address, uint8_t value, size_t length) {
+	if (length == 0) {
+		return;
+	}
+	for (TrackedChecksum& tracked : m_trackedChecksums) {
+		uint32_t begin = std::max<uint32_t>(tracked.start, address);
+		uint32_t end = static_cast<uint32_t>(std::min<size_t>(tracked.end, address + length));
+		if (begin < end) {
+			tracked.checksum -= calculateByteSumChecksum({m_bytes + begin, end - begin});
+			tracked.checksum += static_cast<uint16_t>(value * (end - begin));
+		}
+	}
+	std::memset(m_bytes + address, value, length);
+	markDirtyRange(address, length);
 }
 
-// Move the iterator to the next byte
-void SaveBinary::Iterator::next() {
-	++m_address;
+// mark every block overlapping [address, address + length) as written
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::markDirtyRange(uint32_t address, size_t length) {
+	uint32_t lastBlock = static_cast<uint32_t>((address + length - 1) / DIRTY_BLOCK_SIZE);
+	for (uint32_t block = address / DIRTY_BLOCK_SIZE; block <= lastBlock; ++block) {
+		m_dirtyBlocks[block >> 6] |= uint64_t(1) << (block & 63);
+	}
 }
 
-// Move the iterator to the previous byte
-void SaveBinary::Iterator::prev() {
-	--m_address;
+// keep the checksum of [start, end) up to date on every write from now on
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::trackChecksum(uint32_t start, uint32_t end) {
+	if (start >= end || end > m_size) {
+		js_error <<  "Invalid checksum range: " << std::hex << start << " " << end << std::endl;
+		return;
+	}
+	trackChecksum(start, end, calculateByteSumChecksum({m_bytes + start, end - start}));
 }
 
-// Move the iterator to the specified address
-void SaveBinary::Iterator::seek(uint32_t address) {
-	if (m_address == address) {
-		//js_error <<  "Iterator is already at the requested address: " << std::hex << address << std::endl;
+// same as above when the current checksum of the range is already known
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::trackChecksum(uint32_t start, uint32_t end, uint16_t checksum) {
+	if (start >= end || end > m_size) {
+		js_error <<  "Invalid checksum range: " << std::hex << start << " " << end << std::endl;
 		return;
 	}
-	m_address = address;
+	for (TrackedChecksum& tracked : m_trackedChecksums) {
+		if (tracked.start == start && tracked.end == end) {
+			tracked.checksum = checksum;
+			return;
+		}
+	}
+	m_trackedChecksums.push_back({start, end, checksum});
 }
 
-// Get the current address
-uint32_t SaveBinary::Iterator::getAddress() const {
-	return m_address;
+// get the running checksum of a tracked range
+template <typename AccessPolicy>
+bool BasicSaveBinary<AccessPolicy>::getTrackedChecksum(uint32_t start, uint32_t end, uint16_t& checksum) const {
+	for (const TrackedChecksum& tracked : m_trackedChecksums) {
+		if (tracked.start == start && tracked.end == end) {
+			checksum = tracked.checksum;
+			return true;
+		}
+	}
+	return false;
 }
 
-// Check if the iterator is at the end
-bool SaveBinary::Iterator::isEnd() const {
-	return m_address >= m_saveBinary.m_data.size();
+// stop tracking all checksums
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::clearTrackedChecksums() {
+	m_trackedChecksums.clear();
 }
 
-// copy specified number of bytes from input iterator to this iterator starting at current address
-void SaveBinary::Iterator::copy(Iterator& it, uint32_t numBytes) {
-	// copy bytes
-	for (uint32_t i = 0; i < numBytes; ++i) {
-		if (it.isEnd()) {
-			break;
+// recalculate every tracked checksum from the data
+template <typename AccessPolicy>
+void BasicSaveBinary<AccessPolicy>::recalculateTrackedChecksums() {
+	for (TrackedChecksum& tracked : m_trackedChecksums) {
+		if (tracked.end > m_size) {
+			// the range no longer fits the data, stop tracking it below
+			tracked.end = 0;
+			continue;
 		}
-		setByte(it.getByte());
-		it.next();
-		next();
+		tracked.checksum = calculateByteSumChecksum({m_bytes + tracked.start, tracked.end - tracked.start});
 	}
+	m_trackedChecksums.erase(std::remove_if(m_trackedChecksums.begin(), m_trackedChecksums.end(), [](const TrackedChecksum& tracked) {
+		return tracked.end == 0;
+	}), m_trackedChecksums.end());
 }
 
-// copy specified number of bytes from input iterator to this iterator starting at specified address
-void SaveBinary::Iterator::copy(Iterator& it, uint32_t address, uint32_t numBytes) {
-	// move to specified address
-	seek(address);
-	// copy bytes
-	copy(it, numBytes);
-}
-
-// Return the current address
-uint32_t SaveBinary::Iterator::getAddress() {
-	return m_address;
-}
\ No newline at end of file
+// the patcher uses the checked policy by default, the unchecked one is opt-in
+template class BasicSaveBinary<CheckedAccess>;
+template class BasicSaveBinary<UncheckedAccess>;
@@ -0,0 +1,71 @@
+#include "core/SaveChecksum.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#define SAVE_CHECKSUM_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+	// sum the bytes one at a time
+	uint64_t sumBytesScalar(const uint8_t* data, size_t size) {
+		uint64_t sum = 0;
+		for (size_t i = 0; i < size; ++i) {
+			sum += data[i];
+		}
+		return sum;
+	}
+
+#ifdef SAVE_CHECKSUM_X86
+	// sum 16 bytes per step, psadbw against zero adds up each group of 8 bytes
+	uint64_t sumBytesSSE2(const uint8_t* data, size_t size) {
+		const __m128i zero = _mm_setzero_si128();
+		__m128i acc = _mm_setzero_si128();
+		size_t i = 0;
+		for (; i + 16 <= size; i += 16) {
+			__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+			acc = _mm_add_epi64(acc, _mm_sad_epu8(bytes, zero));
+		}
+		uint64_t lanes[2];
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+		return lanes[0] + lanes[1] + sumBytesScalar(data + i, size - i);
+	}
+
+	// sum 32 bytes per step
+	__attribute__((target("avx2")))
+	uint64_t sumBytesAVX2(const uint8_t* data, size_t size) {
+		const __m256i zero = _mm256_setzero_si256();
+		__m256i acc = _mm256_setzero_si256();
+		size_t i = 0;
+		for (; i + 32 <= size; i += 32) {
+			__m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+			acc = _mm256_add_epi64(acc, _mm256_sad_epu8(bytes, zero));
+		}
+		uint64_t lanes[4];
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+		return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sumBytesSSE2(data + i, size - i);
+	}
+
+	// check once whether the CPU can run the AVX2 kernel
+	bool hasAVX2() {
+		static const bool supported = __builtin_cpu_supports("avx2");
+		return supported;
+	}
+#endif
+
+}
+
+// 16-bit wraparound sum of every byte in the span
+uint16_t calculateByteSumChecksum(ConstByteSpan bytes) {
+	if (bytes.data == nullptr || bytes.size == 0) {
+		return 0;
+	}
+#ifdef SAVE_CHECKSUM_X86
+	if (hasAVX2()) {
+		return static_cast<uint16_t>(sumBytesAVX2(bytes.data, bytes.size));
+	}
+	return static_cast<uint16_t>(sumBytesSSE2(bytes.data, bytes.size));
+#else
+	return static_cast<uint16_t>(sumBytesScalar(bytes.data, bytes.size));
+#endif
+}
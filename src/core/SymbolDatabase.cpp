@@ -2,237 +2,701 @@
 #include "core/SymbolDatabase.h"
 #include "core/PatcherConstants.h"
 #include "core/Logging.h"
-#include <iostream>
-#include <regex>
-#include <sstream>
+#include "core/SymbolDatabaseContents.h"
+#include <cstring>
+#include <algorithm>
+#include <map>
 
-static
-std::string bytes_to_string(const unsigned char* data, std::size_t len) {
-    if (!data || len == 0) return std::string();
-    return std::string(reinterpret_cast<const char*>(data), len);
+// value of a hex digit, or -1 if c isn't one
+static int hex_value(unsigned char c) {
+	if (c >= '0' && c <= '9') return c - '0';
+	if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+	if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+	return -1;
 }
 
-void SymbolDatabase::processSymbolString(const std::string& data) {
-	std::istringstream decompressedStream(data);
-	std::string line;
-	std::regex symbolRegex(R"((\w{2}):(\w{4})\s([A-Za-z0-9_.]+))");
-	std::smatch match;
+// parse count hex digits starting at p into value, returns false on a non hex digit
+static bool parse_hex(const unsigned char* p, int count, uint32_t& value) {
+	value = 0;
+	for (int i = 0; i < count; i++) {
+		int digit = hex_value(p[i]);
+		if (digit < 0) {
+			return false;
+		}
+		value = (value << 4) | digit;
+	}
+	return true;
+}
+
+// check if c may appear in a symbol name
+static bool is_name_char(unsigned char c) {
+	return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_' || c == '.';
+}
+
+// check if c is the whitespace separating the address from the name
+static bool is_separator(unsigned char c) {
+	return c == ' ' || c == '\t' || c == '\v' || c == '\f' || c == '\r';
+}
 
-	while (std::getline(decompressedStream, line)) {
-		if (!line.empty() && line.back() == '\r') {
-			line.pop_back();
+// read a little endian value from the table
+template <typename T>
+static T read_le(const unsigned char* p) {
+	T value = 0;
+	for (size_t i = 0; i < sizeof(T); i++) {
+		value |= static_cast<T>(p[i]) << (8 * i);
+	}
+	return value;
+}
+
+// split a numbered symbol name into the parts around its number, e.g. sNewBox12Name into
+// sNewBox, 12 and Name. Only names with a single run of digits (no leading zeros, at most
+// 255) are numbered; this is the same rule tools/build_symtab.py uses to build families.
+static bool split_family_name(std::string_view name, std::string_view& prefix, int& number, std::string_view& suffix) {
+	size_t digits = name.find_first_of("0123456789");
+	if (digits == std::string_view::npos) {
+		return false;
+	}
+	size_t digitsEnd = name.find_first_not_of("0123456789", digits);
+	if (digitsEnd == std::string_view::npos) {
+		digitsEnd = name.size();
+	}
+	if (digitsEnd - digits > 3 || (name[digits] == '0' && digitsEnd - digits > 1) ||
+		name.find_first_of("0123456789", digitsEnd) != std::string_view::npos) {
+		return false;
+	}
+	number = 0;
+	for (size_t i = digits; i < digitsEnd; i++) {
+		number = number * 10 + (name[i] - '0');
+	}
+	prefix = name.substr(0, digits);
+	suffix = name.substr(digitsEnd);
+	return number <= 0xFF;
+}
+
+// scan a text symbol blob in a single pass. Each line has the form "BB:AAAA Name"
+// (bank and address in hex), anything else (comments, blank lines) is skipped.
+// The symbols are laid out in m_ownedPool and m_ownedRecords in the same format as the
+// embedded pool and table, every name of the pool being defined.
+void SymbolDatabase::processSymbolData(const unsigned char* data, size_t length) {
+	struct Entry {
+		std::string_view name;
+		uint8_t bank;
+		uint16_t address;
+	};
+	std::vector<Entry> entries;
+	const unsigned char* end = data + length;
+	const unsigned char* line = data;
+	while (line < end) {
+		const unsigned char* lineEnd = static_cast<const unsigned char*>(std::memchr(line, '\n', end - line));
+		if (lineEnd == nullptr) {
+			lineEnd = end;
+		}
+		const unsigned char* next = lineEnd < end ? lineEnd + 1 : end;
+		if (lineEnd > line && lineEnd[-1] == '\r') {
+			--lineEnd;
 		}
-		if (!std::regex_match(line, match, symbolRegex)) {
+
+		// "BB:AAAA" followed by a separator and at least one name character
+		uint32_t bank;
+		uint32_t address;
+		if (lineEnd - line < 9 || line[2] != ':' || !is_separator(line[7]) ||
+			!parse_hex(line, 2, bank) || !parse_hex(line + 3, 4, address)) {
+			line = next;
+			continue;
+		}
+		const unsigned char* name = line + 8;
+		const unsigned char* nameEnd = name;
+		while (nameEnd < lineEnd && is_name_char(*nameEnd)) {
+			++nameEnd;
+		}
+		if (nameEnd != lineEnd || nameEnd - name > 0xFF) {
+			line = next;
 			continue;
 		}
 
-		Symbol symbol;
-		symbol.bank = std::stoi(match[1].str(), nullptr, 16);
-		symbol.address = std::stoi(match[2].str(), nullptr, 16);
-		symbol.name = match[3].str();
+		entries.push_back({std::string_view(reinterpret_cast<const char*>(name), nameEnd - name), static_cast<uint8_t>(bank), static_cast<uint16_t>(address)});
+		line = next;
+	}
+
+	// sort by name, a name listed more than once keeps its last definition
+	std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.name < b.name; });
+	size_t unique = 0;
+	for (size_t i = 0; i < entries.size(); i++) {
+		if (unique > 0 && entries[unique - 1].name == entries[i].name) {
+			entries[unique - 1] = entries[i];
+		} else {
+			entries[unique++] = entries[i];
+		}
+	}
+	entries.resize(unique);
+
+	// group the numbered names into families by pattern, keeping groups of two or more
+	std::map<std::string, std::map<int, uint32_t>> familyMembers;
+	for (size_t i = 0; i < entries.size(); i++) {
+		std::string_view prefix;
+		std::string_view suffix;
+		int number;
+		if (split_family_name(entries[i].name, prefix, number, suffix)) {
+			std::string pattern(prefix);
+			pattern += '#';
+			pattern += suffix;
+			familyMembers[pattern][number] = static_cast<uint32_t>(i);
+		}
+	}
+	for (auto it = familyMembers.begin(); it != familyMembers.end();) {
+		it = it->second.size() > 1 ? std::next(it) : familyMembers.erase(it);
+	}
+
+	// header, names, families, members and strings
+	size_t stringsSize = 0;
+	for (const Entry& entry : entries) {
+		stringsSize += entry.name.size();
+	}
+	size_t membersSize = 0;
+	for (const auto& family : familyMembers) {
+		stringsSize += family.first.size();
+		membersSize += (family.second.rbegin()->first - family.second.begin()->first + 1) * sizeof(uint32_t);
+	}
+	m_nameCount = static_cast<uint32_t>(entries.size());
+	m_familyCount = static_cast<uint32_t>(familyMembers.size());
+	m_familyOffset = static_cast<uint32_t>(POOL_HEADER_SIZE + entries.size() * sizeof(Name));
+	uint32_t membersOffset = static_cast<uint32_t>(m_familyOffset + familyMembers.size() * sizeof(Family));
+	m_stringsOffset = static_cast<uint32_t>(membersOffset + membersSize);
+	m_ownedPool.assign(m_stringsOffset + stringsSize, 0);
+	m_ownedRecords.resize(entries.size());
+	Name* names = reinterpret_cast<Name*>(m_ownedPool.data() + POOL_HEADER_SIZE);
+	unsigned char* strings = m_ownedPool.data() + m_stringsOffset;
+	uint32_t stringOffset = 0;
+	for (size_t i = 0; i < entries.size(); i++) {
+		names[i].offset = stringOffset;
+		names[i].length = static_cast<uint8_t>(entries[i].name.size());
+		m_ownedRecords[i].address = entries[i].address;
+		m_ownedRecords[i].bank = entries[i].bank;
+		m_ownedRecords[i].flags = SYMBOL_DEFINED;
+		std::memcpy(strings + stringOffset, entries[i].name.data(), entries[i].name.size());
+		stringOffset += static_cast<uint32_t>(entries[i].name.size());
+	}
+	Family* families = reinterpret_cast<Family*>(m_ownedPool.data() + m_familyOffset);
+	for (const auto& family : familyMembers) {
+		int first = family.second.begin()->first;
+		int count = family.second.rbegin()->first - first + 1;
+		families->nameOffset = stringOffset;
+		families->membersOffset = membersOffset;
+		families->count = static_cast<uint16_t>(count);
+		families->first = static_cast<uint8_t>(first);
+		families->nameLength = static_cast<uint8_t>(family.first.size());
+		std::memcpy(strings + stringOffset, family.first.data(), family.first.size());
+		stringOffset += static_cast<uint32_t>(family.first.size());
+		for (int number = first; number < first + count; number++) {
+			auto member = family.second.find(number);
+			uint32_t nameId = member != family.second.end() ? member->second : NO_MEMBER;
+			std::memcpy(m_ownedPool.data() + membersOffset, &nameId, sizeof(nameId));
+			membersOffset += sizeof(nameId);
+		}
+		++families;
+	}
+	m_pool = m_ownedPool.data();
+	m_records = m_ownedRecords.data();
+	m_count = m_nameCount;
+}
+
+// 32-bit FNV-1a hash, the same as tools/build_symtab.py uses to tie a table to its pool
+static uint32_t fnv1a(const unsigned char* data, size_t length) {
+	uint32_t value = 0x811C9DC5;
+	for (size_t i = 0; i < length; i++) {
+		value = (value ^ data[i]) * 0x01000193;
+	}
+	return value;
+}
+
+// use the pool in place if it is valid
+bool SymbolDatabase::usePool(const unsigned char* pool, size_t length) {
+	if (length < POOL_HEADER_SIZE || read_le<uint32_t>(pool) != POOL_MAGIC) {
+		js_error << "Symbol name pool is corrupt" << std::endl;
+		return false;
+	}
+	if (read_le<uint16_t>(pool + 4) != POOL_VERSION) {
+		js_error << "Unsupported symbol name pool version: " << read_le<uint16_t>(pool + 4) << std::endl;
+		return false;
+	}
+	uint32_t nameCount = read_le<uint32_t>(pool + 8);
+	uint32_t familyCount = read_le<uint32_t>(pool + 12);
+	uint32_t familyOffset = read_le<uint32_t>(pool + 16);
+	uint32_t stringsOffset = read_le<uint32_t>(pool + 20);
+	size_t membersStart = familyOffset + static_cast<size_t>(familyCount) * sizeof(Family);
+	if (familyOffset != POOL_HEADER_SIZE + static_cast<size_t>(nameCount) * sizeof(Name) ||
+		membersStart > stringsOffset || stringsOffset > length) {
+		js_error << "Symbol name pool is corrupt" << std::endl;
+		return false;
+	}
+	// every name has to lie within the strings
+	const Name* names = reinterpret_cast<const Name*>(pool + POOL_HEADER_SIZE);
+	for (uint32_t i = 0; i < nameCount; i++) {
+		if (static_cast<size_t>(stringsOffset) + names[i].offset + names[i].length > length) {
+			js_error << "Symbol name pool is corrupt" << std::endl;
+			return false;
+		}
+	}
+	// and every family's pattern too, with its members before the strings and naming valid ids
+	const Family* families = reinterpret_cast<const Family*>(pool + familyOffset);
+	for (uint32_t i = 0; i < familyCount; i++) {
+		if (static_cast<size_t>(stringsOffset) + families[i].nameOffset + families[i].nameLength > length ||
+			families[i].membersOffset < membersStart ||
+			families[i].membersOffset + static_cast<size_t>(families[i].count) * sizeof(uint32_t) > stringsOffset) {
+			js_error << "Symbol name pool is corrupt" << std::endl;
+			return false;
+		}
+		for (uint16_t j = 0; j < families[i].count; j++) {
+			uint32_t nameId = read_le<uint32_t>(pool + families[i].membersOffset + j * sizeof(uint32_t));
+			if (nameId != NO_MEMBER && nameId >= nameCount) {
+				js_error << "Symbol name pool is corrupt" << std::endl;
+				return false;
+			}
+		}
+	}
+	m_pool = pool;
+	m_nameCount = nameCount;
+	m_familyCount = familyCount;
+	m_familyOffset = familyOffset;
+	m_stringsOffset = stringsOffset;
+	return true;
+}
+
+// use the table in place if it is valid and was built against the pool
+bool SymbolDatabase::useTable(const unsigned char* table, size_t length, const unsigned char* pool, size_t poolLength) {
+	if (length < TABLE_HEADER_SIZE || read_le<uint32_t>(table) != TABLE_MAGIC) {
+		js_error << "Symbol table is corrupt" << std::endl;
+		return false;
+	}
+	if (read_le<uint16_t>(table + 4) != TABLE_VERSION) {
+		js_error << "Unsupported symbol table version: " << read_le<uint16_t>(table + 4) << std::endl;
+		return false;
+	}
+	uint32_t count = read_le<uint32_t>(table + 8);
+	if (count != m_nameCount || read_le<uint32_t>(table + 12) != fnv1a(pool, poolLength)) {
+		js_error << "Symbol table doesn't match the symbol name pool" << std::endl;
+		return false;
+	}
+	if (TABLE_HEADER_SIZE + static_cast<size_t>(count) * sizeof(Symbol) > length) {
+		js_error << "Symbol table is corrupt" << std::endl;
+		return false;
+	}
+	m_records = reinterpret_cast<const Symbol*>(table + TABLE_HEADER_SIZE);
+	m_count = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		if (m_records[i].flags & SYMBOL_DEFINED) {
+			m_count++;
+		}
+	}
+	return true;
+}
 
-		m_symbols[symbol.name] = symbol;
+// Constructor from a text .sym blob
+SymbolDatabase::SymbolDatabase(const unsigned char* buffer, size_t length) : m_pool(nullptr), m_records(nullptr), m_nameCount(0), m_familyCount(0), m_familyOffset(POOL_HEADER_SIZE), m_stringsOffset(POOL_HEADER_SIZE), m_count(0) {
+	if (buffer == nullptr) {
+		length = 0;
 	}
+	processSymbolData(buffer, length);
+	resolveSaveBlocks();
 }
 
-// Constructor
-SymbolDatabase::SymbolDatabase(const unsigned char* buffer, size_t length) {
-	std::string data = bytes_to_string(buffer, length);
-	processSymbolString(data);
+// Constructor from a name pool and a version table built against it
+SymbolDatabase::SymbolDatabase(const unsigned char* pool, size_t poolLength, const unsigned char* table, size_t tableLength) : m_pool(nullptr), m_records(nullptr), m_nameCount(0), m_familyCount(0), m_familyOffset(POOL_HEADER_SIZE), m_stringsOffset(POOL_HEADER_SIZE), m_count(0) {
+	if (!usePool(pool, poolLength) || !useTable(table, tableLength, pool, poolLength)) {
+		// fall back to an empty database, every lookup fails and reports the missing symbol
+		processSymbolData(nullptr, 0);
+	}
+	resolveSaveBlocks();
+}
+
+// get the shared symbol database of a save version, built on first use. Function local
+// statics are initialized exactly once even when several threads get there together.
+const SymbolDatabase& SymbolDatabase::forVersion(int version) {
+	switch (version) {
+	case 7: {
+		static const SymbolDatabase sym7(symbol_names_pool_data, symbol_names_pool_len, version7_sym_data, version7_sym_len);
+		return sym7;
+	}
+	case 8: {
+		static const SymbolDatabase sym8(symbol_names_pool_data, symbol_names_pool_len, version8_sym_data, version8_sym_len);
+		return sym8;
+	}
+	case 9: {
+		static const SymbolDatabase sym9(symbol_names_pool_data, symbol_names_pool_len, version9_sym_data, version9_sym_len);
+		return sym9;
+	}
+	case 10: {
+		static const SymbolDatabase sym10(symbol_names_pool_data, symbol_names_pool_len, version10_sym_data, version10_sym_len);
+		return sym10;
+	}
+	default: {
+		js_error << "No symbol database for version " << version << std::endl;
+		// every lookup in the empty database fails and reports the missing symbol
+		static const SymbolDatabase empty(nullptr, 0);
+		return empty;
+	}
+	}
+}
+
+// build every version's symbol database up front
+void SymbolDatabase::warmup() {
+	for (int version = 7; version <= 10; version++) {
+		forVersion(version);
+	}
 }
 
 // Destructor
 SymbolDatabase::~SymbolDatabase() {
 }
 
-// Get the symbol by name
-const SymbolDatabase::Symbol* SymbolDatabase::getSymbol(const std::string& name) const {
-	auto it = m_symbols.find(name);
-	if (it == m_symbols.end()) {
+// get the sorted names
+const SymbolDatabase::Name* SymbolDatabase::names() const {
+	return reinterpret_cast<const Name*>(m_pool + POOL_HEADER_SIZE);
+}
+
+// get the sorted families
+const SymbolDatabase::Family* SymbolDatabase::families() const {
+	return reinterpret_cast<const Family*>(m_pool + m_familyOffset);
+}
+
+// get a string of the pool
+std::string_view SymbolDatabase::getString(uint32_t offset, uint8_t length) const {
+	return std::string_view(reinterpret_cast<const char*>(m_pool + m_stringsOffset + offset), length);
+}
+
+// get the id of a name, NO_MEMBER if the pool doesn't have it
+uint32_t SymbolDatabase::findNameId(std::string_view name) const {
+	// binary search the names, which are sorted
+	const Name* first = names();
+	const Name* last = first + m_nameCount;
+	const Name* it = std::lower_bound(first, last, name, [this](const Name& entry, std::string_view key) {
+		return getString(entry.offset, entry.length) < key;
+	});
+	if (it == last || getString(it->offset, it->length) != name) {
+		return NO_MEMBER;
+	}
+	return static_cast<uint32_t>(it - first);
+}
+
+// get the record of a name id if the version defines it, nullptr otherwise
+const SymbolDatabase::Symbol* SymbolDatabase::getDefined(uint32_t nameId) const {
+	if (nameId >= m_nameCount || !(m_records[nameId].flags & SYMBOL_DEFINED)) {
+		return nullptr;
+	}
+	return m_records + nameId;
+}
+
+// Get the symbol by name, reporting it if missing
+const SymbolDatabase::Symbol* SymbolDatabase::getSymbol(std::string_view name) const {
+	const Symbol* symbol = findSymbol(name);
+	if (symbol == nullptr) {
 		js_error << "Symbol " << name << " not found" << std::endl;
+	}
+	return symbol;
+}
+
+// Get the symbol by name, nullptr if missing
+const SymbolDatabase::Symbol* SymbolDatabase::findSymbol(std::string_view name) const {
+	return getDefined(findNameId(name));
+}
+
+// Get the name of a symbol
+std::string_view SymbolDatabase::getName(const Symbol& symbol) const {
+	const Name& name = names()[&symbol - m_records];
+	return getString(name.offset, name.length);
+}
+
+// Get a family of numbered symbols by pattern, nullptr if missing
+const SymbolDatabase::Family* SymbolDatabase::findFamily(std::string_view pattern) const {
+	// binary search the families, which are sorted by pattern
+	const Family* first = families();
+	const Family* last = first + m_familyCount;
+	const Family* it = std::lower_bound(first, last, pattern, [this](const Family& family, std::string_view key) {
+		return getName(family) < key;
+	});
+	if (it == last || getName(*it) != pattern) {
 		return nullptr;
 	}
-	return &it->second;
+	return it;
 }
 
-// Returns if symbol by name is within rom
-bool SymbolDatabase::isROM(const std::string& name) const {
+// Get the pattern of a family
+std::string_view SymbolDatabase::getName(const Family& family) const {
+	return getString(family.nameOffset, family.nameLength);
+}
+
+// Get the member of a family by number, nullptr if the family has no such member
+const SymbolDatabase::Symbol* SymbolDatabase::getMember(const Family& family, int number) const {
+	if (number < family.first || number >= family.first + family.count) {
+		return nullptr;
+	}
+	return getDefined(read_le<uint32_t>(m_pool + family.membersOffset + (number - family.first) * sizeof(uint32_t)));
+}
+
+// Get the number of symbols
+size_t SymbolDatabase::size() const {
+	return m_count;
+}
+
+// Get the region a symbol lives in
+SymbolDatabase::Region SymbolDatabase::getRegion(const Symbol& symbol) {
 	// ROM is from 0x0000 to 0x7FFF
-	const Symbol* symbol = getSymbol(name);
-	if (symbol == nullptr) {
-		return false;
+	if (symbol.address < VRAM_START_ADDRESS) {
+		return Region::ROM;
 	}
-	return symbol->address < VRAM_START_ADDRESS;
+	// VRAM is from 0x8000 to 0x9FFF
+	if (symbol.address < SRAM_START_ADDRESS) {
+		return Region::VRAM;
+	}
+	// SRAM is from 0xA000 to 0xBFFF
+	if (symbol.address < WRAM0_START_ADDRESS) {
+		return Region::SRAM;
+	}
+	// WRAM is from 0xC000 to 0xDFFF
+	if (symbol.address < ECHO_WRAM_START_ADDRESS) {
+		return Region::WRAM;
+	}
+	// HRAM is from 0xFF80 to 0xFFFF
+	if (symbol.address >= HRAM_START_ADDRESS) {
+		return Region::HRAM;
+	}
+	return Region::OTHER;
+}
+
+// Returns if symbol by name is within rom
+bool SymbolDatabase::isROM(std::string_view name) const {
+	const Symbol* symbol = getSymbol(name);
+	return symbol != nullptr && getRegion(*symbol) == Region::ROM;
 }
 
 // Returns if symbol by name is within vram
-bool SymbolDatabase::isVRAM(const std::string& name) const {
-	// VRAM is from 0x8000 to 0x9FFF
+bool SymbolDatabase::isVRAM(std::string_view name) const {
 	const Symbol* symbol = getSymbol(name);
-	if (symbol == nullptr) {
-		return false;
-	}
-	return symbol->address >= VRAM_START_ADDRESS && symbol->address < SRAM_START_ADDRESS;
+	return symbol != nullptr && getRegion(*symbol) == Region::VRAM;
 }
 
 // Returns if symbol by name is within sram
-bool SymbolDatabase::isSRAM(const std::string& name) const {
-	// SRAM is from 0xA000 to 0xBFFF
+bool SymbolDatabase::isSRAM(std::string_view name) const {
 	const Symbol* symbol = getSymbol(name);
-	if (symbol == nullptr) {
-		return false;
-	}
-	return symbol->address >= SRAM_START_ADDRESS && symbol->address < WRAM0_START_ADDRESS;
+	return symbol != nullptr && getRegion(*symbol) == Region::SRAM;
 }
 
 // Returns if symbol by name is within wram
-bool SymbolDatabase::isWRAM(const std::string& name) const {
-	// WRAM is from 0xC000 to 0xDFFF
+bool SymbolDatabase::isWRAM(std::string_view name) const {
 	const Symbol* symbol = getSymbol(name);
-	if (symbol == nullptr) {
-		return false;
-	}
-	return symbol->address >= WRAM0_START_ADDRESS && symbol->address < ECHO_WRAM_START_ADDRESS;
+	return symbol != nullptr && getRegion(*symbol) == Region::WRAM;
 }
 
 // Returns if symbol by name is within hram
-bool SymbolDatabase::isHRAM(const std::string& name) const {
-	// HRAM is from 0xFF80 to 0xFFFF
+bool SymbolDatabase::isHRAM(std::string_view name) const {
 	const Symbol* symbol = getSymbol(name);
-	if (symbol == nullptr) {
-		return false;
-	}
-	return symbol->address >= HRAM_START_ADDRESS;
+	return symbol != nullptr && getRegion(*symbol) == Region::HRAM;
 }
 
-// Returns abosolute sram address (up to 2MiB) of symbol by name
-uint32_t SymbolDatabase::getSRAMAddress(const std::string& name) const {
-	// check is symbol is in SRAM
-	if (!isSRAM(name)) {
-		return 0;
+// wram and sram base symbols of each save block, in SaveBlock order
+static const char* const SAVE_BLOCK_WRAM_BASES[SymbolDatabase::NUM_SAVE_BLOCKS] = {"wOptions", "wPlayerData", "wCurMapData", "wPokemonData"};
+static const char* const SAVE_BLOCK_SRAM_BASES[SymbolDatabase::NUM_SAVE_BLOCKS] = {"sOptions", "sPlayerData", "sMapData", "sPokemonData"};
+// end of the wram data saved to each block
+static const char* const SAVE_BLOCK_WRAM_ENDS[SymbolDatabase::NUM_SAVE_BLOCKS] = {"wOptionsEnd", "wPlayerDataEnd", "wCurMapDataEnd", "wPokemonDataEnd"};
+
+// resolve the base addresses of the save blocks
+void SymbolDatabase::resolveSaveBlocks() {
+	for (int i = 0; i < NUM_SAVE_BLOCKS; i++) {
+		const Symbol* wramBase = findSymbol(SAVE_BLOCK_WRAM_BASES[i]);
+		const Symbol* sramBase = findSymbol(SAVE_BLOCK_SRAM_BASES[i]);
+		m_saveBlocks[i].valid = wramBase != nullptr && sramBase != nullptr && getRegion(*sramBase) == Region::SRAM;
+		m_saveBlocks[i].wramAddress = wramBase != nullptr ? wramBase->address : 0;
+		m_saveBlocks[i].sramAddress = m_saveBlocks[i].valid ? sramBase->bank * SRAM_BANK_SIZE + sramBase->address - SRAM_START_ADDRESS : 0;
+		const Symbol* wramEnd = findSymbol(SAVE_BLOCK_WRAM_ENDS[i]);
+		bool hasEnd = m_saveBlocks[i].valid && wramEnd != nullptr && wramEnd->address > m_saveBlocks[i].wramAddress;
+		m_saveBlocks[i].size = hasEnd ? wramEnd->address - m_saveBlocks[i].wramAddress : 0;
 	}
-	// absolute address is bank * 0x2000 + address - 0xA000
-	const Symbol* symbol = getSymbol(name);
-	return symbol->bank * SRAM_BANK_SIZE + symbol->address - SRAM_START_ADDRESS;
 }
 
-// Returns the the distance of the wram symbol from wOptions and adds it to the address of sOptions
-uint32_t SymbolDatabase::getOptionsAddress(const std::string& wram_symbol_name) const {
-	// check if symbol is in WRAM
-	if (!isWRAM(wram_symbol_name)) {
-		js_error <<  "Symbol " << wram_symbol_name << " is not in WRAM" << std::endl;
-		return 0;
+// build the reverse index from the records and the save blocks
+void SymbolDatabase::buildReverseIndex() const {
+	m_sramIndex.clear();
+	m_mirrorIndex.clear();
+	for (uint32_t nameId = 0; nameId < m_nameCount; nameId++) {
+		const Symbol* symbol = getDefined(nameId);
+		if (symbol == nullptr) {
+			continue;
+		}
+		Region region = getRegion(*symbol);
+		if (region == Region::SRAM) {
+			m_sramIndex.push_back({findSRAM(symbol).value, nameId});
+			continue;
+		}
+		if (region != Region::WRAM) {
+			continue;
+		}
+		// a wram symbol is saved to at most one save block
+		for (const SaveBlockBase& base : m_saveBlocks) {
+			if (base.size != 0 && symbol->address >= base.wramAddress && symbol->address < base.wramAddress + base.size) {
+				m_mirrorIndex.push_back({base.sramAddress + symbol->address - base.wramAddress, nameId});
+				break;
+			}
+		}
 	}
-	// we need to find the equivalent SRAM address of the WRAM symbol
-	// this is done by adding the distance between the wram symbol and wOptions to sOptions
+	// several symbols may share an address (e.g. wPlayerDataEnd and wCurMapData). The last one
+	// at an address is found first, so order the end markers before the symbols starting there.
+	auto isEnd = [this](const IndexEntry& entry) {
+		std::string_view name = getName(m_records[entry.nameId]);
+		return name.size() >= 3 && name.compare(name.size() - 3, 3, "End") == 0;
+	};
+	auto byAddress = [&isEnd](const IndexEntry& a, const IndexEntry& b) {
+		if (a.address != b.address) {
+			return a.address < b.address;
+		}
+		bool aEnd = isEnd(a);
+		bool bEnd = isEnd(b);
+		return aEnd != bEnd ? aEnd : a.nameId < b.nameId;
+	};
+	std::sort(m_sramIndex.begin(), m_sramIndex.end(), byAddress);
+	std::sort(m_mirrorIndex.begin(), m_mirrorIndex.end(), byAddress);
+}
 
-	// get the address of the wOptions symbol
-	const Symbol* wOptions = getSymbol("wOptions");
-	if (wOptions == nullptr) {
-		return 0;
+// resolve an sram symbol to its absolute sram address with a single lookup
+SymbolDatabase::Address SymbolDatabase::resolveSRAM(std::string_view name) const {
+	Address address = findSRAM(name);
+	if (!address && findSymbol(name) == nullptr) {
+		js_error << "Symbol " << name << " not found" << std::endl;
 	}
-	// calculate the distance between wram_symbol and wOptions error if result is negative
-	const Symbol* wram_symbol = getSymbol(wram_symbol_name);
-	if (wram_symbol == nullptr) {
-		return 0;
+	return address;
+}
+
+// resolve a wram symbol to its address in the sram block it is saved to with a single lookup
+SymbolDatabase::Address SymbolDatabase::resolveWRAM(std::string_view wram_symbol_name, SaveBlock block) const {
+	Address address = findWRAM(wram_symbol_name, block);
+	if (address) {
+		return address;
 	}
-	int32_t distance = wram_symbol->address - wOptions->address;
-	if (distance < 0) {
-		js_error <<  "Symbol " << wram_symbol_name << " is before wOptions" << std::endl;
-		return 0;
+	// report why the symbol couldn't be resolved
+	int index = static_cast<int>(block);
+	if (address.region != Region::WRAM) {
+		if (findSymbol(wram_symbol_name) == nullptr) {
+			js_error << "Symbol " << wram_symbol_name << " not found" << std::endl;
+		}
+		js_error <<  "Symbol " << wram_symbol_name << " is not in WRAM" << std::endl;
+	} else if (!m_saveBlocks[index].valid) {
+		js_error <<  "Symbol " << SAVE_BLOCK_WRAM_BASES[index] << " or " << SAVE_BLOCK_SRAM_BASES[index] << " not found" << std::endl;
+	} else {
+		js_error <<  "Symbol " << wram_symbol_name << " is before " << SAVE_BLOCK_WRAM_BASES[index] << std::endl;
 	}
+	return address;
+}
 
-	// calculate the absolute address of the options
-	return getSRAMAddress("sOptions") + distance;
+// same as resolveSRAM without reporting failures
+SymbolDatabase::Address SymbolDatabase::findSRAM(std::string_view name) const {
+	return findSRAM(findSymbol(name));
 }
 
-// Returns the the distance of the wram symbol from wPlayerData and adds it to the address of sPlayerData
-uint32_t SymbolDatabase::getPlayerDataAddress(const std::string& wram_symbol_name) const {
-	// check if symbol is in WRAM
-	if (!isWRAM(wram_symbol_name)) {
-		js_error <<  "Symbol " << wram_symbol_name << " is not in WRAM" << std::endl;
-		return 0;
-	}
-	// we need to find the equivalent SRAM address of the WRAM symbol
-	// this is done by adding the distance between the wram symbol and wPlayerData to sPlayerData
+// same as resolveWRAM without reporting failures
+SymbolDatabase::Address SymbolDatabase::findWRAM(std::string_view wram_symbol_name, SaveBlock block) const {
+	return findWRAM(findSymbol(wram_symbol_name), block);
+}
 
-	// get the address of the wPlayerData symbol
-	const Symbol* wPlayerData = getSymbol("wPlayerData");
-	if (wPlayerData == nullptr) {
-		return 0;
-	}
-	// calculate the distance between wram_symbol and wPlayerData error if result is negative
-	const Symbol* wram_symbol = getSymbol(wram_symbol_name);
-	if (wram_symbol == nullptr) {
-		return 0;
+// resolve an already found sram symbol (may be nullptr) without reporting failures
+SymbolDatabase::Address SymbolDatabase::findSRAM(const Symbol* symbol) const {
+	if (symbol == nullptr) {
+		return {0, Region::OTHER, false};
 	}
-	int32_t distance = wram_symbol->address - wPlayerData->address;
-	if (distance < 0) {
-		js_error <<  "Symbol " << wram_symbol_name << " is before wPlayerData" << std::endl;
-		return 0;
+	Region region = getRegion(*symbol);
+	if (region != Region::SRAM) {
+		return {0, region, false};
 	}
-
-	// calculate the absolute address of the player data
-	return getSRAMAddress("sPlayerData") + distance;
+	// absolute address is bank * 0x2000 + address - 0xA000
+	return {static_cast<uint32_t>(symbol->bank * SRAM_BANK_SIZE + symbol->address - SRAM_START_ADDRESS), region, true};
 }
 
-// Returns the the distance of the wram symbol from wMapData and adds it to the address of sMapData
-uint32_t SymbolDatabase::getMapDataAddress(const std::string& wram_symbol_name) const {
+// resolve an already found wram symbol (may be nullptr) without reporting failures
+SymbolDatabase::Address SymbolDatabase::findWRAM(const Symbol* symbol, SaveBlock block) const {
 	// check if symbol is in WRAM
-	if (!isWRAM(wram_symbol_name)) {
-		js_error <<  "Symbol " << wram_symbol_name << " is not in WRAM" << std::endl;
-		return 0;
+	Region region = symbol != nullptr ? getRegion(*symbol) : Region::OTHER;
+	if (region != Region::WRAM) {
+		return {0, region, false};
 	}
 	// we need to find the equivalent SRAM address of the WRAM symbol
-	// this is done by adding the distance between the wram symbol and wCurMapData to sMapData
-
-	// get the address of the wMapData symbol
-	const Symbol* wMapData = getSymbol("wCurMapData");
-	if (wMapData == nullptr) {
-		js_error <<  "Symbol wCurMapData not found" << std::endl;
-		return 0;
-	}
-	// calculate the distance between wram_symbol and wMapData error if result is negative
-	const Symbol* wram_symbol = getSymbol(wram_symbol_name);
-	if (wram_symbol == nullptr) {
-		return 0;
-	}
-	int32_t distance = wram_symbol->address - wMapData->address;
-	if (distance < 0) {
-		js_error <<  "Symbol " << wram_symbol_name << " is before wCurMapData" << std::endl;
-		return 0;
+	// this is done by adding the distance between the wram symbol and the wram base of the
+	// block to the sram base of the block
+	const SaveBlockBase& base = m_saveBlocks[static_cast<int>(block)];
+	int32_t distance = symbol->address - base.wramAddress;
+	if (!base.valid || distance < 0) {
+		return {0, region, false};
 	}
+	return {base.sramAddress + distance, region, true};
+}
+
+// Returns abosolute sram address (up to 2MiB) of symbol by name
+uint32_t SymbolDatabase::getSRAMAddress(std::string_view name) const {
+	return resolveSRAM(name).value;
+}
+
+// Returns the the distance of the wram symbol from wOptions and adds it to the address of sOptions
+uint32_t SymbolDatabase::getOptionsAddress(std::string_view wram_symbol_name) const {
+	return resolveWRAM(wram_symbol_name, SaveBlock::OPTIONS).value;
+}
+
+// Returns the the distance of the wram symbol from wPlayerData and adds it to the address of sPlayerData
+uint32_t SymbolDatabase::getPlayerDataAddress(std::string_view wram_symbol_name) const {
+	return resolveWRAM(wram_symbol_name, SaveBlock::PLAYER_DATA).value;
+}
 
-	// calculate the absolute address of the map data
-	return getSRAMAddress("sMapData") + distance;
+// Returns the the distance of the wram symbol from wCurMapData and adds it to the address of sMapData
+uint32_t SymbolDatabase::getMapDataAddress(std::string_view wram_symbol_name) const {
+	return resolveWRAM(wram_symbol_name, SaveBlock::MAP_DATA).value;
 }
 
 // Returns the the distance of the wram symbol from wPokemonData and adds it to the address of sPokemonData
-uint32_t SymbolDatabase::getPokemonDataAddress(const std::string& wram_symbol_name) const {
-	// check if symbol is in WRAM
-	if (!isWRAM(wram_symbol_name)) {
-		js_error <<  "Symbol " << wram_symbol_name << " is not in WRAM" << std::endl;
-		return 0;
-	}
-	// we need to find the equivalent SRAM address of the WRAM symbol
-	// this is done by adding the distance between the wram symbol and wPokemonData to sPokemonData
+uint32_t SymbolDatabase::getPokemonDataAddress(std::string_view wram_symbol_name) const {
+	return resolveWRAM(wram_symbol_name, SaveBlock::POKEMON_DATA).value;
+}
 
-	// get the address of the wPokemonData symbol
-	const Symbol* wPokemonData = getSymbol("wPokemonData");
-	if (wPokemonData == nullptr) {
-		return 0;
-	}
-	// calculate the distance between wram_symbol and wPokemonData error if result is negative
-	const Symbol* wram_symbol = getSymbol(wram_symbol_name);
-	if (wram_symbol == nullptr) {
-		return 0;
+// locate an absolute save address within the closest symbol at or before it
+SymbolDatabase::Location SymbolDatabase::locate(uint32_t address) const {
+	std::call_once(m_indexBuilt, [this] { buildReverseIndex(); });
+	auto upper = [address](const std::vector<IndexEntry>& index) {
+		return std::upper_bound(index.begin(), index.end(), address, [](uint32_t key, const IndexEntry& entry) {
+			return key < entry.address;
+		});
+	};
+	// within a save block, the wram symbols saved there are more precise than the block's sram symbol
+	for (const SaveBlockBase& base : m_saveBlocks) {
+		if (base.size != 0 && address >= base.sramAddress && address < base.sramAddress + base.size) {
+			auto it = upper(m_mirrorIndex);
+			if (it != m_mirrorIndex.begin() && (--it)->address >= base.sramAddress) {
+				return {m_records + it->nameId, address - it->address};
+			}
+			break;
+		}
 	}
-	int32_t distance = wram_symbol->address - wPokemonData->address;
-	if (distance < 0) {
-		js_error <<  "Symbol " << wram_symbol_name << " is before wPokemonData" << std::endl;
-		return 0;
+	auto it = upper(m_sramIndex);
+	if (it == m_sramIndex.begin()) {
+		return {nullptr, 0};
 	}
+	--it;
+	return {m_records + it->nameId, address - it->address};
+}
 
-	// calculate the absolute address of the pokemon data
-	return getSRAMAddress("sPokemonData") + distance;
+// describe an absolute save address as symbol+offset, or only in hex if it isn't within a symbol
+std::string SymbolDatabase::describe(uint32_t address) const {
+	static const char HEX_DIGITS[] = "0123456789abcdef";
+	auto hex = [](uint32_t value) {
+		std::string digits;
+		do {
+			digits.insert(digits.begin(), HEX_DIGITS[value & 0xF]);
+			value >>= 4;
+		} while (value != 0);
+		return "0x" + digits;
+	};
+	Location location = locate(address);
+	if (!location) {
+		return hex(address);
+	}
+	std::string description(getName(*location.symbol));
+	if (location.offset != 0) {
+		description += '+';
+		description += hex(location.offset);
+	}
+	return description;
 }
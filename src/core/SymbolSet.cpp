@@ -0,0 +1,114 @@
+#include "core/SymbolSet.h"
+#include "core/Logging.h"
+#include <utility>
+
+// an sram symbol
+SymbolSet::Entry::Entry(std::string name) : name(std::move(name)), wram(false), block(SymbolDatabase::SaveBlock::OPTIONS), first(-1), count(1), index(0) {}
+
+// a wram symbol saved to block
+SymbolSet::Entry::Entry(std::string name, SymbolDatabase::SaveBlock block) : name(std::move(name)), wram(true), block(block), first(-1), count(1), index(0) {}
+
+// expand a family pattern to the name of its member number
+static std::string family_member_name(const std::string& pattern, int number) {
+	std::string name = pattern;
+	size_t hash = name.find('#');
+	if (hash != std::string::npos) {
+		name.replace(hash, 1, std::to_string(number));
+	}
+	return name;
+}
+
+// Constructor
+SymbolSet::SymbolSet(const SymbolDatabase& sym) : m_sym(sym), m_size(0), m_resolved(false) {}
+
+// Constructor with the entries to resolve
+SymbolSet::SymbolSet(const SymbolDatabase& sym, std::initializer_list<Entry> entries) : m_sym(sym), m_size(0), m_resolved(false) {
+	for (const Entry& entry : entries) {
+		add(entry, entry.first, entry.count);
+	}
+}
+
+// add an entry, returns the index of its first address
+size_t SymbolSet::add(Entry entry, int first, int count) {
+	entry.first = first;
+	entry.count = count;
+	entry.index = m_size;
+	m_entries.push_back(std::move(entry));
+	m_size += count;
+	m_resolved = false;
+	return m_entries.back().index;
+}
+
+// add an sram symbol, returns its index
+size_t SymbolSet::addSRAM(std::string name) {
+	return add(Entry(std::move(name)), -1, 1);
+}
+
+// add a wram symbol saved to block, returns its index
+size_t SymbolSet::addWRAM(std::string name, SymbolDatabase::SaveBlock block) {
+	return add(Entry(std::move(name), block), -1, 1);
+}
+
+// add the members first to last of an sram family, returns the index of first
+size_t SymbolSet::addSRAMFamily(std::string pattern, int first, int last) {
+	return add(Entry(std::move(pattern)), first, last - first + 1);
+}
+
+// add the members first to last of a wram family saved to block, returns the index of first
+size_t SymbolSet::addWRAMFamily(std::string pattern, int first, int last, SymbolDatabase::SaveBlock block) {
+	return add(Entry(std::move(pattern), block), first, last - first + 1);
+}
+
+// resolve every entry, reporting all the unresolved names at once
+bool SymbolSet::resolve() {
+	m_addresses.assign(m_size, 0);
+	std::string missing;
+	for (const Entry& entry : m_entries) {
+		// a family is looked up once, then each member by number
+		const SymbolDatabase::Family* family = entry.first >= 0 ? m_sym.findFamily(entry.name) : nullptr;
+		for (int i = 0; i < entry.count; i++) {
+			const SymbolDatabase::Symbol* symbol;
+			if (entry.first < 0) {
+				symbol = m_sym.findSymbol(entry.name);
+			} else {
+				symbol = family != nullptr ? m_sym.getMember(*family, entry.first + i) : nullptr;
+			}
+			SymbolDatabase::Address address = entry.wram ? m_sym.findWRAM(symbol, entry.block) : m_sym.findSRAM(symbol);
+			if (address) {
+				m_addresses[entry.index + i] = address.value;
+				continue;
+			}
+			if (!missing.empty()) {
+				missing += ", ";
+			}
+			missing += entry.first < 0 ? entry.name : family_member_name(entry.name, entry.first + i);
+			if (symbol == nullptr) {
+				missing += " (not found)";
+			} else if (address.region != (entry.wram ? SymbolDatabase::Region::WRAM : SymbolDatabase::Region::SRAM)) {
+				missing += entry.wram ? " (not in WRAM)" : " (not in SRAM)";
+			} else {
+				missing += " (outside its save block)";
+			}
+		}
+	}
+	m_resolved = missing.empty();
+	if (!m_resolved) {
+		js_error << "Unresolved symbols: " << missing << std::endl;
+	}
+	return m_resolved;
+}
+
+// Returns if every entry was resolved
+bool SymbolSet::isResolved() const {
+	return m_resolved;
+}
+
+// Get the name of the symbol at index
+std::string SymbolSet::getName(size_t index) const {
+	for (const Entry& entry : m_entries) {
+		if (index >= entry.index && index < entry.index + entry.count) {
+			return entry.first < 0 ? entry.name : family_member_name(entry.name, entry.first + static_cast<int>(index - entry.index));
+		}
+	}
+	return std::string();
+}
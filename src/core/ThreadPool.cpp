@@ -0,0 +1,202 @@
+#include "core/ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+static std::atomic<unsigned> s_workerCount(1);
+
+#ifdef PATCHER_THREADS
+// the pool the helpers of parallelFor run on, started on first use and replaced when the worker
+// count changes. Callers hold on to the pool they got until their jobs are done.
+static std::mutex s_sharedPoolMutex;
+static std::shared_ptr<ThreadPool> s_sharedPool;
+
+// get the shared pool with threads workers
+static std::shared_ptr<ThreadPool> getSharedPool(unsigned threads) {
+	std::lock_guard<std::mutex> lock(s_sharedPoolMutex);
+	if (s_sharedPool == nullptr || s_sharedPool->getThreadCount() != threads) {
+		s_sharedPool = std::make_shared<ThreadPool>(threads);
+	}
+	return s_sharedPool;
+}
+#endif
+
+// get the number of threads parallelFor spreads jobs over
+unsigned getWorkerCount() {
+	return s_workerCount.load();
+}
+
+// set the number of threads parallelFor spreads jobs over, 0 uses one per hardware thread
+void setWorkerCount(unsigned count) {
+#ifdef PATCHER_THREADS
+	if (count == 0) {
+		count = std::max(1u, std::thread::hardware_concurrency());
+	}
+	s_workerCount.store(count);
+#else
+	(void)count;
+#endif
+}
+
+// run job(0) to job(count - 1) on the worker threads
+void parallelFor(size_t count, const std::function<void(size_t)>& job) {
+	size_t workers = std::min<size_t>(getWorkerCount(), count);
+	if (workers <= 1) {
+		for (size_t i = 0; i < count; i++) {
+			job(i);
+		}
+		return;
+	}
+
+#ifdef PATCHER_THREADS
+	// the calling thread and workers - 1 helpers on the shared pool each take the next job until
+	// none are left. The pool's threads are kept between calls, only the helpers are queued.
+	std::shared_ptr<ThreadPool> pool = getSharedPool(getWorkerCount() - 1);
+	std::atomic<size_t> next(0);
+	auto work = [&next, count, &job]() {
+		for (size_t i = next++; i < count; i = next++) {
+			job(i);
+		}
+	};
+	std::mutex mutex;
+	std::condition_variable done;
+	size_t helping = workers - 1;
+	for (size_t i = 1; i < workers; i++) {
+		pool->submit([&work, &mutex, &done, &helping]() {
+			work();
+			std::lock_guard<std::mutex> lock(mutex);
+			if (--helping == 0) {
+				done.notify_one();
+			}
+		});
+	}
+	work();
+	// the helpers use this frame, so wait for the ones that found no job left too
+	std::unique_lock<std::mutex> lock(mutex);
+	done.wait(lock, [&helping] { return helping == 0; });
+#endif
+}
+
+#ifdef PATCHER_THREADS
+// start threads workers, 0 for one per hardware thread
+ThreadPool::ThreadPool(unsigned threads) {
+	if (threads == 0) {
+		threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	for (unsigned i = 0; i < threads; i++) {
+		m_queues.push_back(std::make_unique<Queue>());
+	}
+	for (unsigned i = 0; i < threads; i++) {
+		m_threads.emplace_back(&ThreadPool::work, this, i);
+	}
+}
+
+// finish the submitted jobs and stop the workers
+ThreadPool::~ThreadPool() {
+	wait();
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_wake.notify_all();
+	for (std::thread& thread : m_threads) {
+		thread.join();
+	}
+}
+
+// queue job, the workers' queues take turns
+void ThreadPool::submit(std::function<void()> job) {
+	// count the job first, so it's never taken before it is counted
+	size_t worker;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		worker = m_next;
+		m_next = (m_next + 1) % m_queues.size();
+		m_queued++;
+		m_pending++;
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_queues[worker]->mutex);
+		m_queues[worker]->jobs.push_back(std::move(job));
+	}
+	m_wake.notify_one();
+}
+
+// wait until every submitted job is done
+void ThreadPool::wait() {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_done.wait(lock, [this] { return m_pending == 0; });
+}
+
+// get the number of worker threads
+unsigned ThreadPool::getThreadCount() const {
+	return static_cast<unsigned>(m_threads.size());
+}
+
+// take the newest job of the worker's queue, or else steal the oldest job of another queue
+bool ThreadPool::takeJob(size_t worker, std::function<void()>& job) {
+	{
+		Queue& own = *m_queues[worker];
+		std::lock_guard<std::mutex> lock(own.mutex);
+		if (!own.jobs.empty()) {
+			job = std::move(own.jobs.back());
+			own.jobs.pop_back();
+			return true;
+		}
+	}
+	for (size_t i = 1; i < m_queues.size(); i++) {
+		Queue& other = *m_queues[(worker + i) % m_queues.size()];
+		std::lock_guard<std::mutex> lock(other.mutex);
+		if (!other.jobs.empty()) {
+			job = std::move(other.jobs.front());
+			other.jobs.pop_front();
+			return true;
+		}
+	}
+	return false;
+}
+
+// run jobs until the pool stops
+void ThreadPool::work(size_t worker) {
+	for (;;) {
+		std::function<void()> job;
+		if (takeJob(worker, job)) {
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_queued--;
+			}
+			job();
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (--m_pending == 0) {
+				m_done.notify_all();
+			}
+			continue;
+		}
+		// sleep until a job is queued, a job taken meanwhile just means another look
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_wake.wait(lock, [this] { return m_stopping || m_queued > 0; });
+		if (m_stopping && m_queued == 0) {
+			return;
+		}
+	}
+}
+#else
+ThreadPool::ThreadPool(unsigned threads) {
+	(void)threads;
+}
+
+ThreadPool::~ThreadPool() {
+}
+
+// run job on the calling thread
+void ThreadPool::submit(std::function<void()> job) {
+	job();
+}
+
+void ThreadPool::wait() {
+}
+
+unsigned ThreadPool::getThreadCount() const {
+	return 1;
+}
+#endif
@@ -1,144 +1,269 @@
 #include "core/SaveBinary.h"
-#include "patching/PatchVersion7to8.h"
-#include "patching/PatchVersion8to9.h"
-#include "patching/PatchVersion9to10.h"
-#include "patching/FixVersion8NoForm.h"
-#include "patching/FixVersion9RegisteredKeyItems.h"
-#include "patching/FixVersion9PCWarpID.h"
-#include "patching/FixVersion9PGOBattleEvent.h"
-#include "patching/FixVersion9RoamMap.h"
-#include "patching/FixVersion9MagikarpPlainForm.h"
+#include "patching/PatchPlanner.h"
 #include "core/PatcherConstants.h"
 #include "core/Logging.h"
+#include "core/SymbolDatabase.h"
+#include "core/ThreadPool.h"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <cstdlib>
 #include <cstring>
+#include <vector>
+#include <utility>
 #ifndef CLI_VERSION
 #include <emscripten/bind.h>
+#else
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
 #endif
 
-bool patch_save(const std::string &old_save_path, const std::string &new_save_path, int target_version, int dev_type = 0) {
+// patch oldSave into newSave (which starts as a copy of oldSave), the core used by
+// both the file and buffer based entry points. oldSave is used as scratch space by
+// the version chain and doesn't keep its contents. If patching fails both saves are left
+// half patched; every caller still has the unpatched save (the file or the input buffer)
+// and just drops them.
+bool patch_save(SaveBinary &oldSave, SaveBinary &newSave, int target_version, int dev_type = 0) {
 	bool success = true;
 
-	// Load the old save file
-	SaveBinary oldSave(old_save_path);
-	// copy the old save file to the new save file
-	SaveBinary newSave = oldSave;
-	// load the save version big endian word
+#ifdef SAVEBINARY_UNCHECKED_ACCESS
+	// accesses aren't checked in this build. Every SRAM symbol lies below MIN_SAVE_SIZE, so
+	// validating the size once up front covers the whole patch.
+	if (!oldSave.validateRange(0, MIN_SAVE_SIZE) || !newSave.validateRange(0, MIN_SAVE_SIZE)) {
+		return false;
+	}
+#endif
 
+	// load the save version big endian word
+	uint16_t saveVersion = oldSave.getWordBE(SAVE_VERSION_ABS_ADDRESS);
 	if (dev_type == 0) {
-		uint16_t saveVersion = oldSave.getWordBE(SAVE_VERSION_ABS_ADDRESS);
-		if (saveVersion != 0x07 && saveVersion != 0x08 && saveVersion != 0x09) {
+		if (!isPatchableVersion(saveVersion)) {
 			js_error << "Unsupported save version: " << std::hex << saveVersion << std::endl;
 			success = false;
 		}
 		else {
-			if (saveVersion == 0x07 && target_version >= 8) {
-				if (!patchVersion7to8Namespace::patchVersion7to8(oldSave, newSave)) {
-					js_error << "Failed to patch save file from version 7 to 8." << std::endl;
-					success = false;
-				}
-				else {
-					js_info << "Patched save file from version 7 to 8." << std::endl;
-					saveVersion = 0x08; // Update the save version to 8
-					oldSave = newSave; // Update the old save to the new save
-				}
-			}
-			if (saveVersion == 0x08 && target_version >= 9) {
-				if (!patchVersion8to9Namespace::patchVersion8to9(oldSave, newSave)) {
-					js_error << "Failed to patch save file from version 8 to 9." << std::endl;
-					success = false;
-				}
-				else {
-					js_info << "Patched save file from version 8 to 9." << std::endl;
-					saveVersion = 0x09; // Update the save version to 9
-					oldSave = newSave; // Update the old save to the new save
-				}
-			}
-			if (saveVersion == 0x09 && target_version >= 10) {
-				if (!patchVersion9to10Namespace::patchVersion9to10(oldSave, newSave)) {
-					js_error << "Failed to patch save file from version 9 to 10." << std::endl;
-					success = false;
-				}
-				else {
-					js_info << "Patched save file from version 9 to 10." << std::endl;
-				}
-			}
+			// upgrade as far as the target allows
+			uint16_t targetVersion = static_cast<uint16_t>(std::max(0, std::min<int>(target_version, getLatestSaveVersion())));
+			success = runPatchPlan(getPatchPlan(saveVersion, targetVersion, 0), oldSave, newSave);
 		}
 	} else {
 		js_info << "Running a special one-off patch (dev_type=" << dev_type << ")..." << std::endl;
-		switch (dev_type) {
-		case 1:
-			if (!fixVersion8NoFormNamespace::fixVersion8NoForm(oldSave, newSave)) {
-				js_error << "fixVersion9NoForm failed." << std::endl;
-				success = false;
-			}
-			break;
-		case 2:
-			if (!fixVersion9RegisteredKeyItemsNamespace::fixVersion9RegisteredKeyItems(oldSave, newSave)) {
-				js_error << "fixVersion9RegisteredKeyItems failed." << std::endl;
-				success = false;
-			}
-			break;
-		case 3:
-			if (!fixVersion9PCWarpIDNamespace::fixVersion9PCWarpID(oldSave, newSave)) {
-				js_error << "fixVersion9PCWarpID failed." << std::endl;
-				success = false;
-			}
-			break;
-		case 4:
-			if (!fixVersion9PGOBattleEventNamespace::fixVersion9PGOBattleEvent(oldSave, newSave)) {
-				js_error << "fixVersion9PGOBattleEvent failed." << std::endl;
-				success = false;
-			}
-			break;
-		case 5:
-			if (!fixVersion9RoamMapNamespace::fixVersion9RoamMap(oldSave, newSave)) {
-				js_error << "fixVersion9RoamMap failed." << std::endl;
-				success = false;
-			}
-			break;
-		case 6:
-			if (!fixVersion9MagikarpPlainFormNamespace::fixVersion9MagikarpPlainForm(oldSave, newSave)) {
-				js_error << "fixVersion9MagikarpPlainForm failed." << std::endl;
-				success = false;
-			}
-			break;
-		default:
+		// a dev fix keeps the save version
+		if (!isDevFix(dev_type)) {
 			js_error << "Unknown dev_type: " << dev_type << std::endl;
 			success = false;
-			break;
+		}
+		else {
+			success = runPatchPlan(getPatchPlan(saveVersion, saveVersion, 1u << dev_type), oldSave, newSave);
 		}
 	}
+
+	return success;
+}
+
+// what patching a save file reports besides success
+struct PatchFileStats {
+	// the version of the save file before patching, 0 if it couldn't be read
+	uint16_t sourceVersion = 0;
+	// time spent patching, not counting reading and writing the files
+	double patchMilliseconds = 0.0;
+};
+
+// patch the save file at old_save_path and write the result to new_save_path
+bool patch_save(const std::string &old_save_path, const std::string &new_save_path, int target_version, int dev_type = 0, PatchFileStats *stats = nullptr) {
+#ifdef SAVEBINARY_USE_MMAP
+	// map the old save file copy-on-write twice, once for each buffer of the patch chain,
+	// so only the pages the patch touches get copied
+	SaveBinary oldSave(old_save_path, SaveBinary::MapMode::PRIVATE);
+	SaveBinary newSave(old_save_path, SaveBinary::MapMode::PRIVATE);
+#else
+	// Load the old save file
+	SaveBinary oldSave(old_save_path);
+	// copy the old save file to the new save file
+	SaveBinary newSave(oldSave);
+#endif
+	// oldSave is scratch space once patching starts, so read the version first
+	if (stats != nullptr && oldSave.getSize() >= MIN_SAVE_SIZE) {
+		stats->sourceVersion = oldSave.getWordBE(SAVE_VERSION_ABS_ADDRESS);
+	}
+	auto start = std::chrono::steady_clock::now();
+	bool success = patch_save(oldSave, newSave, target_version, dev_type);
+	if (stats != nullptr) {
+		stats->patchMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
 	if (success) {
 		js_info << "Saving file..." << std::endl;
-		newSave.save(new_save_path);
+		if (!newSave.save(new_save_path)) {
+			return false;
+		}
 		js_info << "File saved successfully!" << std::endl;
 	}
 	return success;
 }
 
+// patch an in-memory save and move the patched bytes into new_save_data
+bool patch_save(const uint8_t *old_save_data, size_t old_save_len, std::vector<uint8_t> &new_save_data, int target_version, int dev_type = 0) {
+	SaveBinary oldSave(old_save_data, old_save_len);
+	SaveBinary newSave(oldSave);
+	bool success = patch_save(oldSave, newSave, target_version, dev_type);
+	if (success) {
+		new_save_data = newSave.releaseData();
+	}
+	return success;
+}
+
 #ifndef CLI_VERSION
-emscripten::val patch_save_js(const std::string &old_save_path, const std::string &new_save_path, int target_version, int dev_type = 0) {
+// The last patched save. Kept alive so JavaScript can read it through a typed_memory_view
+// without another copy; it stays valid until the next call to patch_save_js.
+static std::vector<uint8_t> s_patched_save;
+
+emscripten::val patch_save_js(const emscripten::val &old_save_data, int target_version, int dev_type = 0) {
 	// Result object to return to JavaScript
 	emscripten::val result = emscripten::val::object();
-	bool success = patch_save(old_save_path, new_save_path, target_version, dev_type);
+	// copy the Uint8Array into the wasm heap once and hand the buffer to SaveBinary
+	SaveBinary oldSave(emscripten::convertJSArrayToNumberVector<uint8_t>(old_save_data));
+	SaveBinary newSave(oldSave);
+	bool success = patch_save(oldSave, newSave, target_version, dev_type);
+	if (success) {
+		s_patched_save = newSave.releaseData();
+		result.set("data", emscripten::val(emscripten::typed_memory_view(s_patched_save.size(), s_patched_save.data())));
+	}
 	result.set("success", success);
 	return result;
 }
 #endif
 
 uint16_t get_save_version(const std::string &old_save_path) {
+#ifdef SAVEBINARY_USE_MMAP
+	SaveBinary oldSave(old_save_path, SaveBinary::MapMode::READ_ONLY);
+#else
 	SaveBinary oldSave(old_save_path);
+#endif
 	return oldSave.getWordBE(SAVE_VERSION_ABS_ADDRESS);
 }
 
 #ifndef CLI_VERSION
+uint16_t get_save_version_js(const emscripten::val &old_save_data) {
+	// only the two version bytes are needed, so read them without copying the whole save
+	if (old_save_data["length"].as<uint32_t>() < MIN_SAVE_SIZE) {
+		js_error << "Save file size is too small. Expected minimum size: " << MIN_SAVE_SIZE << std::endl;
+		return 0;
+	}
+	return (old_save_data[SAVE_VERSION_ABS_ADDRESS].as<uint16_t>() << 8) | old_save_data[SAVE_VERSION_ABS_ADDRESS + 1].as<uint16_t>();
+}
+
 EMSCRIPTEN_BINDINGS(patch_save_module) {
 	emscripten::function("patch_save_js",
-		(emscripten::val(*)(const std::string&, const std::string&, int, int)) & patch_save_js,
-		emscripten::allow_raw_pointers()
+		(emscripten::val(*)(const emscripten::val&, int, int)) & patch_save_js
 	);
-	emscripten::function("get_save_version", &get_save_version);
+	emscripten::function("get_save_version", &get_save_version_js);
+	// the number of threads patching the box mons, a no-op unless built with WEB_THREADS=1
+	emscripten::function("set_worker_count", &setWorkerCount);
+}
+#endif
+
+#ifdef CLI_VERSION
+// the result of patching one save in batch mode
+struct BatchResult {
+	bool success = false;
+	PatchFileStats stats;
+	// time spent on the save including reading and writing the files
+	double totalMilliseconds = 0.0;
+};
+
+// the summary batch mode writes to the output directory
+static const char BATCH_SUMMARY_NAME[] = "batch_summary.csv";
+
+// patch every file in in_dir to the latest version into out_dir, jobs saves at a time (0 for
+// one per CPU). Each save's log is kept in out_dir/<save>.log if it fails, and a line per save
+// (status, source version, timings) is written to out_dir/batch_summary.csv.
+static int patch_batch(const std::string &in_dir, const std::string &out_dir, unsigned jobs) {
+	namespace fs = std::filesystem;
+	std::error_code error;
+	fs::create_directories(out_dir, error);
+	if (error) {
+		js_error << "Failed to create directory " << out_dir << ": " << error.message() << std::endl;
+		return 1;
+	}
+	// writing into the input directory would replace the saves while they are read
+	if (fs::equivalent(in_dir, out_dir, error) || error) {
+		js_error << "The output directory " << out_dir << " must not be the input directory " << in_dir << (error ? ": " + error.message() : "") << std::endl;
+		return 1;
+	}
+
+	// every regular file is a save, except the summary and logs an earlier run left behind
+	std::vector<fs::path> saves;
+	for (const fs::directory_entry &entry : fs::directory_iterator(in_dir, error)) {
+		std::error_code typeError;
+		fs::path name = entry.path().filename();
+		if (entry.is_regular_file(typeError) && name != BATCH_SUMMARY_NAME && name.extension() != ".log") {
+			saves.push_back(entry.path());
+		}
+	}
+	if (error) {
+		js_error << "Failed to read directory " << in_dir << ": " << error.message() << std::endl;
+		return 1;
+	}
+	std::sort(saves.begin(), saves.end());
+
+	// every save shares the symbol databases and the cached patch plans
+	SymbolDatabase::warmup();
+	auto start = std::chrono::steady_clock::now();
+	std::vector<BatchResult> results(saves.size());
+	{
+		ThreadPool pool(jobs);
+		js_info << "Patching " << saves.size() << " saves on " << pool.getThreadCount() << " threads..." << std::endl;
+		for (size_t i = 0; i < saves.size(); i++) {
+			pool.submit([&saves, &results, &out_dir, i]() {
+				auto saveStart = std::chrono::steady_clock::now();
+				fs::path outPath = fs::path(out_dir) / saves[i].filename();
+				std::ostringstream log;
+				{
+					LogRedirect redirect(log);
+					// an exception escaping a worker would end the whole batch, count it as a failed save
+					try {
+						results[i].success = patch_save(saves[i].string(), outPath.string(), 10 /* current last version */, 0, &results[i].stats);
+					}
+					catch (const std::exception &exception) {
+						js_error << "Failed to patch " << saves[i].string() << ": " << exception.what() << std::endl;
+						results[i].success = false;
+					}
+					catch (...) {
+						js_error << "Failed to patch " << saves[i].string() << std::endl;
+						results[i].success = false;
+					}
+				}
+				if (!results[i].success) {
+					std::ofstream(outPath.string() + ".log") << log.str();
+				}
+				results[i].totalMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - saveStart).count();
+			});
+		}
+		pool.wait();
+	}
+	double totalMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	fs::path summaryPath = fs::path(out_dir) / BATCH_SUMMARY_NAME;
+	std::ofstream summary(summaryPath);
+	summary << "file,status,source_version,patch_ms,total_ms" << std::endl;
+	size_t patched = 0;
+	for (size_t i = 0; i < saves.size(); i++) {
+		const BatchResult &result = results[i];
+		summary << saves[i].filename().string() << "," << (result.success ? "ok" : "failed") << "," << result.stats.sourceVersion << ","
+			<< result.stats.patchMilliseconds << "," << result.totalMilliseconds << std::endl;
+		if (result.success) {
+			patched++;
+		}
+	}
+	summary.close();
+	if (summary.fail()) {
+		js_error << "Failed to write " << summaryPath.string() << std::endl;
+		return 1;
+	}
+	js_info << "Patched " << patched << " of " << saves.size() << " saves in " << totalMilliseconds << " ms, summary written to " << summaryPath.string() << std::endl;
+	return patched == saves.size() ? 0 : 1;
 }
 #endif
 
@@ -149,9 +274,14 @@ static int usage(char* a0) {
 	else *(p++) = 0;
 	js_info << "usage: ";
 	js_info << p;
-	js_info << " oldsave.sav newsave.sav" << std::endl;
+	js_info << " [--threads N] oldsave.sav newsave.sav" << std::endl;
 	js_info << "patches oldsave.sav to latest patchversion and saves" << std::endl;
 	js_info << "it as newsave.sav" << std::endl;
+	js_info << "   or: " << p << " --batch in_dir out_dir [--jobs N] [--threads N]" << std::endl;
+	js_info << "patches every save in in_dir into out_dir, N saves at a time" << std::endl;
+	js_info << "(0 = one per CPU, the default), and writes batch_summary.csv" << std::endl;
+	js_info << "--threads N patches the box mons on N threads (0 = one per CPU, the" << std::endl;
+	js_info << "default for a single save, batch mode uses 1 unless given)" << std::endl;
 	return 1;
 }
 
@@ -161,7 +291,32 @@ int main(int argc, char* argv[]) {
 	js_error << "This program is intended to be run in a browser using Emscripten." << std::endl;
 	return 1;
 #else
-	if (argc < 3) return usage(argv[0]);
-	return !patch_save(argv[1], argv[2], 10 /* current last version */, 0);
+	bool batch = false;
+	unsigned jobs = 0;
+	bool threads = false;
+	std::vector<const char*> paths;
+	for (int arg = 1; arg < argc; arg++) {
+		if (strcmp(argv[arg], "--batch") == 0) {
+			batch = true;
+		}
+		else if (strcmp(argv[arg], "--jobs") == 0 && arg + 1 < argc) {
+			jobs = static_cast<unsigned>(atoi(argv[++arg]));
+		}
+		else if (strcmp(argv[arg], "--threads") == 0 && arg + 1 < argc) {
+			setWorkerCount(static_cast<unsigned>(atoi(argv[++arg])));
+			threads = true;
+		}
+		else if (strncmp(argv[arg], "--", 2) == 0) {
+			return usage(argv[0]);
+		}
+		else {
+			paths.push_back(argv[arg]);
+		}
+	}
+	if (paths.size() != 2) return usage(argv[0]);
+	if (batch) return patch_batch(paths[0], paths[1], jobs);
+	// batch mode already keeps every CPU busy with whole saves, a single save uses them for its box mons
+	if (!threads) setWorkerCount(0);
+	return !patch_save(paths[0], paths[1], 10 /* current last version */, 0);
 #endif
 }
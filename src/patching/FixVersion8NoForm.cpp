@@ -1,20 +1,19 @@
 #include "patching/FixVersion8NoForm.h"
 
-#include "core/SymbolDatabaseContents.h"
+#include "symbols/Version8Symbols.h"
 
 namespace fixVersion8NoFormNamespace {
 
 	bool fixVersion8NoForm(SaveBinary& oldsave, SaveBinary& patchedsave) {
 		using namespace fixVersion8NoFormNamespace;
 
-		// copy the old save file to the new save file
-		patchedsave = oldsave;
-
 		// create the iterators
 		SaveBinary::Iterator itnew(patchedsave, 0);
 
 		// Load the version 7 and version 8 sym files
-		SymbolDatabase sym8(version8_sym_data, version8_sym_len);
+		const SymbolDatabase& sym8 = SymbolDatabase::forVersion(8);
+		oldsave.setSymbols(&sym8);
+		patchedsave.setSymbols(&sym8);
 
 		// get the checksum word from the save file
 		uint16_t save_checksum = patchedsave.getWord(SAVE_CHECKSUM_ABS_ADDRESS);
@@ -28,10 +27,10 @@ namespace fixVersion8NoFormNamespace {
 
 		// verify the checksum of the file matches the calculated checksum
 		// calculate the checksum from lookup symbol name "sGameData" to "sGameDataEnd"
-		uint16_t calculated_checksum = calculateSaveChecksum(patchedsave, sym8.getSRAMAddress("sGameData"), sym8.getSRAMAddress("sGameDataEnd"));
+		uint16_t calculated_checksum = calculateSaveChecksum(patchedsave, sym::v8::sGameData_SRAM, sym::v8::sGameDataEnd_SRAM);
 		if (save_checksum != calculated_checksum) {
-			js_error << "sGameData: " << std::hex << sym8.getSRAMAddress("sGameData") << std::endl;
-			js_error << "sGameDataEnd: " << std::hex << sym8.getSRAMAddress("sGameDataEnd") << std::endl;
+			js_error << "sGameData: " << std::hex << sym::v8::sGameData_SRAM << std::endl;
+			js_error << "sGameDataEnd: " << std::hex << sym::v8::sGameDataEnd_SRAM << std::endl;
 			js_error << "Checksum mismatch! Expected: " << std::hex << calculated_checksum << ", got: " << save_checksum << std::endl;
 			return false;
 		}
@@ -40,164 +39,92 @@ namespace fixVersion8NoFormNamespace {
 		uint16_t backup_checksum = patchedsave.getWord(SAVE_BACKUP_CHECKSUM_ABS_ADDRESS);
 		// verify the backup checksum of the version 7 file matches the calculated checksum
 		// calculate the checksum from lookup symbol name "sBackupGameData" to "sBackupGameDataEnd"
-		uint16_t calculated_backup_checksum = calculateSaveChecksum(patchedsave, sym8.getSRAMAddress("sBackupGameData"), sym8.getSRAMAddress("sBackupGameDataEnd"));
+		uint16_t calculated_backup_checksum = calculateSaveChecksum(patchedsave, sym::v8::sBackupGameData_SRAM, sym::v8::sBackupGameDataEnd_SRAM);
 		if (backup_checksum != calculated_backup_checksum) {
 			js_error << "Backup checksum mismatch! Expected: " << std::hex << calculated_backup_checksum << ", got: " << backup_checksum << std::endl;
 			return false;
 		}
 
-		savemon_struct_v8 savemon;
-		// Patching sBoxMons1A if checksums match
-		js_info << "Checking sBoxMons1A checksums..." << std::endl;
-		for (int i = 0; i < MONDB_ENTRIES_A_V8; i++) {
-			itnew.seek(sym8.getSRAMAddress("sBoxMons1A") + i * sizeof(savemon_struct_v8));
-			uint16_t calc_checksum = calculateNewboxChecksum(patchedsave, sym8.getSRAMAddress("sBoxMons1A") + i * sizeof(savemon_struct_v8));
-			uint16_t cur_checksum = extractStoredNewboxChecksum(patchedsave, sym8.getSRAMAddress("sBoxMons1A") + i * sizeof(savemon_struct_v8));
-			if (calc_checksum == cur_checksum) {
-				savemon = patchSavemonV8(loadStruct<savemon_struct_v8>(itnew, sym8.getSRAMAddress("sBoxMons1A") + i * sizeof(savemon_struct_v8)));
-				writeStruct<savemon_struct_v8>(itnew, sym8.getSRAMAddress("sBoxMons1A") + i * sizeof(savemon_struct_v8), savemon);
-				// write the new checksum
-				writeNewboxChecksum(patchedsave, sym8.getSRAMAddress("sBoxMons1A") + i * sizeof(savemon_struct_v8));
-			}
-		}
-
-		// Patching sBoxMons1B if checksums match
-		js_info << "Checking sBoxMons1B checksums..." << std::endl;
-		for (int i = 0; i < MONDB_ENTRIES_B_V8; i++) {
-			itnew.seek(sym8.getSRAMAddress("sBoxMons1B") + i * sizeof(savemon_struct_v8));
-			uint16_t calc_checksum = calculateNewboxChecksum(patchedsave, sym8.getSRAMAddress("sBoxMons1B") + i * sizeof(savemon_struct_v8));
-			uint16_t cur_checksum = extractStoredNewboxChecksum(patchedsave, sym8.getSRAMAddress("sBoxMons1B") + i * sizeof(savemon_struct_v8));
-			if (calc_checksum == cur_checksum) {
-				savemon = patchSavemonV8(loadStruct<savemon_struct_v8>(itnew, sym8.getSRAMAddress("sBoxMons1B") + i * sizeof(savemon_struct_v8)));
-				writeStruct<savemon_struct_v8>(itnew, sym8.getSRAMAddress("sBoxMons1B") + i * sizeof(savemon_struct_v8), savemon);
-				// write the new checksum
-				writeNewboxChecksum(patchedsave, sym8.getSRAMAddress("sBoxMons1B") + i * sizeof(savemon_struct_v8));
-			}
-		}
-
-		// Patching sBoxMons1C if checksums match
-		js_info << "Checking sBoxMons1C checksums..." << std::endl;
-		for (int i = 0; i < MONDB_ENTRIES_C_V8; i++) {
-			itnew.seek(sym8.getSRAMAddress("sBoxMons1C") + i * sizeof(savemon_struct_v8));
-			uint16_t calc_checksum = calculateNewboxChecksum(patchedsave, sym8.getSRAMAddress("sBoxMons1C") + i * sizeof(savemon_struct_v8));
-			uint16_t cur_checksum = extractStoredNewboxChecksum(patchedsave, sym8.getSRAMAddress("sBoxMons1C") + i * sizeof(savemon_struct_v8));
-			if (calc_checksum == cur_checksum) {
-				savemon = patchSavemonV8(loadStruct<savemon_struct_v8>(itnew, sym8.getSRAMAddress("sBoxMons1C") + i * sizeof(savemon_struct_v8)));
-				writeStruct<savemon_struct_v8>(itnew, sym8.getSRAMAddress("sBoxMons1C") + i * sizeof(savemon_struct_v8), savemon);
-				// write the new checksum
-				writeNewboxChecksum(patchedsave, sym8.getSRAMAddress("sBoxMons1C") + i * sizeof(savemon_struct_v8));
-			}
-		}
+		// the checksums are correct, keep them up to date as the save is patched
+		trackGameDataChecksums(patchedsave, sym8, calculated_checksum, calculated_backup_checksum);
 
-		// Patching sBoxMons2A if checksums match
-		js_info << "Checking sBoxMons2A checksums..." << std::endl;
-		for (int i = 0; i < MONDB_ENTRIES_A_V8; i++) {
-			itnew.seek(sym8.getSRAMAddress("sBoxMons2A") + i * sizeof(savemon_struct_v8));
-			uint16_t calc_checksum = calculateNewboxChecksum(patchedsave, sym8.getSRAMAddress("sBoxMons2A") + i * sizeof(savemon_struct_v8));
-			uint16_t cur_checksum = extractStoredNewboxChecksum(patchedsave, sym8.getSRAMAddress("sBoxMons2A") + i * sizeof(savemon_struct_v8));
-			if (calc_checksum == cur_checksum) {
-				savemon = patchSavemonV8(loadStruct<savemon_struct_v8>(itnew, sym8.getSRAMAddress("sBoxMons2A") + i * sizeof(savemon_struct_v8)));
-				writeStruct<savemon_struct_v8>(itnew, sym8.getSRAMAddress("sBoxMons2A") + i * sizeof(savemon_struct_v8), savemon);
-				// write the new checksum
-				writeNewboxChecksum(patchedsave, sym8.getSRAMAddress("sBoxMons2A") + i * sizeof(savemon_struct_v8));
-			}
-		}
-
-		// Patching sBoxMons2B if checksums match
-		js_info << "Checking sBoxMons2B checksums..." << std::endl;
-		for (int i = 0; i < MONDB_ENTRIES_B_V8; i++) {
-			itnew.seek(sym8.getSRAMAddress("sBoxMons2B") + i * sizeof(savemon_struct_v8));
-			uint16_t calc_checksum = calculateNewboxChecksum(patchedsave, sym8.getSRAMAddress("sBoxMons2B") + i * sizeof(savemon_struct_v8));
-			uint16_t cur_checksum = extractStoredNewboxChecksum(patchedsave, sym8.getSRAMAddress("sBoxMons2B") + i * sizeof(savemon_struct_v8));
-			if (calc_checksum == cur_checksum) {
-				savemon = patchSavemonV8(loadStruct<savemon_struct_v8>(itnew, sym8.getSRAMAddress("sBoxMons2B") + i * sizeof(savemon_struct_v8)));
-				writeStruct<savemon_struct_v8>(itnew, sym8.getSRAMAddress("sBoxMons2B") + i * sizeof(savemon_struct_v8), savemon);
-				// write the new checksum
-				writeNewboxChecksum(patchedsave, sym8.getSRAMAddress("sBoxMons2B") + i * sizeof(savemon_struct_v8));
-			}
-		}
-
-		// Patching sBoxMons2C if checksums match
-		js_info << "Checking sBoxMons2C checksums..." << std::endl;
-		for (int i = 0; i < MONDB_ENTRIES_C_V8; i++) {
-			itnew.seek(sym8.getSRAMAddress("sBoxMons2C") + i * sizeof(savemon_struct_v8));
-			uint16_t calc_checksum = calculateNewboxChecksum(patchedsave, sym8.getSRAMAddress("sBoxMons2C") + i * sizeof(savemon_struct_v8));
-			uint16_t cur_checksum = extractStoredNewboxChecksum(patchedsave, sym8.getSRAMAddress("sBoxMons2C") + i * sizeof(savemon_struct_v8));
-			if (calc_checksum == cur_checksum) {
-				savemon = patchSavemonV8(loadStruct<savemon_struct_v8>(itnew, sym8.getSRAMAddress("sBoxMons2C") + i * sizeof(savemon_struct_v8)));
-				writeStruct<savemon_struct_v8>(itnew, sym8.getSRAMAddress("sBoxMons2C") + i * sizeof(savemon_struct_v8), savemon);
-				// write the new checksum
-				writeNewboxChecksum(patchedsave, sym8.getSRAMAddress("sBoxMons2C") + i * sizeof(savemon_struct_v8));
-			}
+		// Patching sBoxMons1A to sBoxMons2C if checksums match
+		std::vector<NewboxBank> boxMonBanks = {
+			{"sBoxMons1A", sym::v8::sBoxMons1A_SRAM, MONDB_ENTRIES_A_V8},
+			{"sBoxMons1B", sym::v8::sBoxMons1B_SRAM, MONDB_ENTRIES_B_V8},
+			{"sBoxMons1C", sym::v8::sBoxMons1C_SRAM, MONDB_ENTRIES_C_V8},
+			{"sBoxMons2A", sym::v8::sBoxMons2A_SRAM, MONDB_ENTRIES_A_V8},
+			{"sBoxMons2B", sym::v8::sBoxMons2B_SRAM, MONDB_ENTRIES_B_V8},
+			{"sBoxMons2C", sym::v8::sBoxMons2C_SRAM, MONDB_ENTRIES_C_V8},
+		};
+		if (!patchNewboxBanks<savemon_struct_v8>(patchedsave, boxMonBanks, patchSavemonV8)) {
+			return false;
 		}
 
-		breedmon_struct_v8 breedmon;
 		// fix and copy wBreedMon1
 		js_info << "fix and copy wBreedMon1..." << std::endl;
-		uint16_t species = itnew.getByte(sym8.getPokemonDataAddress("wBreedMon1Species"));
+		uint16_t species = itnew.getByte(sym::v8::wBreedMon1Species_PokemonData);
 		if (species != 0x00) {
-			breedmon = patchBreedmonV8(loadStruct<breedmon_struct_v8>(itnew, sym8.getPokemonDataAddress("wBreedMon1")));
-			writeStruct<breedmon_struct_v8>(itnew, sym8.getPokemonDataAddress("wBreedMon1"), breedmon);
+			StructRef<breedmon_struct_v8> breedmonRef(patchedsave, sym::v8::wBreedMon1_PokemonData);
+			breedmonRef.store(patchBreedmonV8(breedmonRef.load()));
 		}
 
 		// fix and copy wBreedMon2
 		js_info << "fix and copy wBreedMon2..." << std::endl;
-		species = itnew.getByte(sym8.getPokemonDataAddress("wBreedMon2Species"));
+		species = itnew.getByte(sym::v8::wBreedMon2Species_PokemonData);
 		if (species != 0x00) {
-			breedmon = patchBreedmonV8(loadStruct<breedmon_struct_v8>(itnew, sym8.getPokemonDataAddress("wBreedMon2")));
-			writeStruct<breedmon_struct_v8>(itnew, sym8.getPokemonDataAddress("wBreedMon2"), breedmon);
+			StructRef<breedmon_struct_v8> breedmonRef(patchedsave, sym::v8::wBreedMon2_PokemonData);
+			breedmonRef.store(patchBreedmonV8(breedmonRef.load()));
 		}
 
-		party_struct_v8 partymon;
 		// fix the party mons
 		js_info << "Fix party mons..." << std::endl;
 		for (int i = 0; i < PARTY_LENGTH; i++) {
-			uint16_t species = itnew.getByte(sym8.getPokemonDataAddress("wPartyMons") + i * sizeof(party_struct_v8));
+			uint16_t species = itnew.getByte(sym::v8::wPartyMons_PokemonData + i * sizeof(party_struct_v8));
 			if (species == 0x00) {
 				continue;
 			}
-			partymon = patchPartyV8(loadStruct<party_struct_v8>(itnew, sym8.getPokemonDataAddress("wPartyMons") + i * sizeof(party_struct_v8)));
-			writeStruct<party_struct_v8>(itnew, sym8.getPokemonDataAddress("wPartyMons") + i * sizeof(party_struct_v8), partymon);
+			StructRef<party_struct_v8> partymonRef(patchedsave, sym::v8::wPartyMons_PokemonData + i * sizeof(party_struct_v8));
+			partymonRef.store(patchPartyV8(partymonRef.load()));
 		}
 
 		// fix wContestMonSpecies and wContestMonExtSpecies
 		js_info << "Fix wContestMon..." << std::endl;
-		species = itnew.getByte(sym8.getPokemonDataAddress("wContestMonSpecies"));
+		species = itnew.getByte(sym::v8::wContestMonSpecies_PokemonData);
 		if (species != 0x00) {
-			partymon = patchPartyV8(loadStruct<party_struct_v8>(itnew, sym8.getPokemonDataAddress("wContestMon")));
-			writeStruct<party_struct_v8>(itnew, sym8.getPokemonDataAddress("wContestMon"), partymon);
+			StructRef<party_struct_v8> partymonRef(patchedsave, sym::v8::wContestMon_PokemonData);
+			partymonRef.store(patchPartyV8(partymonRef.load()));
 		}
 
-		roam_struct_v8 roammon;
 		js_info << "Fix wRoamMon1..." << std::endl;
-		species = itnew.getByte(sym8.getPokemonDataAddress("wRoamMon1Species"));
+		species = itnew.getByte(sym::v8::wRoamMon1Species_PokemonData);
 		if (species != 0x00) {
-			roammon = patchRoamV8(loadStruct<roam_struct_v8>(itnew, sym8.getPokemonDataAddress("wRoamMon1")));
-			writeStruct<roam_struct_v8>(itnew, sym8.getPokemonDataAddress("wRoamMon1"), roammon);
+			StructRef<roam_struct_v8> roammonRef(patchedsave, sym::v8::wRoamMon1_PokemonData);
+			roammonRef.store(patchRoamV8(roammonRef.load()));
 		}
 
 		js_info << "Fix wRoamMon2..." << std::endl;
-		species = itnew.getByte(sym8.getPokemonDataAddress("wRoamMon2Species"));
+		species = itnew.getByte(sym::v8::wRoamMon2Species_PokemonData);
 		if (species != 0x00) {
-			roammon = patchRoamV8(loadStruct<roam_struct_v8>(itnew, sym8.getPokemonDataAddress("wRoamMon2")));
-			writeStruct<roam_struct_v8>(itnew, sym8.getPokemonDataAddress("wRoamMon2"), roammon);
+			StructRef<roam_struct_v8> roammonRef(patchedsave, sym::v8::wRoamMon2_PokemonData);
+			roammonRef.store(patchRoamV8(roammonRef.load()));
 		}
 
 		js_info << "Fix wRoamMon3..." << std::endl;
-		species = itnew.getByte(sym8.getPokemonDataAddress("wRoamMon3Species"));
+		species = itnew.getByte(sym::v8::wRoamMon3Species_PokemonData);
 		if (species != 0x00) {
-			roammon = patchRoamV8(loadStruct<roam_struct_v8>(itnew, sym8.getPokemonDataAddress("wRoamMon3")));
-			writeStruct<roam_struct_v8>(itnew, sym8.getPokemonDataAddress("wRoamMon3"), roammon);
+			StructRef<roam_struct_v8> roammonRef(patchedsave, sym::v8::wRoamMon3_PokemonData);
+			roammonRef.store(patchRoamV8(roammonRef.load()));
 		}
 
 		// write new checksums to the version 8 save file
 		js_info << "Write new checksums..." << std::endl;
-		uint16_t new_checksum = calculateSaveChecksum(patchedsave, sym8.getSRAMAddress("sGameData"), sym8.getSRAMAddress("sGameDataEnd"));
+		uint16_t new_checksum = calculateSaveChecksum(patchedsave, sym::v8::sGameData_SRAM, sym::v8::sGameDataEnd_SRAM);
 		patchedsave.setWord(SAVE_CHECKSUM_ABS_ADDRESS, new_checksum);
 
 		// write new backup checksums to the version 8 save file
 		js_info << "Write new backup checksums..." << std::endl;
-		uint16_t new_backup_checksum = calculateSaveChecksum(patchedsave, sym8.getSRAMAddress("sBackupGameData"), sym8.getSRAMAddress("sBackupGameDataEnd"));
+		uint16_t new_backup_checksum = calculateSaveChecksum(patchedsave, sym::v8::sBackupGameData_SRAM, sym::v8::sBackupGameDataEnd_SRAM);
 		patchedsave.setWord(SAVE_BACKUP_CHECKSUM_ABS_ADDRESS, new_backup_checksum);
 
 		// write the modified save file to the output file and print success message
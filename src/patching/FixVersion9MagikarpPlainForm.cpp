@@ -1,18 +1,17 @@
 #include "patching/FixVersion9MagikarpPlainForm.h"
 
-#include "core/SymbolDatabaseContents.h"
+#include "symbols/Version9Symbols.h"
 
 namespace fixVersion9MagikarpPlainFormNamespace {
 
 	bool fixVersion9MagikarpPlainForm(SaveBinary& oldsave, SaveBinary& patchedsave) {
-		// copy the old save file to the new save file
-		patchedsave = oldsave;
-
 		// create the iterators
 		SaveBinary::Iterator itnew(patchedsave, 0);
 
 		// Load the version 9 sym file
-		SymbolDatabase sym9(version9_sym_data, version9_sym_len);
+		const SymbolDatabase& sym9 = SymbolDatabase::forVersion(9);
+		oldsave.setSymbols(&sym9);
+		patchedsave.setSymbols(&sym9);
 
 		// get the checksum word from the save file
 		uint16_t save_checksum = patchedsave.getWord(SAVE_CHECKSUM_ABS_ADDRESS);
@@ -26,10 +25,10 @@ namespace fixVersion9MagikarpPlainFormNamespace {
 
 		// verify the checksum of the file matches the calculated checksum
 		// calculate the checksum from lookup symbol name "sGameData" to "sGameDataEnd"
-		uint16_t calculated_checksum = calculateSaveChecksum(patchedsave, sym9.getSRAMAddress("sGameData"), sym9.getSRAMAddress("sGameDataEnd"));
+		uint16_t calculated_checksum = calculateSaveChecksum(patchedsave, sym::v9::sGameData_SRAM, sym::v9::sGameDataEnd_SRAM);
 		if (save_checksum != calculated_checksum) {
-			js_error << "sGameData: " << std::hex << sym9.getSRAMAddress("sGameData") << std::endl;
-			js_error << "sGameDataEnd: " << std::hex << sym9.getSRAMAddress("sGameDataEnd") << std::endl;
+			js_error << "sGameData: " << std::hex << sym::v9::sGameData_SRAM << std::endl;
+			js_error << "sGameDataEnd: " << std::hex << sym::v9::sGameDataEnd_SRAM << std::endl;
 			js_error << "Checksum mismatch! Expected: " << std::hex << calculated_checksum << ", got: " << save_checksum << std::endl;
 			return false;
 		}
@@ -38,142 +37,71 @@ namespace fixVersion9MagikarpPlainFormNamespace {
 		uint16_t backup_checksum = patchedsave.getWord(SAVE_BACKUP_CHECKSUM_ABS_ADDRESS);
 		// verify the backup checksum of the version 9 file matches the calculated checksum
 		// calculate the checksum from lookup symbol name "sBackupGameData" to "sBackupGameDataEnd"
-		uint16_t calculated_backup_checksum = calculateSaveChecksum(patchedsave, sym9.getSRAMAddress("sBackupGameData"), sym9.getSRAMAddress("sBackupGameDataEnd"));
+		uint16_t calculated_backup_checksum = calculateSaveChecksum(patchedsave, sym::v9::sBackupGameData_SRAM, sym::v9::sBackupGameDataEnd_SRAM);
 		if (backup_checksum != calculated_backup_checksum) {
 			js_error << "Backup checksum mismatch! Expected: " << std::hex << calculated_backup_checksum << ", got: " << backup_checksum << std::endl;
 			return false;
 		}
 
-		savemon_struct_v9 savemon;
-		// Patching sBoxMons1A if checksums match
-		js_info << "Checking sBoxMons1A checksums..." << std::endl;
-		for (int i = 0; i < MONDB_ENTRIES_A_V9; i++) {
-			itnew.seek(sym9.getSRAMAddress("sBoxMons1A") + i * sizeof(savemon_struct_v9));
-			uint16_t calc_checksum = calculateNewboxChecksum(patchedsave, sym9.getSRAMAddress("sBoxMons1A") + i * sizeof(savemon_struct_v9));
-			uint16_t cur_checksum = extractStoredNewboxChecksum(patchedsave, sym9.getSRAMAddress("sBoxMons1A") + i * sizeof(savemon_struct_v9));
-			if (calc_checksum == cur_checksum) {
-				savemon = patchSavemonV9(loadStruct<savemon_struct_v9>(itnew, sym9.getSRAMAddress("sBoxMons1A") + i * sizeof(savemon_struct_v9)));
-				writeStruct<savemon_struct_v9>(itnew, sym9.getSRAMAddress("sBoxMons1A") + i * sizeof(savemon_struct_v9), savemon);
-				// write the new checksum
-				writeNewboxChecksum(patchedsave, sym9.getSRAMAddress("sBoxMons1A") + i * sizeof(savemon_struct_v9));
-			}
-		}
-
-		// Patching sBoxMons1B if checksums match
-		js_info << "Checking sBoxMons1B checksums..." << std::endl;
-		for (int i = 0; i < MONDB_ENTRIES_B_V9; i++) {
-			itnew.seek(sym9.getSRAMAddress("sBoxMons1B") + i * sizeof(savemon_struct_v9));
-			uint16_t calc_checksum = calculateNewboxChecksum(patchedsave, sym9.getSRAMAddress("sBoxMons1B") + i * sizeof(savemon_struct_v9));
-			uint16_t cur_checksum = extractStoredNewboxChecksum(patchedsave, sym9.getSRAMAddress("sBoxMons1B") + i * sizeof(savemon_struct_v9));
-			if (calc_checksum == cur_checksum) {
-				savemon = patchSavemonV9(loadStruct<savemon_struct_v9>(itnew, sym9.getSRAMAddress("sBoxMons1B") + i * sizeof(savemon_struct_v9)));
-				writeStruct<savemon_struct_v9>(itnew, sym9.getSRAMAddress("sBoxMons1B") + i * sizeof(savemon_struct_v9), savemon);
-				// write the new checksum
-				writeNewboxChecksum(patchedsave, sym9.getSRAMAddress("sBoxMons1B") + i * sizeof(savemon_struct_v9));
-			}
-		}
-
-		// Patching sBoxMons1C if checksums match
-		js_info << "Checking sBoxMons1C checksums..." << std::endl;
-		for (int i = 0; i < MONDB_ENTRIES_C_V9; i++) {
-			itnew.seek(sym9.getSRAMAddress("sBoxMons1C") + i * sizeof(savemon_struct_v9));
-			uint16_t calc_checksum = calculateNewboxChecksum(patchedsave, sym9.getSRAMAddress("sBoxMons1C") + i * sizeof(savemon_struct_v9));
-			uint16_t cur_checksum = extractStoredNewboxChecksum(patchedsave, sym9.getSRAMAddress("sBoxMons1C") + i * sizeof(savemon_struct_v9));
-			if (calc_checksum == cur_checksum) {
-				savemon = patchSavemonV9(loadStruct<savemon_struct_v9>(itnew, sym9.getSRAMAddress("sBoxMons1C") + i * sizeof(savemon_struct_v9)));
-				writeStruct<savemon_struct_v9>(itnew, sym9.getSRAMAddress("sBoxMons1C") + i * sizeof(savemon_struct_v9), savemon);
-				// write the new checksum
-				writeNewboxChecksum(patchedsave, sym9.getSRAMAddress("sBoxMons1C") + i * sizeof(savemon_struct_v9));
-			}
-		}
+		// the checksums are correct, keep them up to date as the save is patched
+		trackGameDataChecksums(patchedsave, sym9, calculated_checksum, calculated_backup_checksum);
 
-		// Patching sBoxMons2A if checksums match
-		js_info << "Checking sBoxMons2A checksums..." << std::endl;
-		for (int i = 0; i < MONDB_ENTRIES_A_V9; i++) {
-			itnew.seek(sym9.getSRAMAddress("sBoxMons2A") + i * sizeof(savemon_struct_v9));
-			uint16_t calc_checksum = calculateNewboxChecksum(patchedsave, sym9.getSRAMAddress("sBoxMons2A") + i * sizeof(savemon_struct_v9));
-			uint16_t cur_checksum = extractStoredNewboxChecksum(patchedsave, sym9.getSRAMAddress("sBoxMons2A") + i * sizeof(savemon_struct_v9));
-			if (calc_checksum == cur_checksum) {
-				savemon = patchSavemonV9(loadStruct<savemon_struct_v9>(itnew, sym9.getSRAMAddress("sBoxMons2A") + i * sizeof(savemon_struct_v9)));
-				writeStruct<savemon_struct_v9>(itnew, sym9.getSRAMAddress("sBoxMons2A") + i * sizeof(savemon_struct_v9), savemon);
-				// write the new checksum
-				writeNewboxChecksum(patchedsave, sym9.getSRAMAddress("sBoxMons2A") + i * sizeof(savemon_struct_v9));
-			}
-		}
-
-		// Patching sBoxMons2B if checksums match
-		js_info << "Checking sBoxMons2B checksums..." << std::endl;
-		for (int i = 0; i < MONDB_ENTRIES_B_V9; i++) {
-			itnew.seek(sym9.getSRAMAddress("sBoxMons2B") + i * sizeof(savemon_struct_v9));
-			uint16_t calc_checksum = calculateNewboxChecksum(patchedsave, sym9.getSRAMAddress("sBoxMons2B") + i * sizeof(savemon_struct_v9));
-			uint16_t cur_checksum = extractStoredNewboxChecksum(patchedsave, sym9.getSRAMAddress("sBoxMons2B") + i * sizeof(savemon_struct_v9));
-			if (calc_checksum == cur_checksum) {
-				savemon = patchSavemonV9(loadStruct<savemon_struct_v9>(itnew, sym9.getSRAMAddress("sBoxMons2B") + i * sizeof(savemon_struct_v9)));
-				writeStruct<savemon_struct_v9>(itnew, sym9.getSRAMAddress("sBoxMons2B") + i * sizeof(savemon_struct_v9), savemon);
-				// write the new checksum
-				writeNewboxChecksum(patchedsave, sym9.getSRAMAddress("sBoxMons2B") + i * sizeof(savemon_struct_v9));
-			}
-		}
-
-		// Patching sBoxMons2C if checksums match
-		js_info << "Checking sBoxMons2C checksums..." << std::endl;
-		for (int i = 0; i < MONDB_ENTRIES_C_V9; i++) {
-			itnew.seek(sym9.getSRAMAddress("sBoxMons2C") + i * sizeof(savemon_struct_v9));
-			uint16_t calc_checksum = calculateNewboxChecksum(patchedsave, sym9.getSRAMAddress("sBoxMons2C") + i * sizeof(savemon_struct_v9));
-			uint16_t cur_checksum = extractStoredNewboxChecksum(patchedsave, sym9.getSRAMAddress("sBoxMons2C") + i * sizeof(savemon_struct_v9));
-			if (calc_checksum == cur_checksum) {
-				savemon = patchSavemonV9(loadStruct<savemon_struct_v9>(itnew, sym9.getSRAMAddress("sBoxMons2C") + i * sizeof(savemon_struct_v9)));
-				writeStruct<savemon_struct_v9>(itnew, sym9.getSRAMAddress("sBoxMons2C") + i * sizeof(savemon_struct_v9), savemon);
-				// write the new checksum
-				writeNewboxChecksum(patchedsave, sym9.getSRAMAddress("sBoxMons2C") + i * sizeof(savemon_struct_v9));
-			}
+		// Patching sBoxMons1A to sBoxMons2C if checksums match
+		std::vector<NewboxBank> boxMonBanks = {
+			{"sBoxMons1A", sym::v9::sBoxMons1A_SRAM, MONDB_ENTRIES_A_V9},
+			{"sBoxMons1B", sym::v9::sBoxMons1B_SRAM, MONDB_ENTRIES_B_V9},
+			{"sBoxMons1C", sym::v9::sBoxMons1C_SRAM, MONDB_ENTRIES_C_V9},
+			{"sBoxMons2A", sym::v9::sBoxMons2A_SRAM, MONDB_ENTRIES_A_V9},
+			{"sBoxMons2B", sym::v9::sBoxMons2B_SRAM, MONDB_ENTRIES_B_V9},
+			{"sBoxMons2C", sym::v9::sBoxMons2C_SRAM, MONDB_ENTRIES_C_V9},
+		};
+		if (!patchNewboxBanks<savemon_struct_v9>(patchedsave, boxMonBanks, patchSavemonV9)) {
+			return false;
 		}
 
-		breedmon_struct_v9 breedmon;
 		// fix and copy wBreedMon1
 		js_info << "fix and copy wBreedMon1..." << std::endl;
-		uint16_t species = itnew.getByte(sym9.getPokemonDataAddress("wBreedMon1Species"));
+		uint16_t species = itnew.getByte(sym::v9::wBreedMon1Species_PokemonData);
 		if (species != 0x00) {
-			breedmon = patchBreedmonV9(loadStruct<breedmon_struct_v9>(itnew, sym9.getPokemonDataAddress("wBreedMon1")));
-			writeStruct<breedmon_struct_v9>(itnew, sym9.getPokemonDataAddress("wBreedMon1"), breedmon);
+			StructRef<breedmon_struct_v9> breedmonRef(patchedsave, sym::v9::wBreedMon1_PokemonData);
+			breedmonRef.store(patchBreedmonV9(breedmonRef.load()));
 		}
 
 		// fix and copy wBreedMon2
 		js_info << "fix and copy wBreedMon2..." << std::endl;
-		species = itnew.getByte(sym9.getPokemonDataAddress("wBreedMon2Species"));
+		species = itnew.getByte(sym::v9::wBreedMon2Species_PokemonData);
 		if (species != 0x00) {
-			breedmon = patchBreedmonV9(loadStruct<breedmon_struct_v9>(itnew, sym9.getPokemonDataAddress("wBreedMon2")));
-			writeStruct<breedmon_struct_v9>(itnew, sym9.getPokemonDataAddress("wBreedMon2"), breedmon);
+			StructRef<breedmon_struct_v9> breedmonRef(patchedsave, sym::v9::wBreedMon2_PokemonData);
+			breedmonRef.store(patchBreedmonV9(breedmonRef.load()));
 		}
 
-		party_struct_v9 partymon;
 		// fix the party mons
 		js_info << "Fix party mons..." << std::endl;
 		for (int i = 0; i < PARTY_LENGTH; i++) {
-			uint16_t species = itnew.getByte(sym9.getPokemonDataAddress("wPartyMons") + i * sizeof(party_struct_v9));
+			uint16_t species = itnew.getByte(sym::v9::wPartyMons_PokemonData + i * sizeof(party_struct_v9));
 			if (species == 0x00) {
 				continue;
 			}
-			partymon = patchPartyV9(loadStruct<party_struct_v9>(itnew, sym9.getPokemonDataAddress("wPartyMons") + i * sizeof(party_struct_v9)));
-			writeStruct<party_struct_v9>(itnew, sym9.getPokemonDataAddress("wPartyMons") + i * sizeof(party_struct_v9), partymon);
+			StructRef<party_struct_v9> partymonRef(patchedsave, sym::v9::wPartyMons_PokemonData + i * sizeof(party_struct_v9));
+			partymonRef.store(patchPartyV9(partymonRef.load()));
 		}
 
 		// fix wContestMon
 		js_info << "fix wContestMon..." << std::endl;
-		species = itnew.getByte(sym9.getPokemonDataAddress("wContestMonSpecies"));
+		species = itnew.getByte(sym::v9::wContestMonSpecies_PokemonData);
 		if (species != 0x00) {
-			partymon = patchPartyV9(loadStruct<party_struct_v9>(itnew, sym9.getPokemonDataAddress("wContestMon")));
-			writeStruct<party_struct_v9>(itnew, sym9.getPokemonDataAddress("wContestMon"), partymon);
+			StructRef<party_struct_v9> partymonRef(patchedsave, sym::v9::wContestMon_PokemonData);
+			partymonRef.store(patchPartyV9(partymonRef.load()));
 		}
 
 		// write new checksums to the version 9 save file
 		js_info << "Write new checksums..." << std::endl;
-		uint16_t new_checksum = calculateSaveChecksum(patchedsave, sym9.getSRAMAddress("sGameData"), sym9.getSRAMAddress("sGameDataEnd"));
+		uint16_t new_checksum = calculateSaveChecksum(patchedsave, sym::v9::sGameData_SRAM, sym::v9::sGameDataEnd_SRAM);
 		patchedsave.setWord(SAVE_CHECKSUM_ABS_ADDRESS, new_checksum);
 
 		// write new backup checksums to the version 9 save file
 		js_info << "Write new backup checksums..." << std::endl;
-		uint16_t new_backup_checksum = calculateSaveChecksum(patchedsave, sym9.getSRAMAddress("sBackupGameData"), sym9.getSRAMAddress("sBackupGameDataEnd"));
+		uint16_t new_backup_checksum = calculateSaveChecksum(patchedsave, sym::v9::sBackupGameData_SRAM, sym::v9::sBackupGameDataEnd_SRAM);
 		patchedsave.setWord(SAVE_BACKUP_CHECKSUM_ABS_ADDRESS, new_backup_checksum);
 
 		// write the modified save file to the output file and print success message
@@ -1,19 +1,18 @@
 #include "patching/FixVersion9PCWarpID.h"
 
-#include "core/SymbolDatabaseContents.h"
+#include "symbols/Version9Symbols.h"
 
 namespace fixVersion9PCWarpIDNamespace {
 	bool fixVersion9PCWarpID(SaveBinary& oldsave, SaveBinary& patchedsave) {
 		using namespace fixVersion9PCWarpIDNamespace;
 
-		// copy the old save file to the new save file
-		patchedsave = oldsave;
-
 		// create the iterators
 		SaveBinary::Iterator itnew(patchedsave, 0);
 
 		// Load the version 9 sym file
-		SymbolDatabase sym9(version9_sym_data, version9_sym_len);
+		const SymbolDatabase& sym9 = SymbolDatabase::forVersion(9);
+		oldsave.setSymbols(&sym9);
+		patchedsave.setSymbols(&sym9);
 
 		// get the checksum word from the save file
 		uint16_t save_checksum = patchedsave.getWord(SAVE_CHECKSUM_ABS_ADDRESS);
@@ -27,10 +26,10 @@ namespace fixVersion9PCWarpIDNamespace {
 
 		// verify the checksum of the file matches the calculated checksum
 		// calculate the checksum from lookup symbol name "sGameData" to "sGameDataEnd"
-		uint16_t calculated_checksum = calculateSaveChecksum(patchedsave, sym9.getSRAMAddress("sGameData"), sym9.getSRAMAddress("sGameDataEnd"));
+		uint16_t calculated_checksum = calculateSaveChecksum(patchedsave, sym::v9::sGameData_SRAM, sym::v9::sGameDataEnd_SRAM);
 		if (save_checksum != calculated_checksum) {
-			js_error << "sGameData: " << std::hex << sym9.getSRAMAddress("sGameData") << std::endl;
-			js_error << "sGameDataEnd: " << std::hex << sym9.getSRAMAddress("sGameDataEnd") << std::endl;
+			js_error << "sGameData: " << std::hex << sym::v9::sGameData_SRAM << std::endl;
+			js_error << "sGameDataEnd: " << std::hex << sym::v9::sGameDataEnd_SRAM << std::endl;
 			js_error << "Checksum mismatch! Expected: " << std::hex << calculated_checksum << ", got: " << save_checksum << std::endl;
 			return false;
 		}
@@ -39,14 +38,17 @@ namespace fixVersion9PCWarpIDNamespace {
 		uint16_t backup_checksum = patchedsave.getWord(SAVE_BACKUP_CHECKSUM_ABS_ADDRESS);
 		// verify the backup checksum of the version 9 file matches the calculated checksum
 		// calculate the checksum from lookup symbol name "sBackupGameData" to "sBackupGameDataEnd"
-		uint16_t calculated_backup_checksum = calculateSaveChecksum(patchedsave, sym9.getSRAMAddress("sBackupGameData"), sym9.getSRAMAddress("sBackupGameDataEnd"));
+		uint16_t calculated_backup_checksum = calculateSaveChecksum(patchedsave, sym::v9::sBackupGameData_SRAM, sym::v9::sBackupGameDataEnd_SRAM);
 		if (backup_checksum != calculated_backup_checksum) {
 			js_error << "Backup checksum mismatch! Expected: " << std::hex << calculated_backup_checksum << ", got: " << backup_checksum << std::endl;
 			return false;
 		}
 
+		// the checksums are correct, keep them up to date as the save is patched
+		trackGameDataChecksums(patchedsave, sym9, calculated_checksum, calculated_backup_checksum);
+
 		// check if the player in the PKMN Center 2nd Floor
-		uint8_t map_group = itnew.getByte(sym9.getMapDataAddress("wMapGroup"));
+		uint8_t map_group = itnew.getByte(sym::v9::wMapGroup_MapData);
 		itnew.next();
 		uint8_t map_num = itnew.getByte();
 		if (map_group != MON_CENTER_2F_GROUP || map_num != MON_CENTER_2F_MAP) {
@@ -54,8 +56,8 @@ namespace fixVersion9PCWarpIDNamespace {
 			return false;
 		}
 
-		uint8_t prev_map_group = itnew.getByte(sym9.getMapDataAddress("wBackupMapGroup"));
-		uint8_t prev_map_num = itnew.getByte(sym9.getMapDataAddress("wBackupMapNumber"));
+		uint8_t prev_map_group = itnew.getByte(sym::v9::wBackupMapGroup_MapData);
+		uint8_t prev_map_num = itnew.getByte(sym::v9::wBackupMapNumber_MapData);
 		// check if the previous map is a valid PC warp ID in the validPCWarpIDs array
 		bool valid_prev_map = false;
 		for (auto& validPCWarpID : validPCWarpIDs) {
@@ -69,26 +71,26 @@ namespace fixVersion9PCWarpIDNamespace {
 			return true;
 		}
 		js_warning << "Player's previous map is not a valid PKMN Center Warp ID! We will reset it to one." << std::endl;
-		if (isFlagBitSet(itnew, sym9.getPlayerDataAddress("wJohtoBadges"), PLAINBADGE)) {
+		if (isFlagBitSet(itnew, sym::v9::wJohtoBadges_PlayerData, PLAINBADGE)) {
 			js_warning << "Player has the PLAINBADGE, the stairs will now take you to Goldenrod PKMN Center." << std::endl;
-			itnew.setByte(sym9.getMapDataAddress("wBackupWarpNumber"), 4);
-			itnew.setByte(sym9.getMapDataAddress("wBackupMapGroup"), GOLDENROD_POKECOM_CENTER_1F.first);
-			itnew.setByte(sym9.getMapDataAddress("wBackupMapNumber"), GOLDENROD_POKECOM_CENTER_1F.second);
+			itnew.setByte(sym::v9::wBackupWarpNumber_MapData, 4);
+			itnew.setByte(sym::v9::wBackupMapGroup_MapData, GOLDENROD_POKECOM_CENTER_1F.first);
+			itnew.setByte(sym::v9::wBackupMapNumber_MapData, GOLDENROD_POKECOM_CENTER_1F.second);
 		} else {
 			js_warning << "Player does not have the PLAINBADGE, the stairs will now warp you to your house." << std::endl;
-			itnew.setByte(sym9.getMapDataAddress("wBackupWarpNumber"), 3);
-			itnew.setByte(sym9.getMapDataAddress("wBackupMapGroup"), PLAYERS_HOUSE_1F.first);
-			itnew.setByte(sym9.getMapDataAddress("wBackupMapNumber"), PLAYERS_HOUSE_1F.second);
+			itnew.setByte(sym::v9::wBackupWarpNumber_MapData, 3);
+			itnew.setByte(sym::v9::wBackupMapGroup_MapData, PLAYERS_HOUSE_1F.first);
+			itnew.setByte(sym::v9::wBackupMapNumber_MapData, PLAYERS_HOUSE_1F.second);
 		}
 
 		// write the new checksums to the version 9 save file
 		js_info << "Write new checksums..." << std::endl;
-		uint16_t new_checksum = calculateSaveChecksum(patchedsave, sym9.getSRAMAddress("sGameData"), sym9.getSRAMAddress("sGameDataEnd"));
+		uint16_t new_checksum = calculateSaveChecksum(patchedsave, sym::v9::sGameData_SRAM, sym::v9::sGameDataEnd_SRAM);
 		patchedsave.setWord(SAVE_CHECKSUM_ABS_ADDRESS, new_checksum);
 
 		// write new backup checksums to the version 9 save file
 		js_info << "Write new backup checksums..." << std::endl;
-		uint16_t new_backup_checksum = calculateSaveChecksum(patchedsave, sym9.getSRAMAddress("sBackupGameData"), sym9.getSRAMAddress("sBackupGameDataEnd"));
+		uint16_t new_backup_checksum = calculateSaveChecksum(patchedsave, sym::v9::sBackupGameData_SRAM, sym::v9::sBackupGameDataEnd_SRAM);
 		patchedsave.setWord(SAVE_BACKUP_CHECKSUM_ABS_ADDRESS, new_backup_checksum);
 
 		// write the modified save file to the output file and print success message
@@ -1,18 +1,14 @@
 #include "patching/FixVersion9RoamMap.h"
 
-#include "core/SymbolDatabaseContents.h"
+#include "symbols/Version9Symbols.h"
 
 namespace fixVersion9RoamMapNamespace {
 	bool fixVersion9RoamMap(SaveBinary& oldsave, SaveBinary& patchedsave) {
 
-		// copy the old save file to the new save file
-		patchedsave = oldsave;
-
-		// create the iterator
-		SaveBinary::Iterator itnew(patchedsave, 0);
-
 		// Load the version 9 sym file
-		SymbolDatabase sym9(version9_sym_data, version9_sym_len);
+		const SymbolDatabase& sym9 = SymbolDatabase::forVersion(9);
+		oldsave.setSymbols(&sym9);
+		patchedsave.setSymbols(&sym9);
 
 		// get the checksum word from the save file
 		uint16_t save_checksum = patchedsave.getWord(SAVE_CHECKSUM_ABS_ADDRESS);
@@ -26,10 +22,10 @@ namespace fixVersion9RoamMapNamespace {
 
 		// verify the checksum of the file matches the calculated checksum
 		// calculate the checksum from lookup symbol name "sGameData" to "sGameDataEnd"
-		uint16_t calculated_checksum = calculateSaveChecksum(patchedsave, sym9.getSRAMAddress("sGameData"), sym9.getSRAMAddress("sGameDataEnd"));
+		uint16_t calculated_checksum = calculateSaveChecksum(patchedsave, sym::v9::sGameData_SRAM, sym::v9::sGameDataEnd_SRAM);
 		if (save_checksum != calculated_checksum) {
-			js_error << "sGameData: " << std::hex << sym9.getSRAMAddress("sGameData") << std::endl;
-			js_error << "sGameDataEnd: " << std::hex << sym9.getSRAMAddress("sGameDataEnd") << std::endl;
+			js_error << "sGameData: " << std::hex << sym::v9::sGameData_SRAM << std::endl;
+			js_error << "sGameDataEnd: " << std::hex << sym::v9::sGameDataEnd_SRAM << std::endl;
 			js_error << "Checksum mismatch! Expected: " << std::hex << calculated_checksum << ", got: " << save_checksum << std::endl;
 			return false;
 		}
@@ -38,15 +34,19 @@ namespace fixVersion9RoamMapNamespace {
 		uint16_t backup_checksum = patchedsave.getWord(SAVE_BACKUP_CHECKSUM_ABS_ADDRESS);
 		// verify the backup checksum of the version 9 file matches the calculated checksum
 		// calculate the checksum from lookup symbol name "sBackupGameData" to "sBackupGameDataEnd"
-		uint16_t calculated_backup_checksum = calculateSaveChecksum(patchedsave, sym9.getSRAMAddress("sBackupGameData"), sym9.getSRAMAddress("sBackupGameDataEnd"));
+		uint16_t calculated_backup_checksum = calculateSaveChecksum(patchedsave, sym::v9::sBackupGameData_SRAM, sym::v9::sBackupGameDataEnd_SRAM);
 		if (backup_checksum != calculated_backup_checksum) {
 			js_error << "Backup checksum mismatch! Expected: " << std::hex << calculated_backup_checksum << ", got: " << backup_checksum << std::endl;
 			return false;
 		}
 
+		// the checksums are correct, keep them up to date as the save is patched
+		trackGameDataChecksums(patchedsave, sym9, calculated_checksum, calculated_backup_checksum);
+
 		roam_struct_v9 roammon;
 		js_info << "Fix wRoamMon1..." << std::endl;
-		roammon = loadStruct<roam_struct_v9>(itnew, sym9.getPokemonDataAddress("wRoamMon1"));
+		StructRef<roam_struct_v9> roammon1Ref(patchedsave, sym::v9::wRoamMon1_PokemonData);
+		roammon = roammon1Ref.load();
 		if (roammon.species == 0x00) {
 			roammon.setMap(std::make_tuple(-1, -1));
 			js_info << "wRoamMon1 species is 0x00, setting map to (-1, -1)" << std::endl;
@@ -55,10 +55,11 @@ namespace fixVersion9RoamMapNamespace {
 			roammon.setMap(std::make_tuple(-1, -1));
 			js_info << "wRoamMon1 group/map is (0,0), setting map to (-1, -1)" << std::endl;
 		}
-		writeStruct<roam_struct_v9>(itnew, sym9.getPokemonDataAddress("wRoamMon1"), roammon);
+		roammon1Ref.store(roammon);
 
 		js_info << "Fix wRoamMon2..." << std::endl;
-		roammon = loadStruct<roam_struct_v9>(itnew, sym9.getPokemonDataAddress("wRoamMon2"));
+		StructRef<roam_struct_v9> roammon2Ref(patchedsave, sym::v9::wRoamMon2_PokemonData);
+		roammon = roammon2Ref.load();
 		if (roammon.species == 0x00) {
 			roammon.setMap(std::make_tuple(-1, -1));
 			js_info << "wRoamMon2 species is 0x00, setting map to (-1, -1)" << std::endl;
@@ -67,10 +68,11 @@ namespace fixVersion9RoamMapNamespace {
 			roammon.setMap(std::make_tuple(-1, -1));
 			js_info << "wRoamMon2 group/map is (0,0), setting map to (-1, -1)" << std::endl;
 		}
-		writeStruct<roam_struct_v9>(itnew, sym9.getPokemonDataAddress("wRoamMon2"), roammon);
+		roammon2Ref.store(roammon);
 
 		js_info << "Fix wRoamMon3..." << std::endl;
-		roammon = loadStruct<roam_struct_v9>(itnew, sym9.getPokemonDataAddress("wRoamMon3"));
+		StructRef<roam_struct_v9> roammon3Ref(patchedsave, sym::v9::wRoamMon3_PokemonData);
+		roammon = roammon3Ref.load();
 		if (roammon.species == 0x00) {
 			roammon.setMap(std::make_tuple(-1, -1));
 			js_info << "wRoamMon3 species is 0x00, setting map to (-1, -1)" << std::endl;
@@ -79,16 +81,16 @@ namespace fixVersion9RoamMapNamespace {
 			roammon.setMap(std::make_tuple(-1, -1));
 			js_info << "wRoamMon3 group/map is (0,0), setting map to (-1, -1)" << std::endl;
 		}
-		writeStruct<roam_struct_v9>(itnew, sym9.getPokemonDataAddress("wRoamMon3"), roammon);
+		roammon3Ref.store(roammon);
 
 		// write the new checksums to the version 9 save file
 		js_info << "Write new checksums..." << std::endl;
-		uint16_t new_checksum = calculateSaveChecksum(patchedsave, sym9.getSRAMAddress("sGameData"), sym9.getSRAMAddress("sGameDataEnd"));
+		uint16_t new_checksum = calculateSaveChecksum(patchedsave, sym::v9::sGameData_SRAM, sym::v9::sGameDataEnd_SRAM);
 		patchedsave.setWord(SAVE_CHECKSUM_ABS_ADDRESS, new_checksum);
 
 		// write new backup checksums to the version 9 save file
 		js_info << "Write new backup checksums..." << std::endl;
-		uint16_t new_backup_checksum = calculateSaveChecksum(patchedsave, sym9.getSRAMAddress("sBackupGameData"), sym9.getSRAMAddress("sBackupGameDataEnd"));
+		uint16_t new_backup_checksum = calculateSaveChecksum(patchedsave, sym::v9::sBackupGameData_SRAM, sym::v9::sBackupGameDataEnd_SRAM);
 		patchedsave.setWord(SAVE_BACKUP_CHECKSUM_ABS_ADDRESS, new_backup_checksum);
 
 		js_info << "Sucessfully applied the PGO Battle Events Fix!" << std::endl;
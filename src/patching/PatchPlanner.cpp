@@ -0,0 +1,175 @@
+#include "patching/PatchPlanner.h"
+#include "patching/PatchVersion7to8.h"
+#include "patching/PatchVersion8to9.h"
+#include "patching/PatchVersion9to10.h"
+#include "patching/FixVersion8NoForm.h"
+#include "patching/FixVersion9RegisteredKeyItems.h"
+#include "patching/FixVersion9PCWarpID.h"
+#include "patching/FixVersion9PGOBattleEvent.h"
+#include "patching/FixVersion9RoamMap.h"
+#include "patching/FixVersion9MagikarpPlainForm.h"
+#include "core/CommonPatchFunctions.h"
+#include "core/Logging.h"
+#include <map>
+#include <mutex>
+#include <queue>
+#include <tuple>
+#include <utility>
+
+// the costs are rough relative run times
+static const std::vector<PatchEdge> patchEdges = {
+	{ 7, 8, 4, 0, "patchVersion7to8", patchVersion7to8Namespace::patchVersion7to8 },
+	{ 8, 9, 2, 0, "patchVersion8to9", patchVersion8to9Namespace::patchVersion8to9 },
+	{ 9, 10, 2, 0, "patchVersion9to10", patchVersion9to10Namespace::patchVersion9to10 },
+	{ 8, 8, 1, 1, "fixVersion8NoForm", fixVersion8NoFormNamespace::fixVersion8NoForm },
+	{ 9, 9, 1, 2, "fixVersion9RegisteredKeyItems", fixVersion9RegisteredKeyItemsNamespace::fixVersion9RegisteredKeyItems },
+	{ 9, 9, 1, 3, "fixVersion9PCWarpID", fixVersion9PCWarpIDNamespace::fixVersion9PCWarpID },
+	{ 9, 9, 1, 4, "fixVersion9PGOBattleEvent", fixVersion9PGOBattleEventNamespace::fixVersion9PGOBattleEvent },
+	{ 9, 9, 1, 5, "fixVersion9RoamMap", fixVersion9RoamMapNamespace::fixVersion9RoamMap },
+	{ 9, 9, 1, 6, "fixVersion9MagikarpPlainForm", fixVersion9MagikarpPlainFormNamespace::fixVersion9MagikarpPlainForm },
+};
+
+// get every registered patch edge
+const std::vector<PatchEdge>& getPatchEdges() {
+	return patchEdges;
+}
+
+// check if an upgrade starts at version
+bool isPatchableVersion(uint16_t version) {
+	for (const PatchEdge& edge : patchEdges) {
+		if (edge.fix == 0 && edge.sourceVersion == version) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// check if a dev fix is registered for dev_type
+bool isDevFix(int devType) {
+	for (const PatchEdge& edge : patchEdges) {
+		if (edge.fix != 0 && edge.fix == devType) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// get the latest save version an upgrade leads to
+uint16_t getLatestSaveVersion() {
+	uint16_t latest = 0;
+	for (const PatchEdge& edge : patchEdges) {
+		if (edge.fix == 0 && edge.targetVersion > latest) {
+			latest = edge.targetVersion;
+		}
+	}
+	return latest;
+}
+
+// find the cheapest route with Dijkstra's algorithm over the (version, applied fixes) states.
+// A fix edge is only taken if the fix is requested and not applied yet.
+static PatchPlan planRoute(uint16_t sourceVersion, uint16_t targetVersion, uint32_t fixes) {
+	// upgrades never go down, a save already at or past the target keeps its version
+	if (fixes == 0 && targetVersion <= sourceVersion) {
+		return { sourceVersion, targetVersion, fixes, true, 0, {} };
+	}
+
+	using State = std::pair<uint16_t, uint32_t>;
+	std::map<State, int> costs;
+	std::map<State, std::pair<State, const PatchEdge*>> previous;
+	std::priority_queue<std::pair<int, State>, std::vector<std::pair<int, State>>, std::greater<std::pair<int, State>>> queue;
+
+	State start = { sourceVersion, 0 };
+	State goal = { targetVersion, fixes };
+	costs[start] = 0;
+	queue.push({ 0, start });
+	while (!queue.empty()) {
+		int cost = queue.top().first;
+		State state = queue.top().second;
+		queue.pop();
+		if (cost > costs[state]) {
+			continue;
+		}
+		if (state == goal) {
+			break;
+		}
+		for (const PatchEdge& edge : patchEdges) {
+			if (edge.sourceVersion != state.first) {
+				continue;
+			}
+			uint32_t fix = edge.fix != 0 ? 1u << edge.fix : 0;
+			if (fix != 0 && ((fixes & fix) == 0 || (state.second & fix) != 0)) {
+				continue;
+			}
+			State next = { edge.targetVersion, state.second | fix };
+			auto known = costs.find(next);
+			if (known == costs.end() || cost + edge.cost < known->second) {
+				costs[next] = cost + edge.cost;
+				previous[next] = { state, &edge };
+				queue.push({ cost + edge.cost, next });
+			}
+		}
+	}
+
+	PatchPlan plan = { sourceVersion, targetVersion, fixes, false, 0, {} };
+	auto reached = costs.find(goal);
+	if (reached == costs.end()) {
+		return plan;
+	}
+	plan.found = true;
+	plan.cost = reached->second;
+	for (State state = goal; state != start; state = previous[state].first) {
+		plan.edges.insert(plan.edges.begin(), previous[state].second);
+	}
+	return plan;
+}
+
+// get the cheapest plan from sourceVersion to targetVersion applying fixes
+const PatchPlan& getPatchPlan(uint16_t sourceVersion, uint16_t targetVersion, uint32_t fixes) {
+	static std::mutex mutex;
+	static std::map<std::tuple<uint16_t, uint16_t, uint32_t>, PatchPlan> plans;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	auto key = std::make_tuple(sourceVersion, targetVersion, fixes);
+	auto cached = plans.find(key);
+	if (cached != plans.end()) {
+		return cached->second;
+	}
+	return plans.emplace(key, planRoute(sourceVersion, targetVersion, fixes)).first->second;
+}
+
+// run plan on oldSave into newSave
+bool runPatchPlan(const PatchPlan& plan, SaveBinary& oldSave, SaveBinary& newSave) {
+	if (!plan.found) {
+		js_error << "No patch route from save version " << std::dec << plan.sourceVersion << " to " << plan.targetVersion << "." << std::endl;
+		return false;
+	}
+
+	// the two buffers both start out holding the old save
+	SaveBinary* src = &oldSave;
+	SaveBinary* dst = &newSave;
+	src->clearDirtyBlocks();
+	dst->clearDirtyBlocks();
+	for (size_t i = 0; i < plan.edges.size(); i++) {
+		const PatchEdge& edge = *plan.edges[i];
+		if (i > 0) {
+			swapChainBuffers(src, dst);
+		}
+		if (!edge.patch(*src, *dst)) {
+			if (edge.fix != 0) {
+				js_error << edge.name << " failed." << std::endl;
+			}
+			else {
+				js_error << "Failed to patch save file from version " << std::dec << edge.sourceVersion << " to " << edge.targetVersion << "." << std::endl;
+			}
+			return false;
+		}
+		if (edge.fix == 0) {
+			js_info << "Patched save file from version " << std::dec << edge.sourceVersion << " to " << edge.targetVersion << "." << std::endl;
+		}
+	}
+	// hand the last destination back as newSave (moves only, no copy)
+	if (dst != &newSave) {
+		std::swap(oldSave, newSave);
+	}
+	return true;
+}
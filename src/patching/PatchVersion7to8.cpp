@@ -2,22 +2,22 @@
 #include "core/CommonPatchFunctions.h"
 #include "core/SymbolDatabase.h"
 #include "core/Logging.h"
-#include "core/SymbolDatabaseContents.h"
+#include "symbols/Version7Symbols.h"
+#include "symbols/Version8Symbols.h"
 #include <algorithm>
 
 namespace patchVersion7to8Namespace {
 
 bool patchVersion7to8(SaveBinary& save7, SaveBinary& save8) {
-	// copy the old save file to the new save file
-	save8 = save7;
-
 	// create the iterators
 	SaveBinary::Iterator it7(save7, 0);
 	SaveBinary::Iterator it8(save8, 0);
 
 	// Load the version 7 and version 8 sym files
-	SymbolDatabase sym7(version7_sym_data, version7_sym_len);
-	SymbolDatabase sym8(version8_sym_data, version8_sym_len);
+	const SymbolDatabase& sym7 = SymbolDatabase::forVersion(7);
+	const SymbolDatabase& sym8 = SymbolDatabase::forVersion(8);
+	save7.setSymbols(&sym7);
+	save8.setSymbols(&sym8);
 
 	SourceDest sd = {it7, it8, sym7, sym8};
 
@@ -26,10 +26,10 @@ bool patchVersion7to8(SaveBinary& save7, SaveBinary& save8) {
 
 	// verify the checksum of the version 7 file matches the calculated checksum
 	// calculate the checksum from lookup symbol name "sGameData" to "sGameDataEnd"
-	uint16_t calculated_checksum = calculateSaveChecksum(save7, sym7.getSRAMAddress("sGameData"), sym7.getSRAMAddress("sGameDataEnd"));
+	uint16_t calculated_checksum = calculateSaveChecksum(save7, sym::v7::sGameData_SRAM, sym::v7::sGameDataEnd_SRAM);
 	if (save_checksum != calculated_checksum) {
-		js_error << "sGameData: " << std::hex << sym7.getSRAMAddress("sGameData") << std::endl;
-		js_error << "sGameDataEnd: " << std::hex << sym7.getSRAMAddress("sGameDataEnd") << std::endl;
+		js_error << "sGameData: " << std::hex << sym::v7::sGameData_SRAM << std::endl;
+		js_error << "sGameDataEnd: " << std::hex << sym::v7::sGameDataEnd_SRAM << std::endl;
 		js_error <<  "Checksum mismatch! Expected: " << std::hex << calculated_checksum << ", got: " << save_checksum << std::endl;
 		return false;
 	}
@@ -38,14 +38,17 @@ bool patchVersion7to8(SaveBinary& save7, SaveBinary& save8) {
 	uint16_t backup_checksum = save7.getWord(SAVE_BACKUP_CHECKSUM_ABS_ADDRESS);
 	// verify the backup checksum of the version 7 file matches the calculated checksum
 	// calculate the checksum from lookup symbol name "sBackupGameData" to "sBackupGameDataEnd"
-	uint16_t calculated_backup_checksum = calculateSaveChecksum(save7, sym7.getSRAMAddress("sBackupGameData"), sym7.getSRAMAddress("sBackupGameDataEnd"));
+	uint16_t calculated_backup_checksum = calculateSaveChecksum(save7, sym::v7::sBackupGameData_SRAM, sym::v7::sBackupGameDataEnd_SRAM);
 	if (backup_checksum != calculated_backup_checksum) {
 		js_error <<  "Backup checksum mismatch! Expected: " << std::hex << calculated_backup_checksum << ", got: " << backup_checksum << std::endl;
 		return false;
 	}
 
+	// keep the new save's checksums up to date as it is patched
+	trackGameDataChecksums(save8, sym8);
+
 	// check if the player in the PKMN Center 2nd Floor
-	uint8_t map_group = it7.getByte(sym7.getMapDataAddress("wMapGroup"));
+	uint8_t map_group = it7.getByte(sym::v7::wMapGroup_MapData);
 	it7.next();
 	uint8_t map_num = it7.getByte();
 	if (map_group != MON_CENTER_2F_GROUP || map_num != MON_CENTER_2F_MAP) {
@@ -54,8 +57,8 @@ bool patchVersion7to8(SaveBinary& save7, SaveBinary& save8) {
 	}
 
 	// Due to a change in map blocks for the SHAMOUTI_POKECENTER, we don't support saving here.
-	uint8_t prev_map_group = it7.getByte(sym7.getMapDataAddress("wBackupMapGroup"));
-	uint8_t prev_map_num = it7.getByte(sym7.getMapDataAddress("wBackupMapNumber"));
+	uint8_t prev_map_group = it7.getByte(sym::v7::wBackupMapGroup_MapData);
+	uint8_t prev_map_num = it7.getByte(sym::v7::wBackupMapNumber_MapData);
 	if (prev_map_group == SHAMOUTI_POKECENTER_1F.first && prev_map_num == SHAMOUTI_POKECENTER_1F.second) {
 		js_error << "Due to a change in map blocks, we cannot support saving in the Shamouti PKMN center!" << std::endl;
 		return false;
@@ -66,112 +69,101 @@ bool patchVersion7to8(SaveBinary& save7, SaveBinary& save8) {
 	// Create vector to store caught mons
 	std::vector<uint16_t> caught_mons;
 
-	migrateBoxData(sd, "sNewBox");
-	migrateBoxData(sd, "sBackupNewBox");
+	migrateBoxData(sd, "sNewBox#", "sNewBox#Name", "sNewBox#Theme");
+	migrateBoxData(sd, "sBackupNewBox#", "sBackupNewBox#Name", "sBackupNewBox#Theme");
 
 	// copy sBoxMons1 to sBoxMons1A
 	js_info <<  "Copying from sBoxMons1 to sBoxMons1A..." << std::endl;
-	copyDataBlock(sd, sym7.getSRAMAddress("sBoxMons1"), sym8.getSRAMAddress("sBoxMons1A"), MONDB_ENTRIES_A_V8 * sizeof(savemon_struct_v8));
+	copyDataBlock(sd, sym::v7::sBoxMons1_SRAM, sym::v8::sBoxMons1A_SRAM, MONDB_ENTRIES_A_V8 * sizeof(savemon_struct_v8));
 
 	js_info << "Clearing " << "sBoxMons1B" << "..." << std::endl;
-	clearDataBlock(sd, sym8.getSRAMAddress("sBoxMons1B"), MONDB_ENTRIES_B_V8 * sizeof(savemon_struct_v8));
+	clearDataBlock(sd, sym::v8::sBoxMons1B_SRAM, MONDB_ENTRIES_B_V8 * sizeof(savemon_struct_v8));
 	js_info << "Clearing " << "sBoxMons1C" << "..." << std::endl;
-	clearDataBlock(sd, sym8.getSRAMAddress("sBoxMons1C"), MONDB_ENTRIES_C_V8 * sizeof(savemon_struct_v8));
+	clearDataBlock(sd, sym::v8::sBoxMons1C_SRAM, MONDB_ENTRIES_C_V8 * sizeof(savemon_struct_v8));
 
 	// copy sBoxMons2 to SBoxMons2A
 	js_info <<  "Copying from sBoxMons2 to sBoxMons2A..." << std::endl;
-	copyDataBlock(sd, sym7.getSRAMAddress("sBoxMons2"), sym8.getSRAMAddress("sBoxMons2A"), MONDB_ENTRIES_A_V8 * sizeof(savemon_struct_v8));
+	copyDataBlock(sd, sym::v7::sBoxMons2_SRAM, sym::v8::sBoxMons2A_SRAM, MONDB_ENTRIES_A_V8 * sizeof(savemon_struct_v8));
 
 	js_info << "Clearing " << "sBoxMons2B" << "..." << std::endl;
-	clearDataBlock(sd, sym8.getSRAMAddress("sBoxMons2B"), MONDB_ENTRIES_B_V8 * sizeof(savemon_struct_v8));
+	clearDataBlock(sd, sym::v8::sBoxMons2B_SRAM, MONDB_ENTRIES_B_V8 * sizeof(savemon_struct_v8));
 	js_info << "Clearing " << "sBoxMons2C" << "..." << std::endl;
-	clearDataBlock(sd, sym8.getSRAMAddress("sBoxMons2C"), MONDB_ENTRIES_C_V8 * sizeof(savemon_struct_v8));
-
-	savemon_struct_v8 savemon;
-	// Patching sBoxMons1A if checksums match
-	js_info <<  "Checking sBoxMons1A checksums..." << std::endl;
-	for (int i = 0; i < MONDB_ENTRIES_A_V8; i++) {
-		it8.seek(sym8.getSRAMAddress("sBoxMons1A") + i * sizeof(savemon_struct_v8));
-		uint16_t calc_checksum = calculateNewboxChecksum(save8, sym8.getSRAMAddress("sBoxMons1A") + i * sizeof(savemon_struct_v8));
-		uint16_t cur_checksum = extractStoredNewboxChecksum(save8, sym8.getSRAMAddress("sBoxMons1A") + i * sizeof(savemon_struct_v8));
-		if (calc_checksum == cur_checksum) {
-			savemon = convertSavemonV7toV8(loadStruct<savemon_struct_v8>(it8, sym8.getSRAMAddress("sBoxMons1A") + i * sizeof(savemon_struct_v8)), seen_mons, caught_mons);
-			writeStruct<savemon_struct_v8>(it8, sym8.getSRAMAddress("sBoxMons1A") + i * sizeof(savemon_struct_v8), savemon);
-			// write the new checksum
-			writeNewboxChecksum(save8, sym8.getSRAMAddress("sBoxMons1A") + i * sizeof(savemon_struct_v8));
-		}
+	clearDataBlock(sd, sym::v8::sBoxMons2C_SRAM, MONDB_ENTRIES_C_V8 * sizeof(savemon_struct_v8));
+
+	// Patching sBoxMons1A and sBoxMons2A if checksums match
+	std::vector<NewboxBank> boxMonBanks = {
+		{"sBoxMons1A", sym::v8::sBoxMons1A_SRAM, MONDB_ENTRIES_A_V8},
+		{"sBoxMons2A", sym::v8::sBoxMons2A_SRAM, MONDB_ENTRIES_A_V8},
+	};
+	// the mons are converted on the worker threads, so each keeps its seen and caught mons apart
+	// until they are added in box order
+	std::vector<std::vector<uint16_t>> boxSeenMons(2 * MONDB_ENTRIES_A_V8);
+	std::vector<std::vector<uint16_t>> boxCaughtMons(2 * MONDB_ENTRIES_A_V8);
+	if (!patchNewboxBanks<savemon_struct_v8>(save8, boxMonBanks, [&boxSeenMons, &boxCaughtMons](const savemon_struct_v8& savemon, size_t index) {
+		return convertSavemonV7toV8(savemon, boxSeenMons[index], boxCaughtMons[index]);
+	})) {
+		return false;
 	}
-
-	// Patching sBoxMons2A if checksums match
-	js_info <<  "Checking sBoxMons2A checksums..." << std::endl;
-	for (int i = 0; i < MONDB_ENTRIES_A_V8; i++) {
-		it8.seek(sym8.getSRAMAddress("sBoxMons2A") + i * sizeof(savemon_struct_v8));
-		uint16_t calc_checksum = calculateNewboxChecksum(save8, sym8.getSRAMAddress("sBoxMons2A") + i * sizeof(savemon_struct_v8));
-		uint16_t cur_checksum = extractStoredNewboxChecksum(save8, sym8.getSRAMAddress("sBoxMons2A") + i * sizeof(savemon_struct_v8));
-		if (calc_checksum == cur_checksum) {
-			savemon = convertSavemonV7toV8(loadStruct<savemon_struct_v8>(it8, sym8.getSRAMAddress("sBoxMons2A") + i * sizeof(savemon_struct_v8)), seen_mons, caught_mons);
-			writeStruct<savemon_struct_v8>(it8, sym8.getSRAMAddress("sBoxMons2A") + i * sizeof(savemon_struct_v8), savemon);
-			// write the new checksum
-			writeNewboxChecksum(save8, sym8.getSRAMAddress("sBoxMons2A") + i * sizeof(savemon_struct_v8));
-		}
+	for (size_t i = 0; i < boxSeenMons.size(); i++) {
+		seen_mons.insert(seen_mons.end(), boxSeenMons[i].begin(), boxSeenMons[i].end());
+		caught_mons.insert(caught_mons.end(), boxCaughtMons[i].begin(), boxCaughtMons[i].end());
 	}
 
 	// copy from [sLinkBattleResults, sLinkBattleStatsEnd)
 	js_info << "Copying from [sLinkBattleResults, sLinkBattleStatsEnd)" << std::endl;
-	copyDataBlock(sd, sym7.getSRAMAddress("sLinkBattleResults"), sym8.getSRAMAddress("sLinkBattleResults"), sym7.getSRAMAddress("sLinkBattleStatsEnd") - sym7.getSRAMAddress("sLinkBattleResults"));
+	copyDataBlock(sd, sym::v7::sLinkBattleResults_SRAM, sym::v8::sLinkBattleResults_SRAM, sym::v7::sLinkBattleStatsEnd_SRAM - sym::v7::sLinkBattleResults_SRAM);
 
 	// copy from [sBattleTowerChallengeState, sBT_OTMonParty3 + BATTLETOWER_PARTYDATA_SIZE]
 	js_info << "Copying from [sBattleTowerChallengeState, sBT_OTMonParty3 + BATTLETOWER_PARTYDATA_SIZE]" << std::endl;
-	copyDataBlock(sd, sym7.getSRAMAddress("sBattleTowerChallengeState"), sym8.getSRAMAddress("sBattleTowerChallengeState"), sym7.getSRAMAddress("sBT_OTMonParty3") + BATTLETOWER_PARTYDATA_SIZE + 1 - sym7.getSRAMAddress("sBattleTowerChallengeState"));
+	copyDataBlock(sd, sym::v7::sBattleTowerChallengeState_SRAM, sym::v8::sBattleTowerChallengeState_SRAM, sym::v7::sBT_OTMonParty3_SRAM + BATTLETOWER_PARTYDATA_SIZE + 1 - sym::v7::sBattleTowerChallengeState_SRAM);
 
 	// copy from [sPartyMail, sSaveVersion)
 	js_info << "Copying from [sPartyMail, sSaveVersion)" << std::endl;
-	copyDataBlock(sd, sym7.getSRAMAddress("sPartyMail"), sym8.getSRAMAddress("sPartyMail"), sym7.getSRAMAddress("sSaveVersion") - sym7.getSRAMAddress("sPartyMail"));
+	copyDataBlock(sd, sym::v7::sPartyMail_SRAM, sym::v8::sPartyMail_SRAM, sym::v7::sSaveVersion_SRAM - sym::v7::sPartyMail_SRAM);
 
 	// Fix sPartyMail
-	mailmsg_struct_v8 mailmsg;
 	js_info << "Fixing sPartyMail..." << std::endl;
 	for (int i = 0; i < PARTY_LENGTH; i++) {
-		mailmsg = convertMailmsgV7toV8(loadStruct<mailmsg_struct_v8>(it8, sym8.getSRAMAddress("sPartyMail") + i * sizeof(mailmsg_struct_v8)));
-		writeStruct<mailmsg_struct_v8>(it8, sym8.getSRAMAddress("sPartyMail") + i * sizeof(mailmsg_struct_v8), mailmsg);
+		StructRef<mailmsg_struct_v8> mailmsgRef(save8, sym::v8::sPartyMail_SRAM + i * sizeof(mailmsg_struct_v8));
+		mailmsgRef.store(convertMailmsgV7toV8(mailmsgRef.load()));
 	}
 
 	// Fix sPartyMailBackup
 	js_info << "Fixing sPartyMailBackup..." << std::endl;
 	for (int i = 0; i < PARTY_LENGTH; i++) {
-		mailmsg = convertMailmsgV7toV8(loadStruct<mailmsg_struct_v8>(it8, sym8.getSRAMAddress("sPartyMailBackup") + i * sizeof(mailmsg_struct_v8)));
-		writeStruct<mailmsg_struct_v8>(it8, sym8.getSRAMAddress("sPartyMailBackup") + i * sizeof(mailmsg_struct_v8), mailmsg);
+		StructRef<mailmsg_struct_v8> mailmsgRef(save8, sym::v8::sPartyMailBackup_SRAM + i * sizeof(mailmsg_struct_v8));
+		mailmsgRef.store(convertMailmsgV7toV8(mailmsgRef.load()));
 	}
 
 	// Fix sMailbox
 	js_info << "Fixing sMailbox..." << std::endl;
 	for (int i = 0; i < MAILBOX_CAPACITY; i++) {
-		mailmsg = convertMailmsgV7toV8(loadStruct<mailmsg_struct_v8>(it8, sym8.getSRAMAddress("sMailbox") + i * sizeof(mailmsg_struct_v8)));
-		writeStruct<mailmsg_struct_v8>(it8, sym8.getSRAMAddress("sMailbox") + i * sizeof(mailmsg_struct_v8), mailmsg);
+		StructRef<mailmsg_struct_v8> mailmsgRef(save8, sym::v8::sMailbox_SRAM + i * sizeof(mailmsg_struct_v8));
+		mailmsgRef.store(convertMailmsgV7toV8(mailmsgRef.load()));
 	}
 
 	// Fix sMailboxBackup
 	js_info << "Fixing sMailboxBackup..." << std::endl;
 	for (int i = 0; i < MAILBOX_CAPACITY; i++) {
-		mailmsg = convertMailmsgV7toV8(loadStruct<mailmsg_struct_v8>(it8, sym8.getSRAMAddress("sMailboxBackup") + i * sizeof(mailmsg_struct_v8)));
-		writeStruct<mailmsg_struct_v8>(it8, sym8.getSRAMAddress("sMailboxBackup") + i * sizeof(mailmsg_struct_v8), mailmsg);
+		StructRef<mailmsg_struct_v8> mailmsgRef(save8, sym::v8::sMailboxBackup_SRAM + i * sizeof(mailmsg_struct_v8));
+		mailmsgRef.store(convertMailmsgV7toV8(mailmsgRef.load()));
 	}
 
 	// copy from [sUpgradeStep, sWritingBackup]
 	js_info << "Copying from [sUpgradeStep, sWritingBackup + 1]" << std::endl;
-	copyDataBlock(sd, sym7.getSRAMAddress("sUpgradeStep"), sym8.getSRAMAddress("sUpgradeStep"), sym7.getSRAMAddress("sWritingBackup") + 1 - sym7.getSRAMAddress("sUpgradeStep"));
+	copyDataBlock(sd, sym::v7::sUpgradeStep_SRAM, sym::v8::sUpgradeStep_SRAM, sym::v7::sWritingBackup_SRAM + 1 - sym::v7::sUpgradeStep_SRAM);
 
 	// copy from [sRTCStatusFlags, sLuckyIDNumber]
 	js_info << "Copying from [sRTCStatusFlags, sLuckyIDNumber]" << std::endl;
-	copyDataBlock(sd, sym7.getSRAMAddress("sRTCStatusFlags"), sym8.getSRAMAddress("sRTCStatusFlags"), sym7.getSRAMAddress("sLuckyIDNumber") + 2 - sym7.getSRAMAddress("sRTCStatusFlags"));
+	copyDataBlock(sd, sym::v7::sRTCStatusFlags_SRAM, sym::v8::sRTCStatusFlags_SRAM, sym::v7::sLuckyIDNumber_SRAM + 2 - sym::v7::sRTCStatusFlags_SRAM);
 
 	// copy from [sOptions, sGameData)
 	js_info <<  "Copying from [sOptions, sGameData)" << std::endl;
-	copyDataBlock(sd, sym7.getSRAMAddress("sOptions"), sym8.getSRAMAddress("sOptions"), sym7.getSRAMAddress("sGameData") - sym7.getSRAMAddress("sOptions"));
+	copyDataBlock(sd, sym::v7::sOptions_SRAM, sym::v8::sOptions_SRAM, sym::v7::sGameData_SRAM - sym::v7::sOptions_SRAM);
 
 	// Reset NUZLOCKE bit to off; this becomes the affection option.
 	js_info <<  "Resetting NUZLOCKE bit..." << std::endl;
-	it8.resetBit(sym8.getOptionsAddress("wInitialOptions"), AFFECTION_OPT); // previously NUZLOCKE_OPT
+	it8.resetBit(sym::v8::wInitialOptions_Options, AFFECTION_OPT); // previously NUZLOCKE_OPT
 
 	// Make sure wInitialOptions2 is clear in v8
 	js_info <<  "Clearing wInitialOptions2..." << std::endl;
@@ -188,207 +180,203 @@ bool patchVersion7to8(SaveBinary& save7, SaveBinary& save8) {
 
 	// copy from [wPlayerData, wObjectStructs)
 	js_info <<  "Copying from [wPlayerData, wObjectStructs)" << std::endl;
-	copyDataBlock(sd, sym7.getPlayerDataAddress("wPlayerData"), sym8.getPlayerDataAddress("wPlayerData"), sym7.getPlayerDataAddress("wObjectStructs") - sym7.getPlayerDataAddress("wPlayerData"));
+	copyDataBlock(sd, sym::v7::wPlayerData_PlayerData, sym::v8::wPlayerData_PlayerData, sym::v7::wObjectStructs_PlayerData - sym::v7::wPlayerData_PlayerData);
 
 	// clear unused bytes after wRTC, [wRTC + 4, wRTC + 8)
 	js_info << "Clearing 4 unused bytes after wRTC" << std::endl;
-	clearDataBlock(sd, sym8.getPlayerDataAddress("wRTC") + 4, 4);
+	clearDataBlock(sd, sym::v8::wRTC_PlayerData + 4, 4);
 
 	js_info <<  "Patching Object Structs..." << std::endl;
 
 	// version 8 expanded each object struct by 1 byte to add the palette index byte at the end.
 	// we need to copy the lower nybble of OBJECT_PALETTE_V7 to the new OBJECT_PAL_INDEX_V8
 	// and then copy the rest of the object struct from version 7 to version 8
+	// the object structs are wPlayerStruct followed by wObject1Struct to wObject12Struct
+	SymbolSet objectStructs7(sym7);
+	SymbolSet objectStructs8(sym8);
+	objectStructs7.addWRAM("wPlayerStruct", SymbolDatabase::SaveBlock::PLAYER_DATA);
+	objectStructs7.addWRAMFamily("wObject#Struct", 1, NUM_OBJECT_STRUCTS - 1, SymbolDatabase::SaveBlock::PLAYER_DATA);
+	objectStructs8.addWRAM("wPlayerStruct", SymbolDatabase::SaveBlock::PLAYER_DATA);
+	objectStructs8.addWRAMFamily("wObject#Struct", 1, NUM_OBJECT_STRUCTS - 1, SymbolDatabase::SaveBlock::PLAYER_DATA);
+	objectStructs7.resolve();
+	objectStructs8.resolve();
 	for (int i = 0; i < NUM_OBJECT_STRUCTS; i++) {
-		it7.seek(sym7.getPlayerDataAddress("wObjectStructs") + i * OBJECT_LENGTH_V7);
-		it8.seek(sym8.getPlayerDataAddress("wObjectStructs") + i * OBJECT_LENGTH_V8);
+		it7.seek(sym::v7::wObjectStructs_PlayerData + i * OBJECT_LENGTH_V7);
+		it8.seek(sym::v8::wObjectStructs_PlayerData + i * OBJECT_LENGTH_V8);
 
-		// string is equal to "wObject" + string(i) + "Structs"
-		std::string objectStruct;
-		if (i == 0) {
-			objectStruct = "wPlayerStruct";
-		} else {
-			objectStruct = "wObject" + std::to_string(i) + "Struct";
-		}
+		std::string objectStruct = objectStructs7.getName(i);
 		// assert that current address is equal to objectStruct
-		if (it7.getAddress() != sym7.getPlayerDataAddress(objectStruct)) {
-			js_error <<  "Unexpected address for " << objectStruct << " in version 7 save file: " << std::hex << it7.getAddress() << ", expected: " << sym7.getPlayerDataAddress(objectStruct) << std::endl;
+		if (objectStructs7.isResolved() && it7.getAddress() != objectStructs7[i]) {
+			js_error <<  "Unexpected address for " << objectStruct << " in version 7 save file: " << std::hex << it7.getAddress() << ", expected: " << objectStructs7[i] << std::endl;
 		}
-		if (it8.getAddress() != sym8.getPlayerDataAddress(objectStruct)) {
-			js_error <<  "Unexpected address for " << objectStruct << " in version 8 save file: " << std::hex << it8.getAddress() << ", expected: " << sym8.getPlayerDataAddress(objectStruct) << std::endl;
+		if (objectStructs8.isResolved() && it8.getAddress() != objectStructs8[i]) {
+			js_error <<  "Unexpected address for " << objectStruct << " in version 8 save file: " << std::hex << it8.getAddress() << ", expected: " << objectStructs8[i] << std::endl;
 		}
 		it8.copy(it7, OBJECT_LENGTH_V7);
 		// copy the lower nybble of OBJECT_PALETTE_V7 to OBJECT_PAL_INDEX_V8
-		uint8_t palette = save7.getByte(sym7.getPlayerDataAddress("wObjectStructs") + i * OBJECT_LENGTH_V7 + OBJECT_PALETTE_V7) & 0x0F;
+		uint8_t palette = save7.getByte(sym::v7::wObjectStructs_PlayerData + i * OBJECT_LENGTH_V7 + OBJECT_PALETTE_V7) & 0x0F;
 		js_info <<  objectStruct << " Palette: " << std::hex << static_cast<int>(palette) << std::endl;
 		it8.setByte(palette);
 	}
 
 	// copy from [wStoneTableAddress, wBattleFactorySwapCount]
 	js_info <<  "Copying from [wStoneTableAddress, wBattleFactorySwapCount]" << std::endl;
-	copyDataBlock(sd, sym7.getPlayerDataAddress("wObjectStructsEnd"), sym8.getPlayerDataAddress("wObjectStructsEnd"), sym7.getPlayerDataAddress("wBattleFactorySwapCount") + 1 - sym7.getPlayerDataAddress("wObjectStructsEnd"));
+	copyDataBlock(sd, sym::v7::wObjectStructsEnd_PlayerData, sym::v8::wObjectStructsEnd_PlayerData, sym::v7::wBattleFactorySwapCount_PlayerData + 1 - sym::v7::wObjectStructsEnd_PlayerData);
 
 	// copy from [wMapObjects, wEnteredMapFromContinue)
 	js_info <<  "Copying from [wMapObjects, wEnteredMapFromContinue)" << std::endl;
-	copyDataBlock(sd, sym7.getPlayerDataAddress("wMapObjects"), sym8.getPlayerDataAddress("wMapObjects"), sym7.getPlayerDataAddress("wEnteredMapFromContinue") - sym7.getPlayerDataAddress("wMapObjects"));
+	copyDataBlock(sd, sym::v7::wMapObjects_PlayerData, sym::v8::wMapObjects_PlayerData, sym::v7::wEnteredMapFromContinue_PlayerData - sym::v7::wMapObjects_PlayerData);
 
 	// copy it7 wEnteredMapFromContinue to it8 wEnteredMapFromContinue
 	js_info <<  "Copy wEnteredMapFromContinue" << std::endl;
-	copyDataByte(sd, sym7.getPlayerDataAddress("wEnteredMapFromContinue"), sym8.getPlayerDataAddress("wEnteredMapFromContinue"));
+	copyDataByte(sd, sym::v7::wEnteredMapFromContinue_PlayerData, sym::v8::wEnteredMapFromContinue_PlayerData);
 
 	js_info <<  "Copy wStatusFlags3" << std::endl;
 	// copy it7 wStatusFlags3 to it8 wStatusFlags3
-	copyDataByte(sd, sym7.getPlayerDataAddress("wStatusFlags3"), sym8.getPlayerDataAddress("wStatusFlags3"));
+	copyDataByte(sd, sym::v7::wStatusFlags3_PlayerData, sym::v8::wStatusFlags3_PlayerData);
 
 	// copy from [wTimeOfDayPal, wBadgesEnd)
 	js_info <<  "Copying from [wTimeOfDayPal, wBadgesEnd)" << std::endl;
-	copyDataBlock(sd, sym7.getPlayerDataAddress("wTimeOfDayPal"), sym8.getPlayerDataAddress("wTimeOfDayPal"), sym7.getPlayerDataAddress("wBadgesEnd") - sym7.getPlayerDataAddress("wTimeOfDayPal"));
+	copyDataBlock(sd, sym::v7::wTimeOfDayPal_PlayerData, sym::v8::wTimeOfDayPal_PlayerData, sym::v7::wBadgesEnd_PlayerData - sym::v7::wTimeOfDayPal_PlayerData);
 
 	// clear unused bytes after wTimeOfDayPal, [wTimeOfDayPal + 1, wTimeOfDayPal + 5)
 	js_info << "Clearing 4 unused bytes after wTimeOfDayPal" << std::endl;
-	clearDataBlock(sd, sym8.getPlayerDataAddress("wTimeOfDayPal") + 1, 4);
+	clearDataBlock(sd, sym::v8::wTimeOfDayPal_PlayerData + 1, 4);
 
 	// clear save 8 [wPokemonJournals, wPokemonJournalsEnd)
 	js_info <<  "Clearing save 8 [wPok****Journals, wPok****JournalsEnd)" << std::endl;
-	clearDataBlock(sd, sym8.getPlayerDataAddress("wPokemonJournals"), sym8.getPlayerDataAddress("wPokemonJournalsEnd") - sym8.getPlayerDataAddress("wPokemonJournals"));
+	clearDataBlock(sd, sym::v8::wPokemonJournals_PlayerData, sym::v8::wPokemonJournalsEnd_PlayerData - sym::v8::wPokemonJournals_PlayerData);
 
 	// copy from [wPokemonJournals, wPokemonJournalsEnd)
 	js_info <<  "Copying from [wPok****Journals, wPok****JournalsEnd)" << std::endl;
-	copyDataBlock(sd, sym7.getPlayerDataAddress("wPokemonJournals"), sym8.getPlayerDataAddress("wPokemonJournals"), sym7.getPlayerDataAddress("wPokemonJournalsEnd") - sym7.getPlayerDataAddress("wPokemonJournals"));
+	copyDataBlock(sd, sym::v7::wPokemonJournals_PlayerData, sym::v8::wPokemonJournals_PlayerData, sym::v7::wPokemonJournalsEnd_PlayerData - sym::v7::wPokemonJournals_PlayerData);
 
 	// copy from [wTMsHMs, wTMsHMsEnd)
 	js_info <<  "Copying from [wTMsHMs, wTMsHMsEnd)" << std::endl;
-	copyDataBlock(sd, sym7.getPlayerDataAddress("wTMsHMs"), sym8.getPlayerDataAddress("wTMsHMs"), sym7.getPlayerDataAddress("wTMsHMsEnd") - sym7.getPlayerDataAddress("wTMsHMs"));
+	copyDataBlock(sd, sym::v7::wTMsHMs_PlayerData, sym::v8::wTMsHMs_PlayerData, sym::v7::wTMsHMsEnd_PlayerData - sym::v7::wTMsHMs_PlayerData);
 
 	// clear save 8 wKeyItems
 	js_info <<  "Clearing save 8 [wKeyItems, wKeyItemsEnd)" << std::endl;
-	clearDataBlock(sd, sym8.getPlayerDataAddress("wKeyItems"), sym8.getPlayerDataAddress("wKeyItemsEnd") - sym8.getPlayerDataAddress("wKeyItems"));
+	clearDataBlock(sd, sym::v8::wKeyItems_PlayerData, sym::v8::wKeyItemsEnd_PlayerData - sym::v8::wKeyItems_PlayerData);
 
 	js_info <<  "Patching wKeyItems..." << std::endl;
-	it7.seek(sym7.getPlayerDataAddress("wKeyItems"));
-	it8.seek(sym8.getPlayerDataAddress("wKeyItems"));
-	// it7 wKeyItems is a bit flag array of NUM_KEY_ITEMS_V7 bits. If v7 bit is set, lookup the bit index in the map and write the index to the next byte in it8.
-	for (int i = 0; i < NUM_KEY_ITEMS_V7; i++) {
-		// check if the bit is set
-		if (isFlagBitSet(it7, sym7.getPlayerDataAddress("wKeyItems"), i)) {
-			// get the key item index is equal to the bit index
-			uint8_t keyItemIndex = i;
-			// map the version 7 key item to the version 8 key item
-			uint8_t keyItemIndexV8 = mapV7KeyItemToV8(keyItemIndex);
-			// if the key item is found write to the next byte in it8.
-			if (keyItemIndexV8 != 0xFF) {
-				// print found key itemv7 and converted key itemv8
-				if (keyItemIndex != keyItemIndexV8){
-					js_info <<  "Key Item " << std::hex << static_cast<int>(keyItemIndex) << " converted to " << std::hex << static_cast<int>(keyItemIndexV8) << std::endl;
-				}
-				it8.setByte(keyItemIndexV8);
-				it8.next();
-			} else {
-				// warn we couldn't find v7 key item in v8
-				js_error <<  "Key Item " << std::hex << keyItemIndex << " not found in version 8 key item list." << std::endl;
+	it7.seek(sym::v7::wKeyItems_PlayerData);
+	it8.seek(sym::v8::wKeyItems_PlayerData);
+	// it7 wKeyItems is a bit flag array of NUM_KEY_ITEMS_V7 bits. For each set bit, lookup the bit index in the map and write the index to the next byte in it8.
+	FlagArrayView keyItems7(save7, sym::v7::wKeyItems_PlayerData, NUM_KEY_ITEMS_V7);
+	for (uint32_t i : keyItems7.getSetFlags()) {
+		// get the key item index is equal to the bit index
+		uint8_t keyItemIndex = i;
+		// map the version 7 key item to the version 8 key item
+		uint8_t keyItemIndexV8 = mapV7KeyItemToV8(keyItemIndex);
+		// if the key item is found write to the next byte in it8.
+		if (keyItemIndexV8 != 0xFF) {
+			// print found key itemv7 and converted key itemv8
+			if (keyItemIndex != keyItemIndexV8){
+				js_info <<  "Key Item " << std::hex << static_cast<int>(keyItemIndex) << " converted to " << std::hex << static_cast<int>(keyItemIndexV8) << std::endl;
 			}
+			it8.setByte(keyItemIndexV8);
+			it8.next();
+		} else {
+			// warn we couldn't find v7 key item in v8
+			js_error <<  "Key Item " << std::hex << keyItemIndex << " not found in version 8 key item list." << std::endl;
 		}
 	}
 	// write 0x00 to the end of wKeyItems
 	it8.setByte(0x00);
 
-	convertItemList(sd, sym7.getPlayerDataAddress("wNumItems"), sym7.getPlayerDataAddress("wItems"), sym8.getPlayerDataAddress("wNumItems"), sym8.getPlayerDataAddress("wItems"), "wItems");
-	convertItemList(sd, sym7.getPlayerDataAddress("wNumMedicine"), sym7.getPlayerDataAddress("wMedicine"), sym8.getPlayerDataAddress("wNumMedicine"), sym8.getPlayerDataAddress("wMedicine"), "wMedicine");
-	convertItemList(sd, sym7.getPlayerDataAddress("wNumBalls"), sym7.getPlayerDataAddress("wBalls"), sym8.getPlayerDataAddress("wNumBalls"), sym8.getPlayerDataAddress("wBalls"), "wBalls");
-	convertItemList(sd, sym7.getPlayerDataAddress("wNumBerries"), sym7.getPlayerDataAddress("wBerries"), sym8.getPlayerDataAddress("wNumBerries"), sym8.getPlayerDataAddress("wBerries"), "wBerries");
-	convertItemList(sd, sym7.getPlayerDataAddress("wNumPCItems"), sym7.getPlayerDataAddress("wPCItems"), sym8.getPlayerDataAddress("wNumPCItems"), sym8.getPlayerDataAddress("wPCItems"), "wPCItems");
+	convertItemList(sd, sym::v7::wNumItems_PlayerData, sym::v7::wItems_PlayerData, sym::v8::wNumItems_PlayerData, sym::v8::wItems_PlayerData, "wItems");
+	convertItemList(sd, sym::v7::wNumMedicine_PlayerData, sym::v7::wMedicine_PlayerData, sym::v8::wNumMedicine_PlayerData, sym::v8::wMedicine_PlayerData, "wMedicine");
+	convertItemList(sd, sym::v7::wNumBalls_PlayerData, sym::v7::wBalls_PlayerData, sym::v8::wNumBalls_PlayerData, sym::v8::wBalls_PlayerData, "wBalls");
+	convertItemList(sd, sym::v7::wNumBerries_PlayerData, sym::v7::wBerries_PlayerData, sym::v8::wNumBerries_PlayerData, sym::v8::wBerries_PlayerData, "wBerries");
+	convertItemList(sd, sym::v7::wNumPCItems_PlayerData, sym::v7::wPCItems_PlayerData, sym::v8::wNumPCItems_PlayerData, sym::v8::wPCItems_PlayerData, "wPCItems");
 
 	// copy from [wApricorns, wApricorns + NUM_APRICORNS)
 	js_info << "Copying from [wApricorns, wApricorns + NUM_APRICORNS)" << std::endl;
-	copyDataBlock(sd, sym7.getPlayerDataAddress("wApricorns"), sym8.getPlayerDataAddress("wApricorns"), NUM_APRICORNS);
+	copyDataBlock(sd, sym::v7::wApricorns_PlayerData, sym::v8::wApricorns_PlayerData, NUM_APRICORNS);
 
 	// copy from [wPokegearFlags, wAlways0SceneID)
 	js_info <<  "Copy from [wPok*gearFlags, wAlways0SceneID)" << std::endl;
-	copyDataBlock(sd, sym7.getPlayerDataAddress("wPokegearFlags"), sym8.getPlayerDataAddress("wPokegearFlags"), sym7.getPlayerDataAddress("wAlways0SceneID") - sym7.getPlayerDataAddress("wPokegearFlags"));
+	copyDataBlock(sd, sym::v7::wPokegearFlags_PlayerData, sym::v8::wPokegearFlags_PlayerData, sym::v7::wAlways0SceneID_PlayerData - sym::v7::wPokegearFlags_PlayerData);
 
 	// clear byte before wMooMooBerries
 	js_info << "Clearing byte before wMooMooBerries..." << std::endl;
-	it8.setByte(sym8.getPlayerDataAddress("wMooMooBerries") - 1, 0x00);
+	it8.setByte(sym::v8::wMooMooBerries_PlayerData - 1, 0x00);
 
 	// copy from [wAlways0SceneID, wEcruteakHouseSceneID]
 	js_info <<  "Copy from [wAlways0SceneID, wEcru****HouseSceneID]" << std::endl;
-	copyDataBlock(sd, sym7.getPlayerDataAddress("wAlways0SceneID"), sym8.getPlayerDataAddress("wAlways0SceneID"), sym7.getPlayerDataAddress("wEcruteakHouseSceneID") + 1 - sym7.getPlayerDataAddress("wAlways0SceneID"));
+	copyDataBlock(sd, sym::v7::wAlways0SceneID_PlayerData, sym::v8::wAlways0SceneID_PlayerData, sym::v7::wEcruteakHouseSceneID_PlayerData + 1 - sym::v7::wAlways0SceneID_PlayerData);
 
 	// clear wEcruteakPokecenter1FSceneID as it is no longer used
 	js_info <<  "Clear wEcru********center1FSceneID..." << std::endl;
-	it8.setByte(sym8.getPlayerDataAddress("wEcruteakHouseSceneID") + 1, 0x00);
+	it8.setByte(sym::v8::wEcruteakHouseSceneID_PlayerData + 1, 0x00);
 
 	// copy from [wElmsLabSceneID, wEventFlags)
 	js_info <<  "Copy from [wE***LabSceneID, wEventFlags)" << std::endl;
-	copyDataBlock(sd, sym7.getPlayerDataAddress("wElmsLabSceneID"), sym8.getPlayerDataAddress("wElmsLabSceneID"), sym7.getPlayerDataAddress("wEventFlags") - sym7.getPlayerDataAddress("wElmsLabSceneID"));
+	copyDataBlock(sd, sym::v7::wElmsLabSceneID_PlayerData, sym::v8::wElmsLabSceneID_PlayerData, sym::v7::wEventFlags_PlayerData - sym::v7::wElmsLabSceneID_PlayerData);
 
 	// clear it8 wEventFlags
 	js_info <<  "Clearing save 8 [wEventFalgs, wEventFlags + flag_array(NUM_EVENTS))" << std::endl;
-	clearDataBlock(sd, sym8.getPlayerDataAddress("wEventFlags"), flag_array(NUM_EVENTS));
+	clearDataBlock(sd, sym::v8::wEventFlags_PlayerData, flag_array(NUM_EVENTS));
 
-	it8.seek(sym8.getPlayerDataAddress("wEventFlags"));
 	// wEventFlags is a flag_array of NUM_EVENTS bits. If v7 bit is set, lookup the bit index in the map and set the corresponding bit in v8
 	js_info <<  "Patching wEventFlags..." << std::endl;
-	for (int i = 0; i < NUM_EVENTS; i++) {
-		// check if the bit is set
-		if (isFlagBitSet(it7, sym7.getPlayerDataAddress("wEventFlags"), i)) {
-			// get the event flag index is equal to the bit index
-			uint16_t eventFlagIndex = i;
-			// map the version 7 event flag to the version 8 event flag
-			uint16_t eventFlagIndexV8 = mapV7EventFlagToV8(eventFlagIndex);
-			// if the event flag is found set the corresponding bit in it8
-			if (eventFlagIndexV8 != INVALID_EVENT_FLAG) {
-				// print found event flagv7 and converted event flagv8
-				if (eventFlagIndex != eventFlagIndexV8){
-					js_info <<  "Event Flag " << std::dec << eventFlagIndex << " converted to " << eventFlagIndexV8 << std::endl;
-				}
-				setFlagBit(it8, sym8.getPlayerDataAddress("wEventFlags"), eventFlagIndexV8);
-			} else {
-				// warn we couldn't find v7 event flag in v8
-				js_warning <<  "Event Flag " << eventFlagIndex << " not found in version 8 event flag list." << std::endl;
-			}
+	static const FlagRemap eventFlagRemap(NUM_EVENTS, NUM_EVENTS, [](uint32_t eventFlagIndex) {
+		uint16_t eventFlagIndexV8 = mapV7EventFlagToV8(eventFlagIndex);
+		return eventFlagIndexV8 != INVALID_EVENT_FLAG ? eventFlagIndexV8 : FlagRemap::DROPPED;
+	});
+	FlagArrayView eventFlags7(save7, sym::v7::wEventFlags_PlayerData, NUM_EVENTS);
+	FlagArrayView eventFlags8(sym::v8::wEventFlags_PlayerData, NUM_EVENTS);
+	eventFlagRemap.apply(eventFlags7, eventFlags8, [](uint32_t eventFlagIndex, uint32_t eventFlagIndexV8) {
+		if (eventFlagIndexV8 != FlagRemap::DROPPED) {
+			// print found event flagv7 and converted event flagv8
+			js_info <<  "Event Flag " << std::dec << eventFlagIndex << " converted to " << eventFlagIndexV8 << std::endl;
+		} else {
+			// warn we couldn't find v7 event flag in v8
+			js_warning <<  "Event Flag " << eventFlagIndex << " not found in version 8 event flag list." << std::endl;
 		}
-	}
+	});
 
 	// Initialize EVENT_CRYS_IN_NAVEL_ROCK
 	js_info << "Initialize EVENT_CRYS_IN_NAVEL_ROCK..." << std::endl;
-	setFlagBit(it8, sym8.getPlayerDataAddress("wEventFlags"), EVENT_CRYS_IN_NAVEL_ROCK);
+	eventFlags8.set(EVENT_CRYS_IN_NAVEL_ROCK);
+	eventFlags8.store(save8);
 
 	// copy v7 wCurBox to v8 wCurBox
 	js_info <<  "Copy wCurBox" << std::endl;
-	copyDataByte(sd, sym7.getPlayerDataAddress("wCurBox"), sym8.getPlayerDataAddress("wCurBox"));
+	copyDataByte(sd, sym::v7::wCurBox_PlayerData, sym::v8::wCurBox_PlayerData);
 
 	// clear from [wUsedObjectPals, wNeededPalIndex]
 	js_info <<  "Clear from [wUsedObjectPals, wNeededPalIndex]" << std::endl;
-	clearDataBlock(sd, sym8.getPlayerDataAddress("wUsedObjectPals"), sym8.getPlayerDataAddress("wNeededPalIndex") + 1 - sym8.getPlayerDataAddress("wUsedObjectPals"));
+	clearDataBlock(sd, sym::v8::wUsedObjectPals_PlayerData, sym::v8::wNeededPalIndex_PlayerData + 1 - sym::v8::wUsedObjectPals_PlayerData);
 
 	// set it8 wLoadedObjPal0-7 to -1
 	js_info <<  "Set wLoadedObjPal0-7 to -1..." << std::endl;
-	fillDataBlock(sd, sym8.getPlayerDataAddress("wLoadedObjPal0"), 8, 0xFF);
+	fillDataBlock(sd, sym::v8::wLoadedObjPal0_PlayerData, 8, 0xFF);
 
 	// clear 70 bytes after wEmotePal
 	js_info << "Clear 70 bytes after wEmotePal..." << std::endl;
-	clearDataBlock(sd, sym8.getPlayerDataAddress("wEmotePal") + 1, 70);
+	clearDataBlock(sd, sym::v8::wEmotePal_PlayerData + 1, 70);
 
 	// copy from [wCelebiEvent, wCurMapCallbacksPointer]
 	js_info <<  "Copy from [wCel***Event, wCurMapCallbacksPointer]" << std::endl;
-	copyDataBlock(sd, sym7.getPlayerDataAddress("wCelebiEvent"), sym8.getPlayerDataAddress("wCelebiEvent"), sym7.getPlayerDataAddress("wCurMapCallbacksPointer") + 2 - sym7.getPlayerDataAddress("wCelebiEvent"));
+	copyDataBlock(sd, sym::v7::wCelebiEvent_PlayerData, sym::v8::wCelebiEvent_PlayerData, sym::v7::wCurMapCallbacksPointer_PlayerData + 2 - sym::v7::wCelebiEvent_PlayerData);
 
 	// clear byte before wDecoBed
 	js_info << "Clear unused byte before wDecoBed..." << std::endl;
-	it8.setByte(sym8.getPlayerDataAddress("wDecoBed") - 1, 0x00);
+	it8.setByte(sym::v8::wDecoBed_PlayerData - 1, 0x00);
 
 	// copy from wDecoBed to wFruitTreeFlags
 	js_info <<  "Copy from wDecoBed to wFruitTreeFlags..." << std::endl;
-	copyDataBlock(sd, sym7.getPlayerDataAddress("wDecoBed"), sym8.getPlayerDataAddress("wDecoBed"), sym7.getPlayerDataAddress("wFruitTreeFlags") - sym7.getPlayerDataAddress("wDecoBed"));
+	copyDataBlock(sd, sym::v7::wDecoBed_PlayerData, sym::v8::wDecoBed_PlayerData, sym::v7::wFruitTreeFlags_PlayerData - sym::v7::wDecoBed_PlayerData);
 
 	// Copy wFruitTreeFlags
 	js_info <<  "Copy wFruitTreeFlags..." << std::endl;
-	copyDataBlock(sd, sym7.getPlayerDataAddress("wFruitTreeFlags"), sym8.getPlayerDataAddress("wFruitTreeFlags"), flag_array(NUM_FRUIT_TREES_V7));
+	copyDataBlock(sd, sym::v7::wFruitTreeFlags_PlayerData, sym::v8::wFruitTreeFlags_PlayerData, flag_array(NUM_FRUIT_TREES_V7));
 
 	// clear 19 bytes after wFruitTreeFlags
 	js_info << "Clear 19 bytes after wFruitTreeFlags..." << std::endl;
-	clearDataBlock(sd, sym8.getPlayerDataAddress("wFruitTreeFlags") + flag_array(NUM_FRUIT_TREES_V8), 19);
+	clearDataBlock(sd, sym::v8::wFruitTreeFlags_PlayerData + flag_array(NUM_FRUIT_TREES_V8), 19);
 
 	// Clear wNuzlockeLandmarkFlags
 	js_info <<  "Clear wNuzlockeLandmarkFlags..." << std::endl;
@@ -396,21 +384,21 @@ bool patchVersion7to8(SaveBinary& save7, SaveBinary& save8) {
 
 	// Clear from [wHiddenGrottoContents, wCurHiddenGrotto]
 	js_info <<  "Clear from [wHiddenGrottoContents, wCurHiddenGrotto]" << std::endl;
-	clearDataBlock(sd, sym8.getPlayerDataAddress("wHiddenGrottoContents"), sym8.getPlayerDataAddress("wCurHiddenGrotto") + 1 - sym8.getPlayerDataAddress("wHiddenGrottoContents"));
+	clearDataBlock(sd, sym::v8::wHiddenGrottoContents_PlayerData, sym::v8::wCurHiddenGrotto_PlayerData + 1 - sym::v8::wHiddenGrottoContents_PlayerData);
 
 	// copy from [wLuckyNumberDayBuffer, wPhoneList)
 	js_info <<  "Copy from [wLuckyNumberDayBuffer, wPhoneList)" << std::endl;
-	copyDataBlock(sd, sym7.getPlayerDataAddress("wLuckyNumberDayBuffer"), sym8.getPlayerDataAddress("wLuckyNumberDayBuffer"), sym7.getPlayerDataAddress("wPhoneList") - sym7.getPlayerDataAddress("wLuckyNumberDayBuffer"));
+	copyDataBlock(sd, sym::v7::wLuckyNumberDayBuffer_PlayerData, sym::v8::wLuckyNumberDayBuffer_PlayerData, sym::v7::wPhoneList_PlayerData - sym::v7::wLuckyNumberDayBuffer_PlayerData);
 
 	// Clear v8 wPhoneList
 	js_info <<  "Clear wPhoneList..." << std::endl;
-	clearDataBlock(sd, sym8.getPlayerDataAddress("wPhoneList"), flag_array(NUM_PHONE_CONTACTS_V8));
+	clearDataBlock(sd, sym::v8::wPhoneList_PlayerData, flag_array(NUM_PHONE_CONTACTS_V8));
 
 	// wPhoneList has been converted to a bit flag array in version 8.
 	// for each byte in v7 up to CONTACT_LIST_SIZE_V7, if the byte is non-zero, set the corresponding bit in v8
 	js_info <<  "Patching wPhoneList..." << std::endl;
-	it7.seek(sym7.getPlayerDataAddress("wPhoneList"));
-	it8.seek(sym8.getPlayerDataAddress("wPhoneList"));
+	it7.seek(sym::v7::wPhoneList_PlayerData);
+	it8.seek(sym::v8::wPhoneList_PlayerData);
 	for (int i = 0; i < CONTACT_LIST_SIZE_V7; i++) {
 		// check if the byte is non-zero
 		if (it7.getByte() != 0x00) {
@@ -421,32 +409,32 @@ bool patchVersion7to8(SaveBinary& save7, SaveBinary& save8) {
 			// seek to the byte containing the bit
 			contactIndexV8--; // bit index starts at 0 not 1
 			// set the bit
-			setFlagBit(it8, sym8.getPlayerDataAddress("wPhoneList"), contactIndexV8);
+			setFlagBit(it8, sym::v8::wPhoneList_PlayerData, contactIndexV8);
 		}
 		it7.next();
 	}
 
 	// clear unused byte after wPhoneList (wPhoneListEnd)
 	js_info << "Clear unused byte after wPhoneList..." << std::endl;
-	it8.setByte(sym8.getPlayerDataAddress("wPhoneListEnd"), 0x00);
+	it8.setByte(sym::v8::wPhoneListEnd_PlayerData, 0x00);
 
 	// copy from [wParkBallsRemaining, wPlayerDataEnd)
 	js_info <<  "Copy from [wParkBallsRemaining, wPlayerDataEnd)" << std::endl;
-	copyDataBlock(sd, sym7.getPlayerDataAddress("wParkBallsRemaining"), sym8.getPlayerDataAddress("wParkBallsRemaining"), sym7.getPlayerDataAddress("wPlayerDataEnd") - sym7.getPlayerDataAddress("wParkBallsRemaining"));
+	copyDataBlock(sd, sym::v7::wParkBallsRemaining_PlayerData, sym::v8::wParkBallsRemaining_PlayerData, sym::v7::wPlayerDataEnd_PlayerData - sym::v7::wParkBallsRemaining_PlayerData);
 
 	// clear wVisitedSpawns in v8 before patching
 	js_info <<  "Clear wVisitedSpawns..." << std::endl;
-	clearDataBlock(sd, sym8.getMapDataAddress("wVisitedSpawns"), flag_array(NUM_SPAWNS_V8));
+	clearDataBlock(sd, sym::v8::wVisitedSpawns_MapData, flag_array(NUM_SPAWNS_V8));
 
 	// wVisitedSpawns is a flag_array of NUM_SPAWNS bits. If v7 bit is set, lookup the bit index in the map and set the corresponding bit in v8
 	js_info <<  "Patching wVisitedSpawns..." << std::endl;
-	it7.seek(sym7.getMapDataAddress("wVisitedSpawns"));
-	it8.seek(sym8.getMapDataAddress("wVisitedSpawns"));
+	it7.seek(sym::v7::wVisitedSpawns_MapData);
+	it8.seek(sym::v8::wVisitedSpawns_MapData);
 	// print current address
 	js_info <<  "Current Address: " << std::hex << it7.getAddress() << std::endl;
 	for (int i = 0; i < NUM_SPAWNS_V7; i++) {
 		// check if the bit is set
-		if (isFlagBitSet(it7, sym7.getMapDataAddress("wVisitedSpawns"), i)) {
+		if (isFlagBitSet(it7, sym::v7::wVisitedSpawns_MapData, i)) {
 			// get the spawn index is equal to the bit index
 			uint8_t spawnIndex = i;
 			// map the version 7 spawn to the version 8 spawn
@@ -458,341 +446,323 @@ bool patchVersion7to8(SaveBinary& save7, SaveBinary& save8) {
 					js_info <<  "Spawn " << std::hex << static_cast<int>(spawnIndex) << " converted to " << std::hex << static_cast<int>(spawnIndexV8) << std::endl;
 				}
 				// set the bit
-				setFlagBit(it8, sym8.getMapDataAddress("wVisitedSpawns"), spawnIndexV8);
+				setFlagBit(it8, sym::v8::wVisitedSpawns_MapData, spawnIndexV8);
 			}
 		}
 	}
 
 	// Copy from [wDigWarpNumber, wCurMapDataEnd)
 	js_info <<  "Copy from [wDigWarpNumber, wCurMapDataEnd)" << std::endl;
-	copyDataBlock(sd, sym7.getMapDataAddress("wDigWarpNumber"), sym8.getMapDataAddress("wDigWarpNumber"), sym7.getMapDataAddress("wCurMapDataEnd") - sym7.getMapDataAddress("wDigWarpNumber"));
+	copyDataBlock(sd, sym::v7::wDigWarpNumber_MapData, sym::v8::wDigWarpNumber_MapData, sym::v7::wCurMapDataEnd_MapData - sym::v7::wDigWarpNumber_MapData);
 
-	mapAndWriteMapGroupNumber(sd, sym7.getMapDataAddress("wDigMapGroup"), sym8.getMapDataAddress("wDigMapGroup"), sym7.getMapDataAddress("wDigMapNumber"), sym8.getMapDataAddress("wDigMapNumber"), "wDigMap");
-	mapAndWriteMapGroupNumber(sd, sym7.getMapDataAddress("wBackupMapGroup"), sym8.getMapDataAddress("wBackupMapGroup"), sym7.getMapDataAddress("wBackupMapNumber"), sym8.getMapDataAddress("wBackupMapNumber"), "wBackupMap");
-	mapAndWriteMapGroupNumber(sd, sym7.getMapDataAddress("wLastSpawnMapGroup"), sym8.getMapDataAddress("wLastSpawnMapGroup"), sym7.getMapDataAddress("wLastSpawnMapNumber"), sym8.getMapDataAddress("wLastSpawnMapNumber"), "wLastSpawnMap");
-	mapAndWriteMapGroupNumber(sd, sym7.getMapDataAddress("wMapGroup"), sym8.getMapDataAddress("wMapGroup"), sym7.getMapDataAddress("wMapNumber"), sym8.getMapDataAddress("wMapNumber"), "wMap");
+	mapAndWriteMapGroupNumber(sd, sym::v7::wDigMapGroup_MapData, sym::v8::wDigMapGroup_MapData, sym::v7::wDigMapNumber_MapData, sym::v8::wDigMapNumber_MapData, "wDigMap");
+	mapAndWriteMapGroupNumber(sd, sym::v7::wBackupMapGroup_MapData, sym::v8::wBackupMapGroup_MapData, sym::v7::wBackupMapNumber_MapData, sym::v8::wBackupMapNumber_MapData, "wBackupMap");
+	mapAndWriteMapGroupNumber(sd, sym::v7::wLastSpawnMapGroup_MapData, sym::v8::wLastSpawnMapGroup_MapData, sym::v7::wLastSpawnMapNumber_MapData, sym::v8::wLastSpawnMapNumber_MapData, "wLastSpawnMap");
+	mapAndWriteMapGroupNumber(sd, sym::v7::wMapGroup_MapData, sym::v8::wMapGroup_MapData, sym::v7::wMapNumber_MapData, sym::v8::wMapNumber_MapData, "wMap");
 
 	// Copy wPartyCount
 	js_info <<  "Copy wPartyCount..." << std::endl;
-	copyDataByte(sd, sym7.getPokemonDataAddress("wPartyCount"), sym8.getPokemonDataAddress("wPartyCount"));
+	copyDataByte(sd, sym::v7::wPartyCount_PokemonData, sym::v8::wPartyCount_PokemonData);
 
 	// clear 7 unused bytes after wPartyCount
 	js_info << "Clear 7 unused bytes after wPartyCount..." << std::endl;
-	clearDataBlock(sd, sym8.getPokemonDataAddress("wPartyCount") + 1, 7);
+	clearDataBlock(sd, sym::v8::wPartyCount_PokemonData + 1, 7);
 
 	// copy wPartyMons sizeof(party_struct_v7) * PARTY_LENGTH
 	js_info <<  "Copy wPartyMons..." << std::endl;
-	copyDataBlock(sd, sym7.getPokemonDataAddress("wPartyMons"), sym8.getPokemonDataAddress("wPartyMons"), sizeof(party_struct_v8) * PARTY_LENGTH);
+	copyDataBlock(sd, sym::v7::wPartyMons_PokemonData, sym::v8::wPartyMons_PokemonData, sizeof(party_struct_v8) * PARTY_LENGTH);
 
-	party_struct_v8 partymon;
 	// fix the party mons
 	js_info <<  "Fix party mons..." << std::endl;
 	for (int i = 0; i < PARTY_LENGTH; i++) {
-		uint16_t species = it8.getByte(sym8.getPokemonDataAddress("wPartyMons") + i * sizeof(party_struct_v8));
+		uint16_t species = it8.getByte(sym::v8::wPartyMons_PokemonData + i * sizeof(party_struct_v8));
 		if (species == 0x00) {
 			continue;
 		}
-		partymon = convertPartyV7toV8(loadStruct<party_struct_v8>(it8, sym8.getPokemonDataAddress("wPartyMons") + i * sizeof(party_struct_v8)), seen_mons, caught_mons);
-		writeStruct<party_struct_v8>(it8, sym8.getPokemonDataAddress("wPartyMons") + i * sizeof(party_struct_v8), partymon);
+		StructRef<party_struct_v8> partymonRef(save8, sym::v8::wPartyMons_PokemonData + i * sizeof(party_struct_v8));
+		partymonRef.store(convertPartyV7toV8(partymonRef.load(), seen_mons, caught_mons));
 	}
 
 	// copy wPartyMonOTs
 	js_info <<  "Copy wPartyMonOTs..." << std::endl;
-	copyDataBlock(sd, sym7.getPokemonDataAddress("wPartyMonOTs"), sym8.getPokemonDataAddress("wPartyMonOTs"), PARTY_LENGTH * (PLAYER_NAME_LENGTH + 3));
+	copyDataBlock(sd, sym::v7::wPartyMonOTs_PokemonData, sym::v8::wPartyMonOTs_PokemonData, PARTY_LENGTH * (PLAYER_NAME_LENGTH + 3));
 
 	// copy wPartyMonNicknames PARTY_LENGTH * MON_NAME_LENGTH
 	js_info <<  "Copy wPartyMonNicknames..." << std::endl;
-	copyDataBlock(sd, sym7.getPokemonDataAddress("wPartyMonNicknames"), sym8.getPokemonDataAddress("wPartyMonNicknames"), MON_NAME_LENGTH * PARTY_LENGTH);
+	copyDataBlock(sd, sym::v7::wPartyMonNicknames_PokemonData, sym::v8::wPartyMonNicknames_PokemonData, MON_NAME_LENGTH * PARTY_LENGTH);
 
 	// clear unused byte after wPartyMonNicknames
 	js_info << "Clear unused byte after wPartyMonNicknames..." << std::endl;
-	it8.setByte(sym8.getPokemonDataAddress("wPartyMonNicknamesEnd"), 0x00);
+	it8.setByte(sym::v8::wPartyMonNicknamesEnd_PokemonData, 0x00);
 
 	// We will convert the pokedex caught flags last as we need the full list of caught mons
 
 	// clear unused byte after wPokedexCaught
 	js_info << "Clear unused byte after wPok*dexCaught..." << std::endl;
-	it8.setByte(sym8.getPokemonDataAddress("wEndPokedexCaught"), 0x00);
+	it8.setByte(sym::v8::wEndPokedexCaught_PokemonData, 0x00);
 
 	// We will convert the pokedex seen flags last as we need the full list of seen mons
 
 	// clear unused byte after wPokedexSeen
 	js_info << "Clear unused byte after wPok*dexSeen..." << std::endl;
-	it8.setByte(sym8.getPokemonDataAddress("wEndPokedexSeen"), 0x00);
+	it8.setByte(sym::v8::wEndPokedexSeen_PokemonData, 0x00);
 
 	// copy wUnlockedUnowns
 	js_info <<  "Copy wUnlockedUnowns..." << std::endl;
-	copyDataByte(sd, sym7.getPokemonDataAddress("wUnlockedUnowns"), sym8.getPokemonDataAddress("wUnlockedUnowns"));
+	copyDataByte(sd, sym::v7::wUnlockedUnowns_PokemonData, sym::v8::wUnlockedUnowns_PokemonData);
 
 	// clear 2 unused bytes after wUnlockedUnowns
 	js_info << "Clear 2 unused bytes after wUnlockedUnowns..." << std::endl;
-	clearDataBlock(sd, sym8.getPokemonDataAddress("wUnlockedUnowns") + 1, 2);
+	clearDataBlock(sd, sym::v8::wUnlockedUnowns_PokemonData + 1, 2);
 
 	// Copy from [wDayCareMan, wBreedMon2 + sizeof(breed_struct_mon)
 	js_info <<  "Copy [wDayCareMan, wBreedMon2 + sizeof(breed_struct_mon)" << std::endl;
-	copyDataBlock(sd, sym7.getPokemonDataAddress("wDayCareMan"), sym8.getPokemonDataAddress("wDayCareMan"), sym7.getPokemonDataAddress("wBreedMon2") + sizeof(breedmon_struct_v8) - sym7.getPokemonDataAddress("wDayCareMan"));
+	copyDataBlock(sd, sym::v7::wDayCareMan_PokemonData, sym::v8::wDayCareMan_PokemonData, sym::v7::wBreedMon2_PokemonData + sizeof(breedmon_struct_v8) - sym::v7::wDayCareMan_PokemonData);
 
-	breedmon_struct_v8 breedmon;
 	// fix and copy wBreedMon1
 	js_info <<  "fix and copy wBreedMon1..." << std::endl;
-	uint16_t species = it8.getByte(sym8.getPokemonDataAddress("wBreedMon1Species"));
+	uint16_t species = it8.getByte(sym::v8::wBreedMon1Species_PokemonData);
 	if (species != 0x00) {
-		breedmon = convertBreedmonV7toV8(loadStruct<breedmon_struct_v8>(it8, sym8.getPokemonDataAddress("wBreedMon1")), seen_mons, caught_mons);
-		writeStruct<breedmon_struct_v8>(it8, sym8.getPokemonDataAddress("wBreedMon1"), breedmon);
+		StructRef<breedmon_struct_v8> breedmonRef(save8, sym::v8::wBreedMon1_PokemonData);
+		breedmonRef.store(convertBreedmonV7toV8(breedmonRef.load(), seen_mons, caught_mons));
 	}
 
 	// fix wBreedMon2...
 	js_info <<  "Fix wBreedMon2Species..." << std::endl;
-	species = it8.getByte(sym8.getPokemonDataAddress("wBreedMon2Species"));
+	species = it8.getByte(sym::v8::wBreedMon2Species_PokemonData);
 	if (species != 0x00) {
-		breedmon = convertBreedmonV7toV8(loadStruct<breedmon_struct_v8>(it8, sym8.getPokemonDataAddress("wBreedMon2")), seen_mons, caught_mons);
-		writeStruct<breedmon_struct_v8>(it8, sym8.getPokemonDataAddress("wBreedMon2"), breedmon);
+		StructRef<breedmon_struct_v8> breedmonRef(save8, sym::v8::wBreedMon2_PokemonData);
+		breedmonRef.store(convertBreedmonV7toV8(breedmonRef.load(), seen_mons, caught_mons));
 	}
 
 	// Clear from [wLevelUpMonNickname to wBugContestBackupPartyCount)
 	js_info <<  "Clear from [wLevelUpMonNickname to wBugContestBackupPartyCount)" << std::endl;
-	clearDataBlock(sd, sym8.getPokemonDataAddress("wLevelUpMonNickname"), sym8.getPokemonDataAddress("wBugContestBackupPartyCount") - sym8.getPokemonDataAddress("wLevelUpMonNickname"));
+	clearDataBlock(sd, sym::v8::wLevelUpMonNickname_PokemonData, sym::v8::wBugContestBackupPartyCount_PokemonData - sym::v8::wLevelUpMonNickname_PokemonData);
 
 	// Clear wBugContestBackupPartyCount
 	js_info <<  "Clear wBugContestBackupPartyCount..." << std::endl;
-	it8.setByte(sym8.getPokemonDataAddress("wBugContestBackupPartyCount"), 0x00);
+	it8.setByte(sym::v8::wBugContestBackupPartyCount_PokemonData, 0x00);
 
 	// copy from wContestMon to wPokemonDataEnd
 	js_info <<  "Copy from wContestMon to w****monDataEnd..." << std::endl;
-	copyDataBlock(sd, sym7.getPokemonDataAddress("wContestMon"), sym8.getPokemonDataAddress("wContestMon"), sym7.getPokemonDataAddress("wPokemonDataEnd") - sym7.getPokemonDataAddress("wContestMon"));
+	copyDataBlock(sd, sym::v7::wContestMon_PokemonData, sym::v8::wContestMon_PokemonData, sym::v7::wPokemonDataEnd_PokemonData - sym::v7::wContestMon_PokemonData);
 
 	// fix wContestMonSpecies and wContestMonExtSpecies
 	js_info <<  "Fix wContestMon..." << std::endl;
-	species = it8.getByte(sym8.getPokemonDataAddress("wContestMonSpecies"));
+	species = it8.getByte(sym::v8::wContestMonSpecies_PokemonData);
 	if (species != 0x00) {
-		partymon = convertPartyV7toV8(loadStruct<party_struct_v8>(it8, sym8.getPokemonDataAddress("wContestMon")), seen_mons, caught_mons);
-		writeStruct<party_struct_v8>(it8, sym8.getPokemonDataAddress("wContestMon"), partymon);
+		StructRef<party_struct_v8> partymonRef(save8, sym::v8::wContestMon_PokemonData);
+		partymonRef.store(convertPartyV7toV8(partymonRef.load(), seen_mons, caught_mons));
 	}
 
-	mapAndWriteMapGroupNumber(sd, sym7.getPokemonDataAddress("wDunsparceMapGroup"), sym8.getPokemonDataAddress("wDunsparceMapGroup"), sym7.getPokemonDataAddress("wDunsparceMapNumber"), sym8.getPokemonDataAddress("wDunsparceMapNumber"), "wDunsp****");
+	mapAndWriteMapGroupNumber(sd, sym::v7::wDunsparceMapGroup_PokemonData, sym::v8::wDunsparceMapGroup_PokemonData, sym::v7::wDunsparceMapNumber_PokemonData, sym::v8::wDunsparceMapNumber_PokemonData, "wDunsp****");
 
 	roam_struct_v8 roammon;
 	js_info << "Fix wRoamMon1..." << std::endl;
-	species = it8.getByte(sym8.getPokemonDataAddress("wRoamMon1Species"));
+	species = it8.getByte(sym::v8::wRoamMon1Species_PokemonData);
 	if (species != 0x00) {
 		js_info << "wRoamMon1Species is 0x" << std::hex << static_cast<int>(species) << " converting struct" << std::endl;
-		roammon = convertRoamV7toV8(loadStruct<roam_struct_v8>(it8, sym8.getPokemonDataAddress("wRoamMon1")));
-		writeStruct<roam_struct_v8>(it8, sym8.getPokemonDataAddress("wRoamMon1"), roammon);
+		StructRef<roam_struct_v8> roammonRef(save8, sym::v8::wRoamMon1_PokemonData);
+		roammonRef.store(convertRoamV7toV8(roammonRef.load()));
 	}
 	else {
 		js_info << "wRoamMon1Species is 0x00, setting map to -1, -1" << std::endl;
-		roammon = loadStruct<roam_struct_v8>(it8, sym8.getPokemonDataAddress("wRoamMon1"));
+		StructRef<roam_struct_v8> roammonRef(save8, sym::v8::wRoamMon1_PokemonData);
+		roammon = roammonRef.load();
 		roammon.setMap(std::tuple <uint8_t, uint8_t>(-1, -1));
-		writeStruct<roam_struct_v8>(it8, sym8.getPokemonDataAddress("wRoamMon1"), roammon);
+		roammonRef.store(roammon);
 	}
 
 	js_info << "Fix wRoamMon2..." << std::endl;
-	species = it8.getByte(sym8.getPokemonDataAddress("wRoamMon2Species"));
+	species = it8.getByte(sym::v8::wRoamMon2Species_PokemonData);
 	if (species != 0x00) {
 		js_info << "wRoamMon2Species is 0x" << std::hex << static_cast<int>(species) << " converting struct" << std::endl;
-		roammon = convertRoamV7toV8(loadStruct<roam_struct_v8>(it8, sym8.getPokemonDataAddress("wRoamMon2")));
-		writeStruct<roam_struct_v8>(it8, sym8.getPokemonDataAddress("wRoamMon2"), roammon);
+		StructRef<roam_struct_v8> roammonRef(save8, sym::v8::wRoamMon2_PokemonData);
+		roammonRef.store(convertRoamV7toV8(roammonRef.load()));
 	}
 	else {
 		js_info << "wRoamMon2Species is 0x00, setting map to -1, -1" << std::endl;
-		roammon = loadStruct<roam_struct_v8>(it8, sym8.getPokemonDataAddress("wRoamMon2"));
+		StructRef<roam_struct_v8> roammonRef(save8, sym::v8::wRoamMon2_PokemonData);
+		roammon = roammonRef.load();
 		roammon.setMap(std::tuple <uint8_t, uint8_t>(-1, -1));
-		writeStruct<roam_struct_v8>(it8, sym8.getPokemonDataAddress("wRoamMon2"), roammon);
+		roammonRef.store(roammon);
 	}
 
 	js_info << "Fix wRoamMon3..." << std::endl;
-	species = it8.getByte(sym8.getPokemonDataAddress("wRoamMon3Species"));
+	species = it8.getByte(sym::v8::wRoamMon3Species_PokemonData);
 	if (species != 0x00) {
 		js_info << "wRoamMon3Species is 0x" << std::hex << static_cast<int>(species) << " converting struct" << std::endl;
-		roammon = convertRoamV7toV8(loadStruct<roam_struct_v8>(it8, sym8.getPokemonDataAddress("wRoamMon3")));
-		writeStruct<roam_struct_v8>(it8, sym8.getPokemonDataAddress("wRoamMon3"), roammon);
+		StructRef<roam_struct_v8> roammonRef(save8, sym::v8::wRoamMon3_PokemonData);
+		roammonRef.store(convertRoamV7toV8(roammonRef.load()));
 	} else {
 		js_info << "wRoamMon3Species is 0x00, setting map to -1, -1" << std::endl;
-		roammon = loadStruct<roam_struct_v8>(it8, sym8.getPokemonDataAddress("wRoamMon3"));
+		StructRef<roam_struct_v8> roammonRef(save8, sym::v8::wRoamMon3_PokemonData);
+		roammon = roammonRef.load();
 		roammon.setMap(std::tuple <uint8_t, uint8_t>(-1, -1));
-		writeStruct<roam_struct_v8>(it8, sym8.getPokemonDataAddress("wRoamMon3"), roammon);
+		roammonRef.store(roammon);
 	}
 
 	// clear 4 unused bytes after wRoamMon3
 	js_info << "Clear 4 unused bytes after wRoamMon3..." << std::endl;
-	clearDataBlock(sd, sym8.getPokemonDataAddress("wRoamMon3") + sizeof(roammon), 4);
+	clearDataBlock(sd, sym::v8::wRoamMon3_PokemonData + sizeof(roammon), 4);
 
 	// fix wRegisteredItems...
 	js_info << "Fix wRegisteredItems..." << std::endl;
 	for (int i = 0; i < 4; i++) {
-		uint8_t item = it8.getByte(sym8.getPokemonDataAddress("wRegisteredItems") + i);
+		uint8_t item = it8.getByte(sym::v8::wRegisteredItems_PokemonData + i);
 		if (item == 0x00) { continue; }
 		item = mapV7KeyItemToV8(item - 1);
 		if (item != 0xFF) {
-			it8.setByte(sym8.getPokemonDataAddress("wRegisteredItems") + i, item);
+			it8.setByte(sym::v8::wRegisteredItems_PokemonData + i, item);
 		} else {
-			js_warning << "Registered Item " << std::hex << static_cast<int>(it8.getByte(sym8.getPokemonDataAddress("wRegisteredItems") + i)) << " not found in version 8 key item list." << std::endl;
-			it8.setByte(sym8.getPokemonDataAddress("wRegisteredItems") + i, 0x00);
+			js_warning << "Registered Item " << std::hex << static_cast<int>(it8.getByte(sym::v8::wRegisteredItems_PokemonData + i)) << " not found in version 8 key item list." << std::endl;
+			it8.setByte(sym::v8::wRegisteredItems_PokemonData + i, 0x00);
 		}
 	}
 
 	// copy sCheckValue2
 	js_info <<  "Copy sCheckValue2..." << std::endl;
-	copyDataByte(sd, sym7.getSRAMAddress("sCheckValue2"), sym8.getSRAMAddress("sCheckValue2"));
+	copyDataByte(sd, sym::v7::sCheckValue2_SRAM, sym::v8::sCheckValue2_SRAM);
 
 	// copy it8 Save to it8 Backup Save
 	js_info <<  "Copy Main Save to Backup Save..." << std::endl;
-	for (int i = 0; i < sym8.getSRAMAddress("sCheckValue2") + 1 - sym8.getSRAMAddress("sOptions"); i++) {
-		save8.setByte(sym8.getSRAMAddress("sBackupOptions") + i, save8.getByte(sym8.getSRAMAddress("sOptions") + i));
-	}
+	save8.copyBytes(sym::v8::sBackupOptions_SRAM, save8, sym::v8::sOptions_SRAM, sym::v8::sCheckValue2_SRAM + 1 - sym::v8::sOptions_SRAM);
 
 	// copy from sHallOfFame to sHallOfFameEnd
 	js_info <<  "Copy from sHallOfFame to sHallOfFameEnd..." << std::endl;
-	copyDataBlock(sd, sym7.getSRAMAddress("sHallOfFame"), sym8.getSRAMAddress("sHallOfFame"), sym8.getSRAMAddress("sHallOfFameEnd") - sym8.getSRAMAddress("sHallOfFame"));
+	copyDataBlock(sd, sym::v7::sHallOfFame_SRAM, sym::v8::sHallOfFame_SRAM, sym::v8::sHallOfFameEnd_SRAM - sym::v8::sHallOfFame_SRAM);
 
-	hofmon_struct_v8 hofmon;
 	// fix the hall of fame mon species
 	js_info <<  "Fix hall of fame mon..." << std::endl;
 	for (int i = 0; i < NUM_HOF_TEAMS_V8; i++) {
 		for (int j = 0; j < PARTY_LENGTH; j++){
-			it8.seek(sym8.getSRAMAddress("sHallOfFame01Mon1") + i * HOF_LENGTH);
+			it8.seek(sym::v8::sHallOfFame01Mon1_SRAM + i * HOF_LENGTH);
 			uint16_t species = it8.getByte(it8.getAddress() + j * sizeof(hofmon_struct_v8));
 			if (species == 0x00) {
 				continue;
 			}
-			hofmon = convertHofmonV7toV8(loadStruct<hofmon_struct_v8>(it8, sym8.getSRAMAddress("sHallOfFame01Mon1") + i * HOF_LENGTH + j * sizeof(hofmon_struct_v8)), seen_mons, caught_mons);
-			writeStruct<hofmon_struct_v8>(it8, sym8.getSRAMAddress("sHallOfFame01Mon1") + i * HOF_LENGTH + j * sizeof(hofmon_struct_v8), hofmon);
+			StructRef<hofmon_struct_v8> hofmonRef(save8, sym::v8::sHallOfFame01Mon1_SRAM + i * HOF_LENGTH + j * sizeof(hofmon_struct_v8));
+			hofmonRef.store(convertHofmonV7toV8(hofmonRef.load(), seen_mons, caught_mons));
 		}
 	}
 
+	// wPokedexCaught and wPokedexSeen bit i is the Pokémon with index i + 1
+	static const FlagRemap pokedexRemap(NUM_POKEMON_V7, NUM_UNIQUE_POKEMON_V8, [](uint32_t pokemonIndex) {
+		uint16_t pokemonIndexV8 = mapV7PkmnToV8(pokemonIndex + 1);
+		return pokemonIndexV8 != INVALID_SPECIES ? pokemonIndexV8 - 1u : FlagRemap::DROPPED;
+	});
+
 	// clear wPokedexCaught in v8 before patching
 	js_info << "Clear w****dexCaught..." << std::endl;
-	clearDataBlock(sd, sym8.getPokemonDataAddress("wPokedexCaught"), flag_array(NUM_UNIQUE_POKEMON_V8));
+	clearDataBlock(sd, sym::v8::wPokedexCaught_PokemonData, flag_array(NUM_UNIQUE_POKEMON_V8));
 
 
 	// wPokedexCaught is a flag_array of NUM_POKEMON_V7 bits. If v7 bit is set, lookup the bit index in the map and set the corresponding bit in v8
 	js_info <<  "Patching w****dexCaught..." << std::endl;
-	it7.seek(sym7.getPokemonDataAddress("wPokedexCaught"));
-	it8.seek(sym8.getPokemonDataAddress("wPokedexCaught"));
-	for (int i = 0; i < NUM_POKEMON_V7; i++) {
-		// check if the bit is set
-		if (isFlagBitSet(it7, sym7.getPokemonDataAddress("wPokedexCaught"), i)) {
-			// get the pokemon index is equal to the bit index
-			uint16_t pokemonIndex = i + 1;
-			// map the version 7 pokemon to the version 8 pokemon
-			uint16_t pokemonIndexV8 = mapV7PkmnToV8(pokemonIndex) - 1;
-			// if the pokemon is found set the corresponding bit in it8
-			if (pokemonIndexV8 != INVALID_SPECIES) {
-				// print found pokemonv7 and converted pokemonv8
-				if (pokemonIndex != pokemonIndexV8 + 1){
-					js_info <<  "dex Caught Mon " << std::hex << static_cast<int>(pokemonIndex) << " converted to " << std::hex << static_cast<int>(pokemonIndexV8) << std::endl;
-				}
-				// set the bit
-				setFlagBit(it8, sym8.getPokemonDataAddress("wPokedexCaught"), pokemonIndexV8);
-			}
-		}
-	}
-	// for each caught mon in vector caught_mons, set the corresponding bit in it8
+	FlagArrayView pokedexCaught7(save7, sym::v7::wPokedexCaught_PokemonData, NUM_POKEMON_V7);
+	FlagArrayView pokedexCaught8(sym::v8::wPokedexCaught_PokemonData, NUM_UNIQUE_POKEMON_V8);
+	pokedexRemap.apply(pokedexCaught7, pokedexCaught8, [](uint32_t pokemonIndex, uint32_t pokemonIndexV8) {
+		// print found pokemonv7 and converted pokemonv8
+		js_info <<  "dex Caught Mon " << std::hex << static_cast<int>(pokemonIndex + 1) << " converted to " << std::hex << static_cast<int>(pokemonIndexV8) << std::endl;
+	});
+	// for each caught mon in vector caught_mons, set the corresponding bit in v8. Empty mons (species 0)
+	// and species past the dex have no bit, don't write them past the end of the array.
 	for (uint16_t mon : caught_mons){
-		uint16_t monIndexV8 = mon - 1;
-		if (!isFlagBitSet(it8, sym8.getPokemonDataAddress("wPokedexCaught"), monIndexV8)) {
-			setFlagBit(it8, sym8.getPokemonDataAddress("wPokedexCaught"), monIndexV8);
+		if (mon == 0 || mon > NUM_UNIQUE_POKEMON_V8) {
+			continue;
+		}
+		if (pokedexCaught8.set(mon - 1)) {
 			js_info << "Found caught mon " << std::hex << static_cast<int>(mon) << std::endl;
 		}
 	}
+	pokedexCaught8.store(save8);
 
 	// clear wPokedexSeen in v8 before patching
 	js_info << "Clear w****dexSeen..." << std::endl;
-	clearDataBlock(sd, sym8.getPokemonDataAddress("wPokedexSeen"), flag_array(NUM_UNIQUE_POKEMON_V8));
+	clearDataBlock(sd, sym::v8::wPokedexSeen_PokemonData, flag_array(NUM_UNIQUE_POKEMON_V8));
 
 	// wPokedexSeen is a flag_array of NUM_POKEMON_V7 bits. If v7 bit is set, lookup the bit index in the map and set the corresponding bit in v8
 	js_info <<  "Patching w****dexSeen..." << std::endl;
-	it7.seek(sym7.getPokemonDataAddress("wPokedexSeen"));
-	it8.seek(sym8.getPokemonDataAddress("wPokedexSeen"));
-	for (int i = 0; i < NUM_POKEMON_V7; i++) {
-		// check if the bit is set
-		if (isFlagBitSet(it7, sym7.getPokemonDataAddress("wPokedexSeen"), i)) {
-			// get the pokemon index is equal to the bit index
-			uint16_t pokemonIndex = i + 1;
-			// map the version 7 pokemon to the version 8 pokemon
-			uint16_t pokemonIndexV8 = mapV7PkmnToV8(pokemonIndex) - 1;
-			// if the pokemon is found set the corresponding bit in it8
-			if (pokemonIndexV8 != INVALID_SPECIES) {
-				// print found pokemonv7 and converted pokemonv8
-				if (pokemonIndex != pokemonIndexV8 + 1){
-					js_info <<  "Dex Seen Mon " << std::hex << static_cast<int>(pokemonIndex) << " converted to " << std::hex << static_cast<int>(pokemonIndexV8) << std::endl;
-				}
-				// set the bit
-				setFlagBit(it8, sym8.getPokemonDataAddress("wPokedexSeen"), pokemonIndexV8);
-			}
-		}
-	}
-	// for each seen mon in vector seen_mons, set the corresponding bit in it8
+	FlagArrayView pokedexSeen7(save7, sym::v7::wPokedexSeen_PokemonData, NUM_POKEMON_V7);
+	FlagArrayView pokedexSeen8(sym::v8::wPokedexSeen_PokemonData, NUM_UNIQUE_POKEMON_V8);
+	pokedexRemap.apply(pokedexSeen7, pokedexSeen8, [](uint32_t pokemonIndex, uint32_t pokemonIndexV8) {
+		// print found pokemonv7 and converted pokemonv8
+		js_info <<  "Dex Seen Mon " << std::hex << static_cast<int>(pokemonIndex + 1) << " converted to " << std::hex << static_cast<int>(pokemonIndexV8) << std::endl;
+	});
+	// for each seen mon in vector seen_mons, set the corresponding bit in v8. Empty mons (species 0)
+	// and species past the dex have no bit, don't write them past the end of the array.
 	for (uint16_t mon : seen_mons){
-		uint16_t monIndexV8 = mon - 1;
-		if (!isFlagBitSet(it8, sym8.getPokemonDataAddress("wPokedexSeen"), monIndexV8)) {
-			setFlagBit(it8, sym8.getPokemonDataAddress("wPokedexSeen"), monIndexV8);
+		if (mon == 0 || mon > NUM_UNIQUE_POKEMON_V8) {
+			continue;
+		}
+		if (pokedexSeen8.set(mon - 1)) {
 			js_info << "Found seen mon " << std::hex << static_cast<int>(mon) << std::endl;
 		}
 	}
+	pokedexSeen8.store(save8);
 
 	// Clear wPlayerCaught and wPlayerCaught2
 	js_info << "Clear wPlayerCaught..." << std::endl;
-	it8.setByte(sym8.getPlayerDataAddress("wPlayerCaught"), 0x00);
-	it8.setByte(sym8.getPlayerDataAddress("wPlayerCaught2"), 0x00);
+	it8.setByte(sym::v8::wPlayerCaught_PlayerData, 0x00);
+	it8.setByte(sym::v8::wPlayerCaught2_PlayerData, 0x00);
 	// check if HO_OH_V8 is in caught_mons, if so set bit 0 in wPlayerCaught
 	if (std::find(caught_mons.begin(), caught_mons.end(), HO_OH_V8) != caught_mons.end()) {
-		setFlagBit(it8, sym8.getPlayerDataAddress("wPlayerCaught"), 0);
+		setFlagBit(it8, sym::v8::wPlayerCaught_PlayerData, 0);
 		js_info << "Found caught mon " << std::hex << static_cast<int>(HO_OH_V8) << std::endl;
 	}
 	// check if LUGIA_V8 is in caught_mons, if so set bit 1 in wPlayerCaught
 	if (std::find(caught_mons.begin(), caught_mons.end(), LUGIA_V8) != caught_mons.end()) {
-		setFlagBit(it8, sym8.getPlayerDataAddress("wPlayerCaught"), 1);
+		setFlagBit(it8, sym::v8::wPlayerCaught_PlayerData, 1);
 		js_info << "Found caught mon " << std::hex << static_cast<int>(LUGIA_V8) << std::endl;
 	}
 	// check if RAIKOU_V8 is in caught_mons, if so set bit 2 in wPlayerCaught
 	if (std::find(caught_mons.begin(), caught_mons.end(), RAIKOU_V8) != caught_mons.end()) {
-		setFlagBit(it8, sym8.getPlayerDataAddress("wPlayerCaught"), 2);
+		setFlagBit(it8, sym::v8::wPlayerCaught_PlayerData, 2);
 		js_info << "Found caught mon " << std::hex << static_cast<int>(RAIKOU_V8) << std::endl;
 	}
 	// check if ENTEI_V8 is in caught_mons, if so set bit 3 in wPlayerCaught
 	if (std::find(caught_mons.begin(), caught_mons.end(), ENTEI_V8) != caught_mons.end()) {
-		setFlagBit(it8, sym8.getPlayerDataAddress("wPlayerCaught"), 3);
+		setFlagBit(it8, sym::v8::wPlayerCaught_PlayerData, 3);
 		js_info << "Found caught mon " << std::hex << static_cast<int>(ENTEI_V8) << std::endl;
 	}
 	// check if SUICUNE_V8 is in caught_mons, if so set bit 4 in wPlayerCaught
 	if (std::find(caught_mons.begin(), caught_mons.end(), SUICUNE_V8) != caught_mons.end()) {
-		setFlagBit(it8, sym8.getPlayerDataAddress("wPlayerCaught"), 4);
+		setFlagBit(it8, sym::v8::wPlayerCaught_PlayerData, 4);
 		js_info << "Found caught mon " << std::hex << static_cast<int>(SUICUNE_V8) << std::endl;
 	}
 	// check if ARTICUNO_V8 is in caught_mons, if so set bit 5 in wPlayerCaught
 	if (std::find(caught_mons.begin(), caught_mons.end(), ARTICUNO_V8) != caught_mons.end()) {
-		setFlagBit(it8, sym8.getPlayerDataAddress("wPlayerCaught"), 5);
+		setFlagBit(it8, sym::v8::wPlayerCaught_PlayerData, 5);
 		js_info << "Found caught mon " << std::hex << static_cast<int>(ARTICUNO_V8) << std::endl;
 	}
 	// check if ZAPDOS_V8 is in caught_mons, if so set bit 6 in wPlayerCaught
 	if (std::find(caught_mons.begin(), caught_mons.end(), ZAPDOS_V8) != caught_mons.end()) {
-		setFlagBit(it8, sym8.getPlayerDataAddress("wPlayerCaught"), 6);
+		setFlagBit(it8, sym::v8::wPlayerCaught_PlayerData, 6);
 		js_info << "Found caught mon " << std::hex << static_cast<int>(ZAPDOS_V8) << std::endl;
 	}
 	// check if MOLTRES_V8 is in caught_mons, if so set bit 7 in wPlayerCaught
 	if (std::find(caught_mons.begin(), caught_mons.end(), MOLTRES_V8) != caught_mons.end()) {
-		setFlagBit(it8, sym8.getPlayerDataAddress("wPlayerCaught"), 7);
+		setFlagBit(it8, sym::v8::wPlayerCaught_PlayerData, 7);
 		js_info << "Found caught mon " << std::hex << static_cast<int>(MOLTRES_V8) << std::endl;
 	}
 	// check if MEW_V8 is in caught_mons, if so set bit 0 in wPlayerCaught2
 	if (std::find(caught_mons.begin(), caught_mons.end(), MEW_V8) != caught_mons.end()) {
-		setFlagBit(it8, sym8.getPlayerDataAddress("wPlayerCaught2"), 0);
+		setFlagBit(it8, sym::v8::wPlayerCaught2_PlayerData, 0);
 		js_info << "Found caught mon " << std::hex << static_cast<int>(MEW_V8) << std::endl;
 	}
 	// check if MEWTWO_V8 is in caught_mons, if so set bit 1 in wPlayerCaught2
 	if (std::find(caught_mons.begin(), caught_mons.end(), MEWTWO_V8) != caught_mons.end()) {
-		setFlagBit(it8, sym8.getPlayerDataAddress("wPlayerCaught2"), 1);
+		setFlagBit(it8, sym::v8::wPlayerCaught2_PlayerData, 1);
 		js_info << "Found caught mon " << std::hex << static_cast<int>(MEWTWO_V8) << std::endl;
 	}
 	// check if CELEBI_V8 is in caught_mons, if so set bit 2 in wPlayerCaught2
 	if (std::find(caught_mons.begin(), caught_mons.end(), CELEBI_V8) != caught_mons.end()) {
-		setFlagBit(it8, sym8.getPlayerDataAddress("wPlayerCaught2"), 2);
+		setFlagBit(it8, sym::v8::wPlayerCaught2_PlayerData, 2);
 		js_info << "Found caught mon " << std::hex << static_cast<int>(CELEBI_V8) << std::endl;
 	}
 	// check if SUDOWOODO_V8 is in caught_mons, if so set bit 3 in wPlayerCaught2
 	if (std::find(caught_mons.begin(), caught_mons.end(), SUDOWOODO_V8) != caught_mons.end()) {
-		setFlagBit(it8, sym8.getPlayerDataAddress("wPlayerCaught2"), 3);
+		setFlagBit(it8, sym::v8::wPlayerCaught2_PlayerData, 3);
 		js_info << "Found caught mon " << std::hex << static_cast<int>(SUDOWOODO_V8) << std::endl;
 	}
 
@@ -800,12 +770,12 @@ bool patchVersion7to8(SaveBinary& save7, SaveBinary& save8) {
 	// set v8 wCurMapSceneScriptPointer word to 0
 	// this is done to prevent the game from running any map scripts on load
 	js_info <<  "Set wCurMapSceneScriptCount and wCurMapCallbackCount to 0..." << std::endl;
-	it8.seek(sym8.getPlayerDataAddress("wCurMapSceneScriptCount"));
+	it8.seek(sym::v8::wCurMapSceneScriptCount_PlayerData);
 	it8.setByte(0);
-	it8.seek(sym8.getPlayerDataAddress("wCurMapCallbackCount"));
+	it8.seek(sym::v8::wCurMapCallbackCount_PlayerData);
 	it8.setByte(0);
 	js_info <<  "Set wCurMapSceneScriptPointer to 0..." << std::endl;
-	it8.seek(sym8.getPlayerDataAddress("wCurMapSceneScriptPointer"));
+	it8.seek(sym::v8::wCurMapSceneScriptPointer_PlayerData);
 	it8.setWord(0);
 
 	// write the new save version number big endian
@@ -815,16 +785,16 @@ bool patchVersion7to8(SaveBinary& save7, SaveBinary& save8) {
 
 	// Copy sGameData to sBackupGameData
 	js_info << "Copy sGameData to sBackupGameData..." << std::endl;
-	copyDataBlock(sd, sym8.getSRAMAddress("sGameData"), sym8.getSRAMAddress("sBackupGameData"), sym8.getSRAMAddress("sGameDataEnd") - sym8.getSRAMAddress("sGameData"));
+	copyDataBlock(sd, sym::v8::sGameData_SRAM, sym::v8::sBackupGameData_SRAM, sym::v8::sGameDataEnd_SRAM - sym::v8::sGameData_SRAM);
 
 	// write new checksums to the version 8 save file
 	js_info <<  "Write new checksums..." << std::endl;
-	uint16_t new_checksum = calculateSaveChecksum(save8, sym8.getSRAMAddress("sGameData"), sym8.getSRAMAddress("sGameDataEnd"));
+	uint16_t new_checksum = calculateSaveChecksum(save8, sym::v8::sGameData_SRAM, sym::v8::sGameDataEnd_SRAM);
 	save8.setWord(SAVE_CHECKSUM_ABS_ADDRESS, new_checksum);
 
 	// write new backup checksums to the version 8 save file
 	js_info <<  "Write new backup checksums..." << std::endl;
-	uint16_t new_backup_checksum = calculateSaveChecksum(save8, sym8.getSRAMAddress("sBackupGameData"), sym8.getSRAMAddress("sBackupGameDataEnd"));
+	uint16_t new_backup_checksum = calculateSaveChecksum(save8, sym::v8::sBackupGameData_SRAM, sym::v8::sBackupGameDataEnd_SRAM);
 	save8.setWord(SAVE_BACKUP_CHECKSUM_ABS_ADDRESS, new_backup_checksum);
 
 	// write the modified save file to the output file and print success message
@@ -843,23 +813,37 @@ void writeDefaultBoxName(SaveBinary::Iterator& it, int boxNum) {
 }
 
 // Migrate the newbox box data from version 7 to version 8
-void migrateBoxData(SourceDest &sd, const std::string &prefix) {
+void migrateBoxData(SourceDest &sd, const std::string &boxFamily, const std::string &nameFamily, const std::string &themeFamily) {
+	// the box symbols without their number, for logging
+	std::string prefix = boxFamily.substr(0, boxFamily.find('#'));
+	// resolve the box families up front
+	SymbolSet sourceBoxes(sd.sourceSym);
+	size_t sourceBox = sourceBoxes.addSRAMFamily(boxFamily, 1, NUM_BOXES_V7);
+	SymbolSet destBoxes(sd.destSym);
+	size_t destBox = destBoxes.addSRAMFamily(boxFamily, 1, NUM_BOXES_V8);
+	size_t destBoxName = destBoxes.addSRAMFamily(nameFamily, 1, NUM_BOXES_V8);
+	size_t destBoxTheme = destBoxes.addSRAMFamily(themeFamily, 1, NUM_BOXES_V8);
+	bool resolved = sourceBoxes.resolve();
+	if (!destBoxes.resolve() || !resolved) {
+		return;
+	}
+
 	// Clear the boxes
 	js_info << "Clearing v8 " << prefix << " boxes..." << std::endl;
 	for (int n = 1; n < NUM_BOXES_V8 + 1; n++) {
-		clearDataBlock(sd, sd.destSym.getSRAMAddress(prefix + std::to_string(n)), NEWBOX_SIZE);
+		clearDataBlock(sd, destBoxes[destBox + n - 1], NEWBOX_SIZE);
 	}
 
 	// Copy the boxes
 	for (int n = 1; n < NUM_BOXES_V7 + 1; n++) {
 		js_info << "Copying v7 " << prefix << n << " to v8..." << std::endl;
-		copyDataBlock(sd, sd.sourceSym.getSRAMAddress(prefix + std::to_string(n)), sd.destSym.getSRAMAddress(prefix + std::to_string(n)), NEWBOX_SIZE);
+		copyDataBlock(sd, sourceBoxes[sourceBox + n - 1], destBoxes[destBox + n - 1], NEWBOX_SIZE);
 	}
 
 	// Write default box names from NUM_BOXES_V7 + 1 to NUM_BOXES_V8
 	js_info <<  "Writing " << prefix << " default box names..." << std::endl;
 	for (int n = NUM_BOXES_V7 + 1; n < NUM_BOXES_V8 + 1; n++) {
-		sd.destSave.seek(sd.destSym.getSRAMAddress(prefix + std::to_string(n) + "Name"));
+		sd.destSave.seek(destBoxes[destBoxName + n - 1]);
 		js_info <<  "Writing default box name for " << prefix << n << "..." << std::endl;
 		writeDefaultBoxName(sd.destSave, n);
 	}
@@ -867,7 +851,7 @@ void migrateBoxData(SourceDest &sd, const std::string &prefix) {
 	// convert pc box themes
 	js_info <<  "Converting " << prefix << " box themes..." << std::endl;
 	for (int n = 1; n < NUM_BOXES_V8 + 1; n++) {
-		uint8_t theme = sd.destSave.getByte(sd.destSym.getSRAMAddress(prefix + std::to_string(n) + "Theme"));
+		uint8_t theme = sd.destSave.getByte(destBoxes[destBoxTheme + n - 1]);
 		uint8_t theme_v8 = mapV7ThemeToV8(theme);
 		if (theme != theme_v8) {
 			js_info <<  "Theme " << std::hex << static_cast<int>(theme) << " converted to " << std::hex << static_cast<int>(theme_v8) << std::endl;
@@ -1,10 +1,11 @@
 #include "patching/PatchVersion7to8.h"
+#include "core/IndexMap.h"
 
 namespace patchVersion7to8Namespace {
 
 // converts a version 7 key item to a version 8 key item
 uint8_t mapV7KeyItemToV8(uint8_t v7) {
-	std::unordered_map<uint8_t, uint8_t> indexMap = {
+	static constexpr IndexMapEntry<uint8_t, uint8_t> entries[] = {
 		{0x00, 0x01},  // BICYCLE
 		{0x01, 0x02},  // OLD_ROD
 		{0x02, 0x03},  // GOOD_ROD
@@ -37,13 +38,16 @@ uint8_t mapV7KeyItemToV8(uint8_t v7) {
 		{0x1D, 0x09},  // TYPE_CHART
 	};
 
+	static_assert(hasUniqueIndexes(entries) && isInjective(entries, 0xFF), "version 7 key items must convert one to one");
+	static constexpr IndexMap<uint8_t, uint8_t, indexMapSize(entries)> indexMap(entries, 0xFF);
+
 	// return the corresponding version 8 key item or 0xFF if not found
-	return indexMap.find(v7) != indexMap.end() ? indexMap[v7] : 0xFF;
+	return indexMap(v7);
 }
 
 // converts a version 7 item to a version 8 item
 uint8_t mapV7ItemToV8(uint8_t v7) {
-	std::unordered_map<uint8_t, uint8_t> indexMap = {
+	static constexpr IndexMapEntry<uint8_t, uint8_t> entries[] = {
 		{0x00, 0x00},  // NO_ITEM
 		{0x01, 0x01},  // POKE_BALL
 		{0x02, 0x02},  // GREAT_BALL
@@ -302,13 +306,16 @@ uint8_t mapV7ItemToV8(uint8_t v7) {
 
 	};
 
+	static_assert(hasUniqueIndexes(entries) && isInjective(entries, 0xFF), "version 7 items must convert one to one");
+	static constexpr IndexMap<uint8_t, uint8_t, indexMapSize(entries)> indexMap(entries, 0xFF);
+
 	// return the corresponding version 8 item or 0xFF if not found
-	return indexMap.find(v7) != indexMap.end() ? indexMap[v7] : 0xFF;
+	return indexMap(v7);
 }
 
 // Converts a version 7 event flag to a version 8 event flag
 uint16_t mapV7EventFlagToV8(uint16_t v7) {
-	std::unordered_map<uint16_t, uint16_t> indexMap = {
+	static constexpr IndexMapEntry<uint16_t, uint16_t> entries[] = {
 		{0, 0},  // EVENT_TEMPORARY_UNTIL_MAP_RELOAD_1
 		{1, 1},  // EVENT_TEMPORARY_UNTIL_MAP_RELOAD_2
 		{2, 2},  // EVENT_TEMPORARY_UNTIL_MAP_RELOAD_3
@@ -2480,14 +2487,17 @@ uint16_t mapV7EventFlagToV8(uint16_t v7) {
 		{2194, 234},   // EVENT_ECRUTEAK_CITY_HIDDEN_ETHER
 
 	};
+	// EVENT_GOT_TM63_WATER_PULSE and EVENT_GOT_TM43_WILD_CHARGE both convert to EVENT_GOT_TM57_WILD_CHARGE
+	static_assert(hasUniqueIndexes(entries) && countMergedIndexes(entries) == 1, "version 7 event flags must convert one to one");
+	static constexpr IndexMap<uint16_t, uint16_t, indexMapSize(entries)> indexMap(entries, INVALID_EVENT_FLAG);
 
 	// Return the corresponding version 8 event flag or INVALID_EVENT_FLAG if not found
-	return indexMap.find(v7) != indexMap.end() ? indexMap[v7] : INVALID_EVENT_FLAG;
+	return indexMap(v7);
 }
 
 // Converts a version 7 landmark to a version 8 landmark
 uint8_t mapV7LandmarkToV8(uint8_t v7) {
-	std::unordered_map<uint8_t, uint8_t> indexMap = {
+	static constexpr IndexMapEntry<uint8_t, uint8_t> entries[] = {
 		{0x00, 0x00},  // SPECIAL_MAP
 		{0x01, 0x01},  // NEW_BARK_TOWN
 		{0x02, 0x02},  // ROUTE_29
@@ -2634,13 +2644,16 @@ uint8_t mapV7LandmarkToV8(uint8_t v7) {
 
 	};
 
+	static_assert(hasUniqueIndexes(entries) && isInjective(entries, 0xFF), "version 7 landmarks must convert one to one");
+	static constexpr IndexMap<uint8_t, uint8_t, indexMapSize(entries)> indexMap(entries, 0xFF);
+
 	// Return the corresponding version 8 landmark or 0xFF if not found
-	return indexMap.find(v7) != indexMap.end() ? indexMap[v7] : 0xFF;
+	return indexMap(v7);
 }
 
 // Converts a version 7 spawn to a version 8 spawn
 uint8_t mapV7SpawnToV8(uint8_t v7) {
-	std::unordered_map<uint8_t, uint8_t> indexMap = {
+	static constexpr IndexMapEntry<uint8_t, uint8_t> entries[] = {
 		{0x00, 0x00},  // SPAWN_HOME
 		{0x01, 0x01},  // SPAWN_PALLET
 		{0x02, 0x02},  // SPAWN_VIRIDIAN
@@ -2674,13 +2687,16 @@ uint8_t mapV7SpawnToV8(uint8_t v7) {
 
 	};
 
+	static_assert(hasUniqueIndexes(entries) && isInjective(entries, 0xFF), "version 7 spawns must convert one to one");
+	static constexpr IndexMap<uint8_t, uint8_t, indexMapSize(entries)> indexMap(entries, 0xFF);
+
 	// Return the corresponding version 8 spawn or 0xFF if not found
-	return indexMap.find(v7) != indexMap.end() ? indexMap[v7] : 0xFF;
+	return indexMap(v7);
 }
 
 // converts a version 7 Pokémon index to a version 8 Pokémon index
 uint16_t mapV7PkmnToV8(uint16_t v7) {
-	std::unordered_map<uint16_t, uint16_t> indexMap = {
+	static constexpr IndexMapEntry<uint16_t, uint16_t> entries[] = {
 		{0x01, 0x01},  // BULBASAUR
 		{0x02, 0x02},  // IVYSAUR
 		{0x03, 0x03},  // VENUSAUR
@@ -2939,13 +2955,16 @@ uint16_t mapV7PkmnToV8(uint16_t v7) {
 
 	};
 
+	static_assert(hasUniqueIndexes(entries) && isInjective(entries, INVALID_SPECIES), "version 7 Pokémon must convert one to one");
+	static constexpr IndexMap<uint16_t, uint16_t, indexMapSize(entries)> indexMap(entries, INVALID_SPECIES);
+
 	// return the corresponding version 8 Pokémon index or INVALID_SPECIES if not found
-	return indexMap.find(v7) != indexMap.end() ? indexMap[v7] : INVALID_SPECIES;
+	return indexMap(v7);
 }
 
 // converts a version 7 (uint8_t group, uint8_t map) tuple to a version 8 (uint8_t group, uint8_t map) tuple
 std::tuple<uint8_t, uint8_t> mapv7toV8(uint8_t v7_group, uint8_t v7_map) {
-	std::unordered_map<std::tuple<uint8_t, uint8_t>, std::tuple<uint8_t, uint8_t>, TupleHash> mapv7toV8 = {
+	static constexpr IndexMapEntry<IndexPair, IndexPair> entries[] = {
 		{{1, 1}, {1, 1}},  // OLIVINE_POKECENTER_1F
 		{{1, 2}, {1, 2}},  // OLIVINE_GYM
 		{{1, 3}, {1, 3}},  // OLIVINE_TIMS_HOUSE
@@ -3537,19 +3556,18 @@ std::tuple<uint8_t, uint8_t> mapv7toV8(uint8_t v7_group, uint8_t v7_map) {
 
 	};
 
-	auto key = std::make_tuple(v7_group, v7_map);
-	auto it = mapv7toV8.find(key);
-	if (it != mapv7toV8.end()) {
-		return it->second;
-	} else {
-		return std::make_tuple(0, 0);
-	}
+	static_assert(hasUniqueIndexes(entries) && isInjective(entries, {0, 0}), "version 7 maps must convert one to one");
+	static constexpr IndexMap2D<IndexPair, indexMap2DSize(entries).first, indexMap2DSize(entries).second> mapv7toV8(entries, {0, 0});
+
+	// return the corresponding version 8 map or (0, 0) if not found
+	IndexPair map = mapv7toV8(v7_group, v7_map);
+	return std::make_tuple(map.first, map.second);
 }
 
 // Converts a version 7 (uint16_t species, uint8_t form) tuple to a version 8 unint16_t extspecies
 // If the species is not in the map, it returns 0xFFFF; We only care about species that have a form
 uint16_t mapV7SpeciesFormToV8Extspecies(uint16_t species, uint8_t form) {
-	std::unordered_map<std::tuple<uint8_t, uint8_t>, uint16_t, TupleHash> mapv7toV8 = {
+	static constexpr IndexMapEntry<IndexPair, uint16_t> entries[] = {
 		{{0xC6, 0x02}, 0x124}, // UNOWN_B_FORM
 		{{0xC6, 0x03}, 0x125}, // UNOWN_C_FORM
 		{{0xC6, 0x04}, 0x126}, // UNOWN_D_FORM
@@ -3633,18 +3651,16 @@ uint16_t mapV7SpeciesFormToV8Extspecies(uint16_t species, uint8_t form) {
 		{{0x92, 0x03}, 0x17B}, // MOLTRES_GALARIAN_FORM
 	};
 
-	auto key = std::make_tuple(species, form);
-	auto it = mapv7toV8.find(key);
-	if (it != mapv7toV8.end()) {
-		return it->second;
-	} else {
-		return 0xFFFF;
-	}
+	static_assert(hasUniqueIndexes(entries) && isInjective(entries, 0xFFFF), "version 7 forms must convert one to one");
+	static constexpr IndexMap2D<uint16_t, indexMap2DSize(entries).first, indexMap2DSize(entries).second> mapv7toV8(entries, 0xFFFF);
+
+	// the species is looked up by its low byte, as it always has been (version 7 species fit a byte)
+	return mapv7toV8(static_cast<uint8_t>(species), form);
 }
 
 // converts a version 7 magikarp form to a version 8 magikarp form
 uint8_t mapV7MagikarpFormToV8(uint8_t v7) {
-	std::unordered_map<uint8_t, uint8_t> indexMap = {
+	static constexpr IndexMapEntry<uint8_t, uint8_t> entries[] = {
 		{0x01, 0x01}, // MAGIKARP_PLAIN_FORM
 		{0x02, 0x02}, // MAGIKARP_SKELLY_FORM
 		{0x03, 0x03}, // MAGIKARP_CALICO1_FORM
@@ -3663,13 +3679,16 @@ uint8_t mapV7MagikarpFormToV8(uint8_t v7) {
 		{0x10, 0x14}, // MAGIKARP_RAINDROP_FORM
 	};
 
+	static_assert(hasUniqueIndexes(entries) && isInjective(entries, 0xFF), "version 7 magikarp forms must convert one to one");
+	static constexpr IndexMap<uint8_t, uint8_t, indexMapSize(entries)> indexMap(entries, 0xFF);
+
 	// return the corresponding version 8 magikarp form or 0xFF if not found
-	return indexMap.find(v7) != indexMap.end() ? indexMap[v7] : 0xFF;
+	return indexMap(v7);
 }
 
 // converts a version 7 theme to a version 8 theme
 uint8_t mapV7ThemeToV8(uint8_t v7) {
-	std::unordered_map<uint8_t, uint8_t> indexMap = {
+	static constexpr IndexMapEntry<uint8_t, uint8_t> entries[] = {
 		{0x00, 0x00},  // THEME_STANDARD
 		{0x01, 0x01},  // THEME_PRO
 		{0x02, 0x02},  // THEME_MOBILE
@@ -3701,13 +3720,17 @@ uint8_t mapV7ThemeToV8(uint8_t v7) {
 		{0x1C, 0x1F},  // THEME_DARK
 		{0x1D, 0x20},  // THEME_FAIRY
 	};
+
+	static_assert(hasUniqueIndexes(entries) && isInjective(entries, 0xFF), "version 7 themes must convert one to one");
+	static constexpr IndexMap<uint8_t, uint8_t, indexMapSize(entries)> indexMap(entries, 0xFF);
+
 	// return the corresponding version 8 theme or 0xFF if not found
-	return indexMap.find(v7) != indexMap.end() ? indexMap[v7] : 0xFF;
+	return indexMap(v7);
 }
 
 // converts a version 7 charmap to a version 8 charmap
 uint8_t mapV7CharToV8(uint8_t v7) {
-	std::unordered_map<uint8_t, uint8_t> charMap = {
+	static constexpr IndexMapEntry<uint8_t, uint8_t> entries[] = {
 		{0x54, 0x5e},  // "¯"
 		{0x5a, 0x52},  // "<DONE>"
 		{0x5b, 0x54},  // "<PROMPT>"
@@ -3742,8 +3765,12 @@ uint8_t mapV7CharToV8(uint8_t v7) {
 		{0x51, 0x50},  // "<RIVAL>"
 		{0x52, 0x51},  // "<TRENDY>"
 	};
+
+	static_assert(hasUniqueIndexes(entries) && countMergedIndexes(entries) == 0, "version 7 chars must convert one to one");
+	static constexpr IndexMap<uint8_t, uint8_t, indexMapSize(entries)> indexMap(entries);
+
 	// return the corresponding version 8 char or original char if not found
-	return charMap.find(v7) != charMap.end() ? charMap[v7] : v7;
+	return indexMap(v7);
 }
 
 }
\ No newline at end of file
@@ -1,22 +1,108 @@
 #include "patching/PatchVersion8to9.h"
 #include "core/CommonPatchFunctions.h"
 #include "core/SymbolDatabase.h"
+#include "core/IndexMap.h"
+#include "core/RegionPlan.h"
 #include "core/Logging.h"
-#include "core/SymbolDatabaseContents.h"
+#include "symbols/Version8Symbols.h"
+#include "symbols/Version9Symbols.h"
 
 namespace patchVersion8to9Namespace {
 
-	bool patchVersion8to9(SaveBinary& save8, SaveBinary& save9) {
-		// copy the old save file to the new save file
-		save9 = save8;
+	// the copies, clears and conversions from the version 8 save blocks to the version 9 ones
+	static RegionPlan buildRegionPlan() {
+		RegionPlan plan;
+		plan.clear(sym::v9::wRTC_PlayerData + 4, 4, "Clearing 4 unused bytes after wRTC");
+		plan.clear(sym::v8::wTimeOfDayPal_PlayerData + 1, 4, "Clearing 4 unused bytes after wTimeOfDayPal");
+
+		plan.clear(sym::v9::wKeyItems_PlayerData, sym::v9::wKeyItemsEnd_PlayerData - sym::v9::wKeyItems_PlayerData, "Clearing v9 wKeyItems space...");
+		plan.copy(sym::v8::wKeyItems_PlayerData, sym::v9::wKeyItems_PlayerData, sym::v8::wKeyItemsEnd_PlayerData - sym::v8::wKeyItems_PlayerData, "Copying v8 wKeyItems to v9 wKeyItems...");
+		// key items missing in version 9 are kept as they are
+		plan.remapBytes(sym::v8::wKeyItems_PlayerData, sym::v9::wKeyItems_PlayerData, NUM_KEY_ITEMS_V9, 0x00, [](uint8_t keyItem) {
+			uint8_t keyItemV9 = mapV8KeyItemToV9(keyItem);
+			return keyItemV9 != 0xFF ? keyItemV9 : RegionPlan::UNMAPPED;
+		}, "Patching wKeyItems...", [](uint8_t keyItem, int keyItemV9) {
+			if (keyItemV9 == RegionPlan::UNMAPPED) {
+				js_error << "Key Item " << std::hex << static_cast<int>(keyItem) << " not found in version 9 key item list." << std::endl;
+			}
+			else {
+				js_info << "Key Item " << std::hex << static_cast<int>(keyItem) << " converted to " << std::hex << keyItemV9 << std::endl;
+			}
+		});
+
+		plan.copy(sym::v8::wNumItems_PlayerData, sym::v9::wNumItems_PlayerData, sym::v8::wMooMooBerries_PlayerData - 1 - sym::v8::wNumItems_PlayerData, "Copying [wNumItems, wMooMooBerries - 1)");
+		plan.copy(sym::v8::wMooMooBerries_PlayerData, sym::v9::wMooMooBerries_PlayerData, sym::v8::wEcruteakHouseSceneID_PlayerData + 1 - sym::v8::wMooMooBerries_PlayerData, "Copying [wMooMooBerries, wEcruteakHouseSceneID]");
+		plan.clear(sym::v9::wRocketHideoutB4FSceneID_PlayerData, 1, "Clearing wRocketHideoutB4FSceneID");
+		plan.copy(sym::v8::wElmsLabSceneID_PlayerData, sym::v9::wElmsLabSceneID_PlayerData, sym::v8::wEventFlags_PlayerData - sym::v8::wElmsLabSceneID_PlayerData, "Copying [wElmsLabSceneID, wEventFlags)");
+
+		plan.clear(sym::v9::wEventFlags_PlayerData, sym::v9::wCurBox_PlayerData - sym::v9::wEventFlags_PlayerData, "Clearing wEventFlags");
+		// wEventFlags is a flag_array of NUM_EVENTS bits
+		FlagRemap eventFlagRemap(NUM_EVENTS, NUM_EVENTS, [](uint32_t eventFlagIndex) {
+			uint16_t eventFlagIndexV9 = mapV8EventFlagToV9(eventFlagIndex);
+			return eventFlagIndexV9 != INVALID_EVENT_FLAG ? eventFlagIndexV9 : FlagRemap::DROPPED;
+		});
+		plan.remapFlags(eventFlagRemap, sym::v8::wEventFlags_PlayerData, NUM_EVENTS, sym::v9::wEventFlags_PlayerData, NUM_EVENTS, "Patching wEventFlags...", [](uint32_t eventFlagIndex, uint32_t eventFlagIndexV9) {
+			if (eventFlagIndexV9 != FlagRemap::DROPPED) {
+				// print found event flagv8 and converted event flagv9
+				js_info << "Event Flag " << std::dec << eventFlagIndex << " converted to " << eventFlagIndexV9 << std::endl;
+			}
+			else {
+				// warn we couldn't find v8 event flag in v9
+				js_warning << "Event Flag " << eventFlagIndex << " not found in version 8 event flag list." << std::endl;
+			}
+		});
+
+		plan.copy(sym::v8::wCurBox_PlayerData, sym::v9::wCurBox_PlayerData, sym::v8::wEmotePal_PlayerData + 1 - sym::v8::wCurBox_PlayerData, "Copying [wCurBox, wEmotePal]");
+		plan.clear(sym::v9::wEmotePal_PlayerData + 1, 69, "Clearing (64 unused bytes + 5 candy bytes) after wEmotePal");
+		plan.copy(sym::v8::wWingAmounts_PlayerData, sym::v9::wWingAmounts_PlayerData, sym::v8::wHiddenGrottoContents_PlayerData - sym::v8::wWingAmounts_PlayerData, "Copying [wWingAmounts, wHiddenGrottoContents)");
+		plan.clear(sym::v9::wHiddenGrottoContents_PlayerData - 19, 19, "Clearing 19 unused bytes before wHiddenGrottoContents");
+		plan.copy(sym::v8::wHiddenGrottoContents_PlayerData, sym::v9::wHiddenGrottoContents_PlayerData, sym::v8::wPhoneListEnd_PlayerData - sym::v8::wHiddenGrottoContents_PlayerData, "Copying [wHiddenGrottoContents, wPhoneListEnd)");
+		plan.clear(sym::v9::wPhoneListEnd_PlayerData, 1, "Set wPhoneListEnd to 0");
+		plan.copy(sym::v8::wParkBallsRemaining_PlayerData, sym::v9::wParkBallsRemaining_PlayerData, sym::v8::wPlayerDataEnd_PlayerData - sym::v8::wParkBallsRemaining_PlayerData, "Copying [wParkBallsRemaining, wPlayerDataEnd)");
+		plan.copy(sym::v8::wCurMapData_MapData, sym::v9::wCurMapData_MapData, sym::v8::wCurMapDataEnd_MapData - sym::v8::wCurMapData_MapData, "Copying [wCurMapData, wCurMapDataEnd)");
+		plan.copy(sym::v8::wPokemonData_PokemonData, sym::v9::wPokemonData_PokemonData, sym::v8::wPartyCount_PokemonData + 1 - sym::v8::wPokemonData_PokemonData, "Copying [wPokemonData, wPartyCount]");
+		plan.clear(sym::v9::wPartyCount_PokemonData + 1, 7, "Clearing 7 unused bytes after wPartyCount");
+		plan.clear(sym::v9::wPokedexCaught_PokemonData, sym::v9::wUnlockedUnowns_PokemonData - sym::v9::wPokedexCaught_PokemonData, "Clearing [wPokedexCaught, wUnlockedUnowns)");
+		plan.copy(sym::v8::wPartyMons_PokemonData, sym::v9::wPartyMons_PokemonData, sym::v8::wEndPokedexCaught_PokemonData - sym::v8::wPartyMons_PokemonData, "Copying [wPartyMons, wEndPokedexCaught)");
+		plan.copy(sym::v8::wPokedexSeen_PokemonData, sym::v9::wPokedexSeen_PokemonData, sym::v8::wEndPokedexSeen_PokemonData - sym::v8::wPokedexSeen_PokemonData, "Copying [wPokedexSeen, wEndPokedexSeen)");
+		plan.copy(sym::v8::wUnlockedUnowns_PokemonData, sym::v9::wUnlockedUnowns_PokemonData, 1, "Copying wUnlockedUnowns");
+		plan.clear(sym::v9::wUnlockedUnowns_PokemonData + 1, 2, "Clearing 2 unused bytes after wUnlockedUnowns");
+		plan.copy(sym::v8::wDayCareMan_PokemonData, sym::v9::wDayCareMan_PokemonData, sym::v8::wBestMagikarpLengthMm_PokemonData - sym::v8::wDayCareMan_PokemonData, "Copying [wDayCareMan, wBestMagikarpLengthMm)");
+		plan.clear(sym::v9::wBestMagikarpLengthMm_PokemonData - 4, 4, "Clearing 4 unused bytes before wBestMagikarpLengthMm");
+		plan.copy(sym::v8::wBestMagikarpLengthMm_PokemonData, sym::v9::wBestMagikarpLengthMm_PokemonData, sym::v8::wPokemonDataEnd_PokemonData - sym::v8::wBestMagikarpLengthMm_PokemonData, "Copying [wBestMagikarpLengthMm, wPokemonDataEnd)");
+		// the old wNuzlockeLandmarkFlags space, at its version 8 address
+		plan.clear(sym::v8::wHiddenGrottoContents_PlayerData - 19, 19, "Clearing old wNuzlockeLandmarkFlags space...\nClear wNuzlockeLandmarkFlags...");
+
+		// reset the PGO battle event flags
+		plan.resetFlags(sym::v9::wEventFlags_PlayerData, NUM_EVENTS, { EVENT_BEAT_CANDELA, EVENT_BEAT_BLANCHE, EVENT_BEAT_SPARK }, "Resetting PGO battle event flags...", [](uint32_t eventFlag) {
+			js_info << "Clearing flag " << std::hex << eventFlag << std::endl;
+		});
+
+		// this is done to prevent the game from running any map scripts on load
+		plan.clear(sym::v9::wCurMapSceneScriptCount_PlayerData, 1, "Set wCurMapSceneScriptCount and wCurMapCallbackCount to 0...");
+		plan.clear(sym::v9::wCurMapCallbackCount_PlayerData, 1, "");
+		plan.clear(sym::v9::wCurMapSceneScriptPointer_PlayerData, 2, "Set wCurMapSceneScriptPointer to 0...");
+
+		return plan;
+	}
 
+	// get the region plan, built and compiled on first use. nullptr if it doesn't compile.
+	static const RegionPlan* getRegionPlan() {
+		static RegionPlan plan = buildRegionPlan();
+		static const bool compiled = plan.compile();
+		return compiled ? &plan : nullptr;
+	}
+
+	bool patchVersion8to9(SaveBinary& save8, SaveBinary& save9) {
 		// create the iterators
 		SaveBinary::Iterator it8(save8, 0);
 		SaveBinary::Iterator it9(save9, 0);
 
 		// Load the version 8 and version 9 sym files
-		SymbolDatabase sym8(version8_sym_data, version8_sym_len);
-		SymbolDatabase sym9(version9_sym_data, version9_sym_len);
+		const SymbolDatabase& sym8 = SymbolDatabase::forVersion(8);
+		const SymbolDatabase& sym9 = SymbolDatabase::forVersion(9);
+		save8.setSymbols(&sym8);
+		save9.setSymbols(&sym9);
 
 		SourceDest sd = { it8, it9, sym8, sym9 };
 
@@ -24,7 +110,7 @@ namespace patchVersion8to9Namespace {
 		uint16_t save_checksum = save8.getWord(SAVE_CHECKSUM_ABS_ADDRESS);
 
 		// verify the checksum of the version 8 file matches the calculated checksum
-		uint16_t calculated_checksum = calculateSaveChecksum(save8, sym8.getSRAMAddress("sGameData"), sym8.getSRAMAddress("sGameDataEnd"));
+		uint16_t calculated_checksum = calculateSaveChecksum(save8, sym::v8::sGameData_SRAM, sym::v8::sGameDataEnd_SRAM);
 		if (save_checksum != calculated_checksum) {
 			js_error << "Checksum mismatch! Expected: " << std::hex << calculated_checksum << ", got: " << save_checksum << std::endl;
 			return false;
@@ -32,14 +118,17 @@ namespace patchVersion8to9Namespace {
 
 		// check the backup checksum word from the version 8 save file
 		uint16_t backup_checksum = save8.getWord(SAVE_BACKUP_CHECKSUM_ABS_ADDRESS);
-		uint16_t calculated_backup_checksum = calculateSaveChecksum(save8, sym8.getSRAMAddress("sBackupGameData"), sym8.getSRAMAddress("sBackupGameDataEnd"));
+		uint16_t calculated_backup_checksum = calculateSaveChecksum(save8, sym::v8::sBackupGameData_SRAM, sym::v8::sBackupGameDataEnd_SRAM);
 		if (backup_checksum != calculated_backup_checksum) {
 			js_error << "Backup checksum mismatch! Expected: " << std::hex << calculated_backup_checksum << ", got: " << backup_checksum << std::endl;
 			return false;
 		}
 
+		// keep the new save's checksums up to date as it is patched
+		trackGameDataChecksums(save9, sym9);
+
 		// check if the player is in the PKMN Center 2nd Floor
-		uint8_t map_group = it8.getByte(sym8.getMapDataAddress("wMapGroup"));
+		uint8_t map_group = it8.getByte(sym::v8::wMapGroup_MapData);
 		it8.next();
 		uint8_t map_num = it8.getByte();
 		if (map_group != MON_CENTER_2F_GROUP || map_num != MON_CENTER_2F_MAP) {
@@ -47,198 +136,15 @@ namespace patchVersion8to9Namespace {
 			return false;
 		}
 
-		// clear unused bytes after wRTC, [wRTC + 4, wRTC + 8)
-		js_info << "Clearing 4 unused bytes after wRTC" << std::endl;
-		clearDataBlock(sd, sym9.getPlayerDataAddress("wRTC") + 4, 4);
-
-		// clear unused bytes after wTimeOfDayPal, [wTimeOfDayPal + 1, wTimeOfDayPal + 5)
-		js_info << "Clearing 4 unused bytes after wTimeOfDayPal" << std::endl;
-		clearDataBlock(sd, sym8.getPlayerDataAddress("wTimeOfDayPal") + 1, 4);
-
-		// Clear v9 wKeyItems space
-		js_info << "Clearing v9 wKeyItems space..." << std::endl;
-		clearDataBlock(sd, sym9.getPlayerDataAddress("wKeyItems"), sym9.getPlayerDataAddress("wKeyItemsEnd") - sym9.getPlayerDataAddress("wKeyItems"));
-
-		// Copy v8 wKeyItems to v9 wKeyItems
-		js_info << "Copying v8 wKeyItems to v9 wKeyItems..." << std::endl;
-		copyDataBlock(sd, sym8.getPlayerDataAddress("wKeyItems"), sym9.getPlayerDataAddress("wKeyItems"), sym8.getPlayerDataAddress("wKeyItemsEnd") - sym8.getPlayerDataAddress("wKeyItems"));
-
-		js_info << "Patching wKeyItems..." << std::endl;
-		it8.seek(sym8.getPlayerDataAddress("wKeyItems"));
-		it9.seek(sym9.getPlayerDataAddress("wKeyItems"));
-		// while it8.getByte() != 0x00
-		for (int i = 0; i < NUM_KEY_ITEMS_V9; i++) {
-			uint8_t key_item_v8 = it8.getByte();
-			if (key_item_v8 == 0x00) {
-				break;
-			}
-			uint8_t key_item_v9 = mapV8KeyItemToV9(key_item_v8);
-			if (key_item_v9 == 0xFF) {
-				js_error << "Key Item " << std::hex << key_item_v9 << " not found in version 9 key item list." << std::endl;
-			}
-			else {
-				if (key_item_v8 != key_item_v9) {
-					it9.setByte(key_item_v9);
-					js_info << "Key Item " << std::hex << static_cast<int>(key_item_v8) << " converted to " << std::hex << static_cast<int>(key_item_v9) << std::endl;
-				}
-			}
-			it8.next();
-			it9.next();
-		}
-
-		// Copy from [wNumItems, wMooMooBerries - 1)
-		js_info << "Copying [wNumItems, wMooMooBerries - 1)" << std::endl;
-		copyDataBlock(sd, sym8.getPlayerDataAddress("wNumItems"), sym9.getPlayerDataAddress("wNumItems"), sym8.getPlayerDataAddress("wMooMooBerries") - 1 - sym8.getPlayerDataAddress("wNumItems"));
-
-		// Copy from [wMooMooBerries, wEcruteakHouseSceneID]
-		js_info << "Copying [wMooMooBerries, wEcruteakHouseSceneID]" << std::endl;
-		copyDataBlock(sd, sym8.getPlayerDataAddress("wMooMooBerries"), sym9.getPlayerDataAddress("wMooMooBerries"), sym8.getPlayerDataAddress("wEcruteakHouseSceneID") + 1 - sym8.getPlayerDataAddress("wMooMooBerries"));
-
-		// Clear wRocketHideoutB4FSceneID
-		js_info << "Clearing wRocketHideoutB4FSceneID" << std::endl;
-		it9.setByte(sym9.getPlayerDataAddress("wRocketHideoutB4FSceneID"), 0x00);
-
-		// Copy from [wElmsLabSceneID, wEventFlags)
-		js_info << "Copying [wElmsLabSceneID, wEventFlags)" << std::endl;
-		copyDataBlock(sd, sym8.getPlayerDataAddress("wElmsLabSceneID"), sym9.getPlayerDataAddress("wElmsLabSceneID"), sym8.getPlayerDataAddress("wEventFlags") - sym8.getPlayerDataAddress("wElmsLabSceneID"));
-
-		// Clear wEventFlags
-		js_info << "Clearing wEventFlags" << std::endl;
-		clearDataBlock(sd, sym9.getPlayerDataAddress("wEventFlags"), sym9.getPlayerDataAddress("wCurBox") - sym9.getPlayerDataAddress("wEventFlags"));
-
-		it9.seek(sym9.getPlayerDataAddress("wEventFlags"));
-		// wEventFlags is a flag_array of NUM_EVENTS bits. If v7 bit is set, lookup the bit index in the map and set the corresponding bit in v8
-		js_info << "Patching wEventFlags..." << std::endl;
-		for (int i = 0; i < NUM_EVENTS; i++) {
-			// check if the bit is set
-			if (isFlagBitSet(it8, sym8.getPlayerDataAddress("wEventFlags"), i)) {
-				// get the event flag index is equal to the bit index
-				uint16_t eventFlagIndex = i;
-				// map the version 7 event flag to the version 8 event flag
-				uint16_t eventFlagIndexV9 = mapV8EventFlagToV9(eventFlagIndex);
-				// if the event flag is found set the corresponding bit in it8
-				if (eventFlagIndexV9 != INVALID_EVENT_FLAG) {
-					// print found event flagv7 and converted event flagv8
-					if (eventFlagIndex != eventFlagIndexV9) {
-						js_info << "Event Flag " << std::dec << eventFlagIndex << " converted to " << eventFlagIndexV9 << std::endl;
-					}
-					setFlagBit(it9, sym9.getPlayerDataAddress("wEventFlags"), eventFlagIndexV9);
-				}
-				else {
-					// warn we couldn't find v7 event flag in v8
-					js_warning << "Event Flag " << eventFlagIndex << " not found in version 8 event flag list." << std::endl;
-				}
-			}
+		// copy and convert the save blocks
+		const RegionPlan* plan = getRegionPlan();
+		if (plan == nullptr || !plan->execute(save8, save9)) {
+			js_error << "Failed to copy the version 8 save blocks." << std::endl;
+			return false;
 		}
 
-		// Copy from [wCurBox, wEmotePal]
-		js_info << "Copying [wCurBox, wEmotePal]" << std::endl;
-		copyDataBlock(sd, sym8.getPlayerDataAddress("wCurBox"), sym9.getPlayerDataAddress("wCurBox"), sym8.getPlayerDataAddress("wEmotePal") + 1 - sym8.getPlayerDataAddress("wCurBox"));
-
-		// Clear (64 unused bytes + 5 candy bytes) after wEmotePal
-		js_info << "Clearing (64 unused bytes + 5 candy bytes) after wEmotePal" << std::endl;
-		clearDataBlock(sd, sym9.getPlayerDataAddress("wEmotePal") + 1, 69);
-
-		// Copy from [wWingAmounts, wHiddenGrottoContents)
-		js_info << "Copying [wWingAmounts, wHiddenGrottoContents)" << std::endl;
-		copyDataBlock(sd, sym8.getPlayerDataAddress("wWingAmounts"), sym9.getPlayerDataAddress("wWingAmounts"), sym8.getPlayerDataAddress("wHiddenGrottoContents") - sym8.getPlayerDataAddress("wWingAmounts"));
-
-		// Clear 19 unused bytes before wHiddenGrottoContents
-		js_info << "Clearing 19 unused bytes before wHiddenGrottoContents" << std::endl;
-		clearDataBlock(sd, sym9.getPlayerDataAddress("wHiddenGrottoContents") - 19, 19);
-
-		// copy [wHiddenGrottoContents, wPhoneListEnd)
-		js_info << "Copying [wHiddenGrottoContents, wPhoneListEnd)" << std::endl;
-		copyDataBlock(sd, sym8.getPlayerDataAddress("wHiddenGrottoContents"), sym9.getPlayerDataAddress("wHiddenGrottoContents"), sym8.getPlayerDataAddress("wPhoneListEnd") - sym8.getPlayerDataAddress("wHiddenGrottoContents"));
-
-		// set wPhoneListEnd to 0
-		js_info << "Set wPhoneListEnd to 0" << std::endl;
-		it9.setByte(sym9.getPlayerDataAddress("wPhoneListEnd"), 0);
-
-		// Copy from [wParkBallsRemaining, wPlayerDataEnd)
-		js_info << "Copying [wParkBallsRemaining, wPlayerDataEnd)" << std::endl;
-		copyDataBlock(sd, sym8.getPlayerDataAddress("wParkBallsRemaining"), sym9.getPlayerDataAddress("wParkBallsRemaining"), sym8.getPlayerDataAddress("wPlayerDataEnd") - sym8.getPlayerDataAddress("wParkBallsRemaining"));
-
-		// Copy [wCurMapData, wCurMapDataEnd)
-		js_info << "Copying [wCurMapData, wCurMapDataEnd)" << std::endl;
-		copyDataBlock(sd, sym8.getMapDataAddress("wCurMapData"), sym9.getMapDataAddress("wCurMapData"), sym8.getMapDataAddress("wCurMapDataEnd") - sym8.getMapDataAddress("wCurMapData"));
-
-		// Copy [wPokemonData, wPartyCount]
-		js_info << "Copying [wPokemonData, wPartyCount]" << std::endl;
-		copyDataBlock(sd, sym8.getPokemonDataAddress("wPokemonData"), sym9.getPokemonDataAddress("wPokemonData"), sym8.getPokemonDataAddress("wPartyCount") + 1 - sym8.getPokemonDataAddress("wPokemonData"));
-
-		// Clear 7 unused bytes after wPartyCount
-		js_info << "Clearing 7 unused bytes after wPartyCount" << std::endl;
-		clearDataBlock(sd, sym9.getPokemonDataAddress("wPartyCount") + 1, 7);
-
-		// Clear [wPokedexCaught, wUnlockedUnowns)
-		js_info << "Clearing [wPokedexCaught, wUnlockedUnowns)" << std::endl;
-		clearDataBlock(sd, sym9.getPokemonDataAddress("wPokedexCaught"), sym9.getPokemonDataAddress("wUnlockedUnowns") - sym9.getPokemonDataAddress("wPokedexCaught"));
-
-		// Copy [wPartyMons, wEndPokedexCaught)
-		js_info << "Copying [wPartyMons, wEndPokedexCaught)" << std::endl;
-		copyDataBlock(sd, sym8.getPokemonDataAddress("wPartyMons"), sym9.getPokemonDataAddress("wPartyMons"), sym8.getPokemonDataAddress("wEndPokedexCaught") - sym8.getPokemonDataAddress("wPartyMons"));
-
-		// Copy [wPokedexSeen, wEndPokedexSeen)
-		js_info << "Copying [wPokedexSeen, wEndPokedexSeen)" << std::endl;
-		copyDataBlock(sd, sym8.getPokemonDataAddress("wPokedexSeen"), sym9.getPokemonDataAddress("wPokedexSeen"), sym8.getPokemonDataAddress("wEndPokedexSeen") - sym8.getPokemonDataAddress("wPokedexSeen"));
-
-		// Copy wUnlockedUnowns
-		js_info << "Copying wUnlockedUnowns" << std::endl;
-		it9.setByte(sym9.getPokemonDataAddress("wUnlockedUnowns"), it8.getByte(sym8.getPokemonDataAddress("wUnlockedUnowns")));
-
-		// Clear 2 unused bytes after wUnlockedUnowns
-		js_info << "Clearing 2 unused bytes after wUnlockedUnowns" << std::endl;
-		clearDataBlock(sd, sym9.getPokemonDataAddress("wUnlockedUnowns") + 1, 2);
-
-		// Copy [wDayCareMan, wBestMagikarpLengthMm)
-		js_info << "Copying [wDayCareMan, wBestMagikarpLengthMm)" << std::endl;
-		copyDataBlock(sd, sym8.getPokemonDataAddress("wDayCareMan"), sym9.getPokemonDataAddress("wDayCareMan"), sym8.getPokemonDataAddress("wBestMagikarpLengthMm") - sym8.getPokemonDataAddress("wDayCareMan"));
-
-		// Clear 4 unused bytes before wBestMagikarpLengthMm
-		js_info << "Clearing 4 unused bytes before wBestMagikarpLengthMm" << std::endl;
-		clearDataBlock(sd, sym9.getPokemonDataAddress("wBestMagikarpLengthMm") - 4, 4);
-
-		// Copy [wBestMagikarpLengthMm, wPokemonDataEnd)
-		js_info << "Copying [wBestMagikarpLengthMm, wPokemonDataEnd)" << std::endl;
-		copyDataBlock(sd, sym8.getPokemonDataAddress("wBestMagikarpLengthMm"), sym9.getPokemonDataAddress("wBestMagikarpLengthMm"), sym8.getPokemonDataAddress("wPokemonDataEnd") - sym8.getPokemonDataAddress("wBestMagikarpLengthMm"));
-
-		// Clear old wNuzlockeLandmarkFlags space
-		js_info << "Clearing old wNuzlockeLandmarkFlags space..." << std::endl;
-		it8.seek(sym8.getPlayerDataAddress("wHiddenGrottoContents") - 19);
-		// Clear wNuzlockeLandmarkFlags
-		js_info << "Clear wNuzlockeLandmarkFlags..." << std::endl;
-		clearDataBlock(sd, it8.getAddress(), 19);
-
-		// reset the PGO battle event flags
-		js_info << "Resetting PGO battle event flags..." << std::endl;
-		js_info << "Clearing flag " << std::hex << EVENT_BEAT_CANDELA << std::endl;
-		clearFlagBit(it9, sym9.getPlayerDataAddress("wEventFlags"), EVENT_BEAT_CANDELA);
-		js_info << "Clearing flag " << std::hex << EVENT_BEAT_BLANCHE << std::endl;
-		clearFlagBit(it9, sym9.getPlayerDataAddress("wEventFlags"), EVENT_BEAT_BLANCHE);
-		js_info << "Clearing flag " << std::hex << EVENT_BEAT_SPARK << std::endl;
-		clearFlagBit(it9, sym9.getPlayerDataAddress("wEventFlags"), EVENT_BEAT_SPARK);
-
-		// copy sGameData to sBackupGameData
-	//	js_info <<  "Copying sGameData to sBackupGameData" << std::endl;
-	//	for (int i = sym9.getSRAMAddress("sGameData"); i < sym9.getSRAMAddress("sGameDataEnd"); i++) {
-	//		it9.setByte(sym9.getSRAMAddress("sBackupGameData") + i, it9.getByte(sym9.getSRAMAddress("sGameData") + i));
-	//	}
-
-		// set v9 wCurMapSceneScriptCount and wCurMapCallbackCount to 0
-		// set v9 wCurMapSceneScriptPointer word to 0
-		// this is done to prevent the game from running any map scripts on load
-		js_info << "Set wCurMapSceneScriptCount and wCurMapCallbackCount to 0..." << std::endl;
-		it9.seek(sym9.getPlayerDataAddress("wCurMapSceneScriptCount"));
-		it9.setByte(0);
-		it9.seek(sym9.getPlayerDataAddress("wCurMapCallbackCount"));
-		it9.setByte(0);
-		js_info << "Set wCurMapSceneScriptPointer to 0..." << std::endl;
-		it9.seek(sym9.getPlayerDataAddress("wCurMapSceneScriptPointer"));
-		it9.setWord(0);
-
-		uint8_t prev_map_group = it9.getByte(sym9.getMapDataAddress("wBackupMapGroup"));
-		uint8_t prev_map_num = it9.getByte(sym9.getMapDataAddress("wBackupMapNumber"));
+		uint8_t prev_map_group = it9.getByte(sym::v9::wBackupMapGroup_MapData);
+		uint8_t prev_map_num = it9.getByte(sym::v9::wBackupMapNumber_MapData);
 		// check if the previous map is a valid PC warp ID in the validPCWarpIDs array
 		bool valid_prev_map = false;
 		for (auto& validPCWarpID : validPCWarpIDs) {
@@ -249,17 +155,17 @@ namespace patchVersion8to9Namespace {
 		}
 		if (!valid_prev_map) {
 			js_warning << "Player's previous map is not a valid PKMN Center Warp ID! We will reset it to one." << std::endl;
-			if (isFlagBitSet(it9, sym9.getPlayerDataAddress("wJohtoBadges"), PLAINBADGE)) {
+			if (isFlagBitSet(it9, sym::v9::wJohtoBadges_PlayerData, PLAINBADGE)) {
 				js_warning << "Player has the PLAINBADGE, the stairs will now take you to Goldenrod PKMN Center." << std::endl;
-				it9.setByte(sym9.getMapDataAddress("wBackupWarpNumber"), 4);
-				it9.setByte(sym9.getMapDataAddress("wBackupMapGroup"), GOLDENROD_POKECOM_CENTER_1F.first);
-				it9.setByte(sym9.getMapDataAddress("wBackupMapNumber"), GOLDENROD_POKECOM_CENTER_1F.second);
+				it9.setByte(sym::v9::wBackupWarpNumber_MapData, 4);
+				it9.setByte(sym::v9::wBackupMapGroup_MapData, GOLDENROD_POKECOM_CENTER_1F.first);
+				it9.setByte(sym::v9::wBackupMapNumber_MapData, GOLDENROD_POKECOM_CENTER_1F.second);
 			}
 			else {
 				js_warning << "Player does not have the PLAINBADGE, the stairs will now warp you to your house." << std::endl;
-				it9.setByte(sym9.getMapDataAddress("wBackupWarpNumber"), 3);
-				it9.setByte(sym9.getMapDataAddress("wBackupMapGroup"), PLAYERS_HOUSE_1F.first);
-				it9.setByte(sym9.getMapDataAddress("wBackupMapNumber"), PLAYERS_HOUSE_1F.second);
+				it9.setByte(sym::v9::wBackupWarpNumber_MapData, 3);
+				it9.setByte(sym::v9::wBackupMapGroup_MapData, PLAYERS_HOUSE_1F.first);
+				it9.setByte(sym::v9::wBackupMapNumber_MapData, PLAYERS_HOUSE_1F.second);
 			}
 		} else {
 			js_info << "Player's previous map is a valid PKMN Center warp ID. No need to fix the warp ID." << std::endl;
@@ -272,15 +178,15 @@ namespace patchVersion8to9Namespace {
 
 		// copy sGameData to sBackupGameData
 		js_info << "Copying sGameData to sBackupGameData..." << std::endl;
-		copyDataBlock(sd, sym9.getSRAMAddress("sGameData"), sym9.getSRAMAddress("sBackupGameData"), sym9.getSRAMAddress("sGameDataEnd") - sym9.getSRAMAddress("sGameData"));
+		copyDataBlock(sd, sym::v9::sGameData_SRAM, sym::v9::sBackupGameData_SRAM, sym::v9::sGameDataEnd_SRAM - sym::v9::sGameData_SRAM);
 
 		// write the new checksums to the version 9 save file
 		js_info << "Writing the new checksums" << std::endl;
-		uint16_t new_checksum = calculateSaveChecksum(save9, sym9.getSRAMAddress("sGameData"), sym9.getSRAMAddress("sGameDataEnd"));
+		uint16_t new_checksum = calculateSaveChecksum(save9, sym::v9::sGameData_SRAM, sym::v9::sGameDataEnd_SRAM);
 		save9.setWord(SAVE_CHECKSUM_ABS_ADDRESS, new_checksum);
 
 		// write new backup checksums to the version 9 save file
-		uint16_t new_backup_checksum = calculateSaveChecksum(save9, sym9.getSRAMAddress("sBackupGameData"), sym9.getSRAMAddress("sBackupGameDataEnd"));
+		uint16_t new_backup_checksum = calculateSaveChecksum(save9, sym::v9::sBackupGameData_SRAM, sym::v9::sBackupGameDataEnd_SRAM);
 		save9.setWord(SAVE_BACKUP_CHECKSUM_ABS_ADDRESS, new_backup_checksum);
 
 		js_info << "Sucessfully patched to 3.1.0 save version 9!" << std::endl;
@@ -290,7 +196,7 @@ namespace patchVersion8to9Namespace {
 
 	// Converts a version 7 event flag to a version 8 event flag
 	uint16_t mapV8EventFlagToV9(uint16_t v8) {
-		std::unordered_map<uint16_t, uint16_t> indexMap = {
+		static constexpr IndexMapEntry<uint16_t, uint16_t> entries[] = {
 				{0, 0},  // EVENT_TEMPORARY_UNTIL_MAP_RELOAD_1
 				{1, 1},  // EVENT_TEMPORARY_UNTIL_MAP_RELOAD_2
 				{2, 2},  // EVENT_TEMPORARY_UNTIL_MAP_RELOAD_3
@@ -2512,13 +2418,16 @@ namespace patchVersion8to9Namespace {
 				{2237, 2237},  // EVENT_VIOLET_CEMETERY_CARETAKER
 		};
 
+		static_assert(hasUniqueIndexes(entries) && isInjective(entries, INVALID_EVENT_FLAG), "version 8 event flags must convert one to one");
+		static constexpr IndexMap<uint16_t, uint16_t, indexMapSize(entries)> indexMap(entries, INVALID_EVENT_FLAG);
+
 		// Return the corresponding version 8 event flag or INVALID_EVENT_FLAG if not found
-		return indexMap.find(v8) != indexMap.end() ? indexMap[v8] : INVALID_EVENT_FLAG;
+		return indexMap(v8);
 	}
 
 	// converts a version 8 key item to a version 9 key item
 	uint8_t mapV8KeyItemToV9(uint8_t v8) {
-		std::unordered_map<uint8_t, uint8_t> indexMap = {
+		static constexpr IndexMapEntry<uint8_t, uint8_t> entries[] = {
 			{0x01, 0x01},  // BICYCLE
 			{0x02, 0x02},  // OLD_ROD
 			{0x03, 0x03},  // GOOD_ROD
@@ -2557,8 +2466,11 @@ namespace patchVersion8to9Namespace {
 			{0x24, 0x26},  // CATCH_CHARM
 		};
 
+		static_assert(hasUniqueIndexes(entries) && isInjective(entries, 0xFF), "version 8 key items must convert one to one");
+		static constexpr IndexMap<uint8_t, uint8_t, indexMapSize(entries)> indexMap(entries, 0xFF);
+
 		// return the corresponding version 8 key item or 0xFF if not found
-		return indexMap.find(v8) != indexMap.end() ? indexMap[v8] : 0xFF;
+		return indexMap(v8);
 	}
 
 }
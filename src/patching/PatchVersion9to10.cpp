@@ -1,22 +1,24 @@
 #include "patching/PatchVersion9to10.h"
 #include "core/CommonPatchFunctions.h"
 #include "core/SymbolDatabase.h"
+#include "core/IndexMap.h"
 #include "core/Logging.h"
-#include "core/SymbolDatabaseContents.h"
+#include "symbols/Version9Symbols.h"
+#include "symbols/Version10Symbols.h"
+#include <unordered_map>
 
 namespace patchVersion9to10Namespace {
 
 	bool patchVersion9to10(SaveBinary& save9, SaveBinary& save10) {
-		// copy the old save file to the new save file
-		save10 = save9;
-
 		// create the iterators
 		SaveBinary::Iterator it9(save9, 0);
 		SaveBinary::Iterator it10(save10, 0);
 
 		// Load the version 9 and 10 sym files
-		SymbolDatabase sym9(version9_sym_data, version9_sym_len);
-		SymbolDatabase sym10(version10_sym_data, version10_sym_len);
+		const SymbolDatabase& sym9 = SymbolDatabase::forVersion(9);
+		const SymbolDatabase& sym10 = SymbolDatabase::forVersion(10);
+		save9.setSymbols(&sym9);
+		save10.setSymbols(&sym10);
 
 		SourceDest sd = { it9, it10, sym9, sym10 };
 
@@ -24,7 +26,7 @@ namespace patchVersion9to10Namespace {
 		uint16_t save_checksum = save9.getWord(SAVE_CHECKSUM_ABS_ADDRESS);
 
 		// verify the checksum of the version 9 file matches the calculated checksum
-		uint16_t calculated_checksum = calculateSaveChecksum(save9, sym9.getSRAMAddress("sGameData"), sym9.getSRAMAddress("sGameDataEnd"));
+		uint16_t calculated_checksum = calculateSaveChecksum(save9, sym::v9::sGameData_SRAM, sym::v9::sGameDataEnd_SRAM);
 		if (save_checksum != calculated_checksum) {
 			js_error << "Checksum mismatch! Expected: " << std::hex << calculated_checksum << ", got: " << save_checksum << std::endl;
 			return false;
@@ -32,14 +34,17 @@ namespace patchVersion9to10Namespace {
 
 		// check the backup checksum word from the version 8 save file
 		uint16_t backup_checksum = save9.getWord(SAVE_BACKUP_CHECKSUM_ABS_ADDRESS);
-		uint16_t calculated_backup_checksum = calculateSaveChecksum(save9, sym9.getSRAMAddress("sBackupGameData"), sym9.getSRAMAddress("sBackupGameDataEnd"));
+		uint16_t calculated_backup_checksum = calculateSaveChecksum(save9, sym::v9::sBackupGameData_SRAM, sym::v9::sBackupGameDataEnd_SRAM);
 		if (backup_checksum != calculated_backup_checksum) {
 			js_error << "Backup checksum mismatch! Expected: " << std::hex << calculated_backup_checksum << ", got: " << backup_checksum << std::endl;
 			return false;
 		}
 
+		// keep the new save's checksums up to date as it is patched
+		trackGameDataChecksums(save10, sym10);
+
 		// check if the player is in the PKMN Center 2nd Floor
-		uint8_t map_group = it9.getByte(sym9.getMapDataAddress("wMapGroup"));
+		uint8_t map_group = it9.getByte(sym::v9::wMapGroup_MapData);
 		it9.next();
 		uint8_t map_num = it9.getByte();
 		if (map_group != MON_CENTER_2F_GROUP || map_num != MON_CENTER_2F_MAP) {
@@ -48,7 +53,7 @@ namespace patchVersion9to10Namespace {
 		}
 
 		js_info << "Patching text speed..." << std::endl;
-		uint8_t opt1_byte = it10.getByte(sym10.getOptionsAddress("wOptions1"));
+		uint8_t opt1_byte = it10.getByte(sym::v10::wOptions1_Options);
 		uint8_t originalBits = opt1_byte & TEXT_DELAY_MASK;
 		// write a case to print what is set
 		uint8_t reversedBits = TEXT_DELAY_MASK - originalBits;
@@ -81,18 +86,18 @@ namespace patchVersion9to10Namespace {
 			js_error << "Text speed is set to an invalid value." << std::endl;
 			return false;
 		}
-		it10.setByte(sym10.getOptionsAddress("wOptions1"), (opt1_byte & ~TEXT_DELAY_MASK) | reversedBits);
+		it10.setByte(sym::v10::wOptions1_Options, (opt1_byte & ~TEXT_DELAY_MASK) | reversedBits);
 
 		// Ensure the new NO_EXP_OPT bit in wInitialOptions2 is cleared by default
 		js_info << "Clearing NO_EXP_OPT in wInitialOptions2..." << std::endl;
-		it10.resetBit(sym10.getOptionsAddress("wInitialOptions2"), NO_EXP_OPT);
+		it10.resetBit(sym::v10::wInitialOptions2_Options, NO_EXP_OPT);
 
 		// Reset Initial Options so the game asks the player to set them again.
 		js_info << "Resetting Initial Options..." << std::endl;
 		it10.setBit(RESET_INIT_OPTS);
 
 		// check if wMagikarpRecordHoldersName is equal to Ralph@ (0x91, 0xa0, 0xab, 0xaf, 0xa7, 0x53)
-		it9.seek(sym9.getPokemonDataAddress("wMagikarpRecordHoldersName"));
+		it9.seek(sym::v9::wMagikarpRecordHoldersName_PokemonData);
 		bool isRalph = true;
 		for (size_t i = 0; i < sizeof(ralphName); i++) {
 			if (it9.getByte() != ralphName[i]) {
@@ -103,10 +108,10 @@ namespace patchVersion9to10Namespace {
 		}
 		if (isRalph) {
 			js_info << "Magikarp Record Holder's name is Ralph. Checking length..." << std::endl;
-			uint16_t magikarpLength = it9.getWordBE(sym9.getPokemonDataAddress("wBestMagikarpLengthMm"));
+			uint16_t magikarpLength = it9.getWordBE(sym::v9::wBestMagikarpLengthMm_PokemonData);
 			if (magikarpLength == 0x0306) {
 				js_info << "Magikarp Record Holder's length is 0x" << std::hex << magikarpLength << " patching to 0x042B" << std::endl;
-				it10.setWordBE(sym10.getPokemonDataAddress("wBestMagikarpLengthMm"), 0x042B);
+				it10.setWordBE(sym::v10::wBestMagikarpLengthMm_PokemonData, 0x042B);
 			} else {
 				js_info << "Magikarp Record Holder's length is 0x" << std::hex << magikarpLength << " not patching." << std::endl;
 			}
@@ -116,69 +121,69 @@ namespace patchVersion9to10Namespace {
 
 		// Clear v10 event flags
 		js_info << "Clearing v10 event flags..." << std::endl;
-		clearDataBlock(sd, sym10.getPlayerDataAddress("wEventFlags"), flag_array(NUM_EVENTS));
+		clearDataBlock(sd, sym::v10::wEventFlags_PlayerData, flag_array(NUM_EVENTS));
 
-		it10.seek(sym10.getPlayerDataAddress("wEventFlags"));
 		js_info << "Patching event flags..." << std::endl;
-		for (int i = 0; i < NUM_EVENTS; i++) {
-			// check if the bit is set
-			if (isFlagBitSet(it9, sym9.getPlayerDataAddress("wEventFlags"), i)) {
-				uint16_t eventFlagIndex = i;
-				uint16_t eventFlagIndexV10 = mapV9EventFlagToV10(eventFlagIndex);
-				if (eventFlagIndexV10 != INVALID_EVENT_FLAG) {
-					// set the bit in the new save file
-					setFlagBit(it10, sym10.getPlayerDataAddress("wEventFlags"), eventFlagIndexV10);
-					js_info << "Patching event flag " << std::dec << eventFlagIndex << " to " << std::dec << eventFlagIndexV10 << std::endl;
-				}
-				else {
-					js_warning << "Event flag " << eventFlagIndex << " not found in version 10 event flag list." << std::endl;
-				}
+		static const FlagRemap eventFlagRemap(NUM_EVENTS, NUM_EVENTS, [](uint32_t eventFlagIndex) {
+			uint16_t eventFlagIndexV10 = mapV9EventFlagToV10(eventFlagIndex);
+			return eventFlagIndexV10 != INVALID_EVENT_FLAG ? eventFlagIndexV10 : FlagRemap::DROPPED;
+		});
+		FlagArrayView eventFlags9(save9, sym::v9::wEventFlags_PlayerData, NUM_EVENTS);
+		FlagArrayView eventFlags10(sym::v10::wEventFlags_PlayerData, NUM_EVENTS);
+		eventFlagRemap.apply(eventFlags9, eventFlags10, [](uint32_t eventFlagIndex, uint32_t eventFlagIndexV10) {
+			if (eventFlagIndexV10 != FlagRemap::DROPPED) {
+				js_info << "Patching event flag " << std::dec << eventFlagIndex << " to " << std::dec << eventFlagIndexV10 << std::endl;
 			}
-		}
+			else {
+				js_warning << "Event flag " << eventFlagIndex << " not found in version 10 event flag list." << std::endl;
+			}
+		});
+		// set the bits in the new save file
+		eventFlags10.store(save10);
 
 		// Fix sPartyMail
 		mailmsg_struct_v10 mailmsg;
 		js_info << "Fixing sPartyMail..." << std::endl;
 		for (int i = 0; i < PARTY_LENGTH; i++) {
-			mailmsg = convertMailmsgV9toV10(loadStruct<mailmsg_struct_v10>(it9, sym9.getSRAMAddress("sPartyMail") + i * sizeof(mailmsg_struct_v10)));
-			writeStruct<mailmsg_struct_v10>(it10, sym10.getSRAMAddress("sPartyMail") + i * sizeof(mailmsg_struct_v10), mailmsg);
+			mailmsg = convertMailmsgV9toV10(*StructView<mailmsg_struct_v10>(save9, sym::v9::sPartyMail_SRAM + i * sizeof(mailmsg_struct_v10)));
+			StructRef<mailmsg_struct_v10>(save10, sym::v10::sPartyMail_SRAM + i * sizeof(mailmsg_struct_v10)).store(mailmsg);
 		}
 
 		// Fix sPartyMailBackup
 		js_info << "Fixing sPartyMailBackup..." << std::endl;
 		for (int i = 0; i < PARTY_LENGTH; i++) {
-			mailmsg = convertMailmsgV9toV10(loadStruct<mailmsg_struct_v10>(it9, sym9.getSRAMAddress("sPartyMailBackup") + i * sizeof(mailmsg_struct_v10)));
-			writeStruct<mailmsg_struct_v10>(it10, sym10.getSRAMAddress("sPartyMailBackup") + i * sizeof(mailmsg_struct_v10), mailmsg);
+			mailmsg = convertMailmsgV9toV10(*StructView<mailmsg_struct_v10>(save9, sym::v9::sPartyMailBackup_SRAM + i * sizeof(mailmsg_struct_v10)));
+			StructRef<mailmsg_struct_v10>(save10, sym::v10::sPartyMailBackup_SRAM + i * sizeof(mailmsg_struct_v10)).store(mailmsg);
 		}
 
 		// Fix sMailbox
 		js_info << "Fixing sMailbox..." << std::endl;
 		for (int i = 0; i < MAILBOX_CAPACITY; i++) {
-			mailmsg = convertMailmsgV9toV10(loadStruct<mailmsg_struct_v10>(it9, sym9.getSRAMAddress("sMailbox") + i * sizeof(mailmsg_struct_v10)));
-			writeStruct<mailmsg_struct_v10>(it10, sym10.getSRAMAddress("sMailbox") + i * sizeof(mailmsg_struct_v10), mailmsg);
+			mailmsg = convertMailmsgV9toV10(*StructView<mailmsg_struct_v10>(save9, sym::v9::sMailbox_SRAM + i * sizeof(mailmsg_struct_v10)));
+			StructRef<mailmsg_struct_v10>(save10, sym::v10::sMailbox_SRAM + i * sizeof(mailmsg_struct_v10)).store(mailmsg);
 		}
 
 		// Fix sMailboxBackup
 		js_info << "Fixing sMailboxBackup..." << std::endl;
 		for (int i = 0; i < MAILBOX_CAPACITY; i++) {
-			mailmsg = convertMailmsgV9toV10(loadStruct<mailmsg_struct_v10>(it9, sym9.getSRAMAddress("sMailboxBackup") + i * sizeof(mailmsg_struct_v10)));
-			writeStruct<mailmsg_struct_v10>(it10, sym10.getSRAMAddress("sMailboxBackup") + i * sizeof(mailmsg_struct_v10), mailmsg);
+			mailmsg = convertMailmsgV9toV10(*StructView<mailmsg_struct_v10>(save9, sym::v9::sMailboxBackup_SRAM + i * sizeof(mailmsg_struct_v10)));
+			StructRef<mailmsg_struct_v10>(save10, sym::v10::sMailboxBackup_SRAM + i * sizeof(mailmsg_struct_v10)).store(mailmsg);
 		}
 
 		// set v10 wCurMapSceneScriptCount and wCurMapCallbackCount to 0
 		// set v10 wCurMapSceneScriptPointer word to 0
 		// this is done to prevent the game from running any map scripts on load
 		js_info << "Set wCurMapSceneScriptCount and wCurMapCallbackCount to 0..." << std::endl;
-		it10.seek(sym10.getPlayerDataAddress("wCurMapSceneScriptCount"));
+		it10.seek(sym::v10::wCurMapSceneScriptCount_PlayerData);
 		it10.setByte(0);
-		it10.seek(sym10.getPlayerDataAddress("wCurMapCallbackCount"));
+		it10.seek(sym::v10::wCurMapCallbackCount_PlayerData);
 		it10.setByte(0);
 		js_info << "Set wCurMapSceneScriptPointer to 0..." << std::endl;
-		it10.seek(sym10.getPlayerDataAddress("wCurMapSceneScriptPointer"));
+		it10.seek(sym::v10::wCurMapSceneScriptPointer_PlayerData);
 		it10.setWord(0);
 
-		uint8_t prev_map_group = it10.getByte(sym10.getMapDataAddress("wBackupMapGroup"));
-		uint8_t prev_map_num = it10.getByte(sym10.getMapDataAddress("wBackupMapNumber"));
+		uint8_t prev_map_group = it10.getByte(sym::v10::wBackupMapGroup_MapData);
+		uint8_t prev_map_num = it10.getByte(sym::v10::wBackupMapNumber_MapData);
 		// check if the previous map is a valid PC warp ID in the validPCWarpIDs array
 		bool valid_prev_map = false;
 		for (auto& validPCWarpID : validPCWarpIDs) {
@@ -189,17 +194,17 @@ namespace patchVersion9to10Namespace {
 		}
 		if (!valid_prev_map) {
 			js_warning << "Player's previous map is not a valid PKMN Center Warp ID! We will reset it to one." << std::endl;
-			if (isFlagBitSet(it10, sym10.getPlayerDataAddress("wJohtoBadges"), PLAINBADGE)) {
+			if (isFlagBitSet(it10, sym::v10::wJohtoBadges_PlayerData, PLAINBADGE)) {
 				js_warning << "Player has the PLAINBADGE, the stairs will now take you to Goldenrod PKMN Center." << std::endl;
-				it10.setByte(sym10.getMapDataAddress("wBackupWarpNumber"), 4);
-				it10.setByte(sym10.getMapDataAddress("wBackupMapGroup"), GOLDENROD_POKECOM_CENTER_1F.first);
-				it10.setByte(sym10.getMapDataAddress("wBackupMapNumber"), GOLDENROD_POKECOM_CENTER_1F.second);
+				it10.setByte(sym::v10::wBackupWarpNumber_MapData, 4);
+				it10.setByte(sym::v10::wBackupMapGroup_MapData, GOLDENROD_POKECOM_CENTER_1F.first);
+				it10.setByte(sym::v10::wBackupMapNumber_MapData, GOLDENROD_POKECOM_CENTER_1F.second);
 			}
 			else {
 				js_warning << "Player does not have the PLAINBADGE, the stairs will now warp you to your house." << std::endl;
-				it10.setByte(sym10.getMapDataAddress("wBackupWarpNumber"), 3);
-				it10.setByte(sym10.getMapDataAddress("wBackupMapGroup"), PLAYERS_HOUSE_1F.first);
-				it10.setByte(sym10.getMapDataAddress("wBackupMapNumber"), PLAYERS_HOUSE_1F.second);
+				it10.setByte(sym::v10::wBackupWarpNumber_MapData, 3);
+				it10.setByte(sym::v10::wBackupMapGroup_MapData, PLAYERS_HOUSE_1F.first);
+				it10.setByte(sym::v10::wBackupMapNumber_MapData, PLAYERS_HOUSE_1F.second);
 			}
 		} else {
 			js_info << "Player's previous map is a valid PKMN Center warp ID. No need to fix the warp ID." << std::endl;
@@ -212,15 +217,15 @@ namespace patchVersion9to10Namespace {
 
 		// copy sGameData to sBackupGameData
 		js_info << "Copying sGameData to sBackupGameData..." << std::endl;
-		copyDataBlock(sd, sym10.getSRAMAddress("sGameData"), sym10.getSRAMAddress("sBackupGameData"), sym10.getSRAMAddress("sGameDataEnd") - sym10.getSRAMAddress("sGameData"));
+		copyDataBlock(sd, sym::v10::sGameData_SRAM, sym::v10::sBackupGameData_SRAM, sym::v10::sGameDataEnd_SRAM - sym::v10::sGameData_SRAM);
 
 		// write the new checksums to the version 10 save file
 		js_info << "Writing new checksums..." << std::endl;
-		uint16_t new_checksum = calculateSaveChecksum(save10, sym10.getSRAMAddress("sGameData"), sym10.getSRAMAddress("sGameDataEnd"));
+		uint16_t new_checksum = calculateSaveChecksum(save10, sym::v10::sGameData_SRAM, sym::v10::sGameDataEnd_SRAM);
 		save10.setWord(SAVE_CHECKSUM_ABS_ADDRESS, new_checksum);
 
 		// write the new backup checksum to the version 10 save file
-		uint16_t new_backup_checksum = calculateSaveChecksum(save10, sym10.getSRAMAddress("sBackupGameData"), sym10.getSRAMAddress("sBackupGameDataEnd"));
+		uint16_t new_backup_checksum = calculateSaveChecksum(save10, sym::v10::sBackupGameData_SRAM, sym::v10::sBackupGameDataEnd_SRAM);
 		save10.setWord(SAVE_BACKUP_CHECKSUM_ABS_ADDRESS, new_backup_checksum);
 
 		js_info << "Successfully patched version 9 save file to version 10." << std::endl;
@@ -229,7 +234,7 @@ namespace patchVersion9to10Namespace {
 
 	// Converts a version 7 event flag to a version 8 event flag
 	uint16_t mapV9EventFlagToV10(uint16_t v9) {
-		std::unordered_map<uint16_t, uint16_t> indexMap = {
+		static constexpr IndexMapEntry<uint16_t, uint16_t> entries[] = {
 				{0, 0},  // EVENT_TEMPORARY_UNTIL_MAP_RELOAD_1
 				{1, 1},  // EVENT_TEMPORARY_UNTIL_MAP_RELOAD_2
 				{2, 2},  // EVENT_TEMPORARY_UNTIL_MAP_RELOAD_3
@@ -2484,8 +2489,11 @@ namespace patchVersion9to10Namespace {
 				{2272, 1174},  // EVENT_BEAT_RICH_BOY_TOBIN
 		};
 
+		static_assert(hasUniqueIndexes(entries) && isInjective(entries, INVALID_EVENT_FLAG), "version 9 event flags must convert one to one");
+		static constexpr IndexMap<uint16_t, uint16_t, indexMapSize(entries)> indexMap(entries, INVALID_EVENT_FLAG);
+
 		// Return the corresponding version 8 event flag or INVALID_EVENT_FLAG if not found
-		return indexMap.find(v9) != indexMap.end() ? indexMap[v9] : INVALID_EVENT_FLAG;
+		return indexMap(v9);
 	}
 
 	mailmsg_struct_v10 convertMailmsgV9toV10(const mailmsg_struct_v10& mailmsg) {
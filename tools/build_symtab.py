@@ -0,0 +1,149 @@
+import re
+import struct
+import sys
+
+# Binary symbol tables read by SymbolDatabase (see include/core/SymbolDatabase.h).
+# The names of every version are interned once in a shared name pool, and each version
+# has a table of fixed-width records indexed by name id. All fields are little endian.
+#
+# Name pool
+#   header   magic "PSYN", uint16 format version, uint16 reserved,
+#            uint32 name count, uint32 family count, uint32 offset of the families,
+#            uint32 offset of the strings
+#   names    one entry per name id, sorted by name:
+#            uint32 string offset (into the strings), uint8 name length
+#   families one fixed-width record per family of numbered symbols, sorted by pattern:
+#            uint32 pattern offset (into the strings), uint32 offset of the members,
+#            uint16 member count, uint8 first number, uint8 pattern length
+#   members  for each family, the name id of every number from the first on
+#            (uint32, NO_MEMBER where the number is missing)
+#   strings  the names and family patterns back to back, without terminators
+#
+# Version table
+#   header   magic "PSYM", uint16 format version, uint16 reserved,
+#            uint32 record count (the pool's name count), uint32 FNV-1a hash of the pool
+#   records  one record per name id: uint16 address, uint8 bank, uint8 flags
+#            (SYMBOL_DEFINED if the version has the symbol)
+POOL_MAGIC = b"PSYN"
+POOL_VERSION = 1
+POOL_HEADER_FORMAT = "<4sHHIIII"
+NAME_FORMAT = "<IB"
+SYMTAB_MAGIC = b"PSYM"
+SYMTAB_VERSION = 3
+HEADER_FORMAT = "<4sHHII"
+RECORD_FORMAT = "<HBB"
+FAMILY_FORMAT = "<IIHBB"
+MEMBER_FORMAT = "<I"
+NO_MEMBER = 0xFFFFFFFF
+SYMBOL_DEFINED = 0x01
+
+# a family groups the names with a single run of digits, e.g. sNewBox1Name, sNewBox2Name, ...
+# under the pattern sNewBox#Name (same rule as the text scanner in SymbolDatabase.cpp)
+FAMILY_NAME = re.compile(rb"([^0-9]*)(0|[1-9][0-9]{0,2})([^0-9]*)")
+MAX_FAMILY_NUMBER = 0xFF
+
+# same grammar as the text scanner in SymbolDatabase.cpp: "BB:AAAA Name"
+SYMBOL_LINE = re.compile(rb"([0-9A-Fa-f]{2}):([0-9A-Fa-f]{4})[ \t\v\f\r]([A-Za-z0-9_.]+)")
+
+def parse_sym_file(input_sym):
+    """Parse a .sym file into a {name: (bank, address)} dict, later lines win."""
+    symbols = {}
+    with open(input_sym, 'rb') as f_in:
+        for line in f_in.read().split(b"\n"):
+            if line.endswith(b"\r"):
+                line = line[:-1]
+            match = SYMBOL_LINE.fullmatch(line)
+            if not match:
+                continue
+            name = match.group(3)
+            if len(name) > 0xFF:
+                raise ValueError(f"Symbol name too long: {name.decode()}")
+            symbols[name] = (int(match.group(1), 16), int(match.group(2), 16))
+    return symbols
+
+def fnv1a(data):
+    """32-bit FNV-1a hash, tying a version table to the pool it was built against."""
+    value = 0x811C9DC5
+    for byte in data:
+        value = ((value ^ byte) * 0x01000193) & 0xFFFFFFFF
+    return value
+
+def find_families(names):
+    """Group the sorted names into {pattern: {number: name id}}, keeping groups of two or more."""
+    families = {}
+    for index, name in enumerate(names):
+        match = FAMILY_NAME.fullmatch(name)
+        if not match or int(match.group(2)) > MAX_FAMILY_NUMBER:
+            continue
+        pattern = match.group(1) + b"#" + match.group(3)
+        families.setdefault(pattern, {})[int(match.group(2))] = index
+    return {pattern: members for pattern, members in families.items() if len(members) > 1}
+
+def pool_names(versions):
+    """The sorted names of every version's symbols, each name's id is its index."""
+    names = set()
+    for symbols in versions:
+        names.update(symbols)
+    return sorted(names)
+
+def build_pool(names):
+    """Build the shared name pool for the sorted names."""
+    families = find_families(names)
+    patterns = sorted(families)
+    header_size = struct.calcsize(POOL_HEADER_FORMAT)
+    family_offset = header_size + struct.calcsize(NAME_FORMAT) * len(names)
+    members_offset = family_offset + struct.calcsize(FAMILY_FORMAT) * len(patterns)
+
+    entries = bytearray()
+    strings = bytearray()
+    for name in names:
+        entries += struct.pack(NAME_FORMAT, len(strings), len(name))
+        strings += name
+
+    family_records = bytearray()
+    members = bytearray()
+    for pattern in patterns:
+        numbers = families[pattern]
+        first = min(numbers)
+        count = max(numbers) - first + 1
+        family_records += struct.pack(FAMILY_FORMAT, len(strings), members_offset + len(members), count, first, len(pattern))
+        for number in range(first, first + count):
+            members += struct.pack(MEMBER_FORMAT, numbers.get(number, NO_MEMBER))
+        strings += pattern
+
+    strings_offset = members_offset + len(members)
+    header = struct.pack(POOL_HEADER_FORMAT, POOL_MAGIC, POOL_VERSION, 0, len(names), len(patterns), family_offset, strings_offset)
+    return header + entries + family_records + members + strings
+
+def build_symtab(symbols, names, pool):
+    """Build the version table for the given symbols against the pool of names."""
+    records = bytearray()
+    for name in names:
+        bank, address = symbols.get(name, (0, 0))
+        records += struct.pack(RECORD_FORMAT, address, bank, SYMBOL_DEFINED if name in symbols else 0)
+    header = struct.pack(HEADER_FORMAT, SYMTAB_MAGIC, SYMTAB_VERSION, 0, len(names), fnv1a(pool))
+    return header + records
+
+def main():
+    """
+    Usage:
+        python build_symtab.py --pool <output.pool> <all versions' .sym...>
+        python build_symtab.py <input.sym> <output.symtab> <all versions' .sym...>
+    Both forms must list the same .sym files so the tables match the pool.
+    """
+    if len(sys.argv) < 4:
+        print("Usage: python build_symtab.py --pool <output.pool> <all versions' .sym...>")
+        print("       python build_symtab.py <input.sym> <output.symtab> <all versions' .sym...>")
+        sys.exit(1)
+
+    names = pool_names(parse_sym_file(path) for path in sys.argv[3:])
+    pool = build_pool(names)
+    if sys.argv[1] == "--pool":
+        output = pool
+    else:
+        output = build_symtab(parse_sym_file(sys.argv[1]), names, pool)
+    with open(sys.argv[2], 'wb') as f_out:
+        f_out.write(output)
+
+if __name__ == "__main__":
+    main()
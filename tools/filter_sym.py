@@ -18,34 +18,81 @@ def extract_strings_from_cpp(cpp_dirs):
                             strings.add(match)
     return strings
 
-def line_matches_exception(line):
-    """Check if the line matches any of the exception patterns."""
-    exception_patterns = [
-        r"sNewBox\d+",  # Matches sNewBox# where # is 1-20
-        r"sNewBox\d+Name",  # Matches sNewBox#Name where # is 1-20
-        r"sNewBox\d+Theme",  # Matches sNewBox#Theme where # is 1-20
-        r"sBackupNewBox\d+",  # Matches sBackupNewBox# where # is 1-20
-        r"sBackupNewBox\d+Name",  # Matches sBackupNewBox#Name where # is 1-20
-        r"sBackupNewBox\d+Theme",  # Matches sBackupNewBox#Theme where # is 1-20
-        r"wObject\d+Struct"  # Matches wObject#Struct where # is 1-12
-    ]
-    for pattern in exception_patterns:
-        if re.search(pattern, line):
-            return True
-    return False
-
-def filter_sym_file(input_sym, valid_strings, output_sym_filtered):
-    """Filter lines in input_sym so that only labels present in valid_strings or exceptions remain."""
+def family_patterns(valid_strings):
+    """Compile the symbol family patterns (e.g. "sNewBox#Name") among valid_strings.
+
+    A family pattern keeps every numbered member, e.g. sNewBox1Name to sNewBox20Name.
+    """
+    patterns = []
+    for string in valid_strings:
+        if "#" in string and re.fullmatch(r"[A-Za-z0-9_.]*#[A-Za-z0-9_.]*", string):
+            prefix, suffix = string.split("#")
+            patterns.append(re.compile(re.escape(prefix) + r"\d+" + re.escape(suffix)))
+    return patterns
+
+def line_matches_family(label, patterns):
+    """Check if the label is a member of any of the family patterns."""
+    return any(pattern.fullmatch(label) for pattern in patterns)
+
+# the wram data saved to sram, as (start, end) symbols (see SymbolDatabase::SaveBlock)
+SAVE_BLOCKS = [
+    ("wOptions", "wOptionsEnd"),
+    ("wPlayerData", "wPlayerDataEnd"),
+    ("wCurMapData", "wCurMapDataEnd"),
+    ("wPokemonData", "wPokemonDataEnd"),
+]
+SRAM_START_ADDRESS = 0xA000
+WRAM0_START_ADDRESS = 0xC000
+
+def parse_address(address_part):
+    """Parse "BB:AAAA" into (bank, address), None if malformed."""
+    match = re.fullmatch(r"([0-9A-Fa-f]{2}):([0-9A-Fa-f]{4})", address_part)
+    return (int(match.group(1), 16), int(match.group(2), 16)) if match else None
+
+def save_block_ranges(symbols):
+    """The (bank, start, end) wram ranges saved to sram, for the blocks whose symbols are all present."""
+    ranges = []
+    for start, end in SAVE_BLOCKS:
+        if start in symbols and end in symbols:
+            ranges.append((symbols[start][0], symbols[start][1], symbols[end][1]))
+    return ranges
+
+def is_save_layout_label(label, bank_address, block_ranges):
+    """Check if the label names a part of the save layout SymbolDatabase's reverse index reports.
+
+    Those are the sram labels and the wram labels saved to a save block, leaving out local labels
+    and per-entry fields (labels with more than one number, e.g. sBoxMons1AMon12Species).
+    """
+    if "." in label or len(re.findall(r"[0-9]+", label)) > 1:
+        return False
+    bank, address = bank_address
+    if SRAM_START_ADDRESS <= address < WRAM0_START_ADDRESS:
+        return True
+    return any(bank == block_bank and start <= address < end for block_bank, start, end in block_ranges)
+
+def filter_sym_file(input_sym, valid_strings, output_sym_filtered, keep_save_layout=False):
+    """Filter lines in input_sym so that only labels present in valid_strings or their families,
+    and the labels of the save layout if keep_save_layout is set, remain."""
+    patterns = family_patterns(valid_strings)
     with open(input_sym, 'r', encoding='utf-8') as f_in:
         lines = f_in.readlines()
 
+    symbols = {}
+    for line in lines:
+        parts = line.strip().split(maxsplit=1)
+        if len(parts) == 2 and parse_address(parts[0]) is not None:
+            symbols[parts[1]] = parse_address(parts[0])
+    block_ranges = save_block_ranges(symbols)
+
     filtered_lines = []
     for line in lines:
         parts = line.strip().split(maxsplit=1)
         # Expect something like "00:0000 Label"
         if len(parts) == 2:
             address_part, label_part = parts
-            if label_part in valid_strings or line_matches_exception(label_part):
+            bank_address = parse_address(address_part)
+            if label_part in valid_strings or line_matches_family(label_part, patterns) or \
+                    (keep_save_layout and bank_address is not None and is_save_layout_label(label_part, bank_address, block_ranges)):
                 filtered_lines.append(line)
 
     # Write to output
@@ -55,14 +102,19 @@ def filter_sym_file(input_sym, valid_strings, output_sym_filtered):
 def main():
     """
     Usage:
-        python filter_sym.py <input.sym> <output.sym.filtered>
+        python filter_sym.py [--save-layout] <input.sym> <output.sym.filtered>
+    --save-layout also keeps the labels of the save layout, so addresses can be reported by name.
     """
-    if len(sys.argv) != 3:
-        print("Usage: python filter_sym.py <input.sym> <output.sym.filtered>")
+    args = sys.argv[1:]
+    keep_save_layout = len(args) > 0 and args[0] == "--save-layout"
+    if keep_save_layout:
+        args = args[1:]
+    if len(args) != 2:
+        print("Usage: python filter_sym.py [--save-layout] <input.sym> <output.sym.filtered>")
         sys.exit(1)
 
-    input_sym = sys.argv[1]
-    output_sym_filtered = sys.argv[2]
+    input_sym = args[0]
+    output_sym_filtered = args[1]
 
     # Directories containing the .cpp files whose string literals we want to allow
     cpp_dirs = ["src/patching", "src/core"]
@@ -71,7 +123,7 @@ def main():
     valid_strings = extract_strings_from_cpp(cpp_dirs)
 
     # Filter the symbol file
-    filter_sym_file(input_sym, valid_strings, output_sym_filtered)
+    filter_sym_file(input_sym, valid_strings, output_sym_filtered, keep_save_layout)
 
 if __name__ == "__main__":
     main()
@@ -0,0 +1,121 @@
+import os
+import re
+import sys
+
+from build_symtab import parse_sym_file
+
+# Generates a header of constexpr save addresses for one version, e.g. sym::v9::sGameData_SRAM.
+# Only the constants the sources reference (sym::vN::<symbol>_<kind>) are emitted, and each
+# one is computed the same way as the matching SymbolDatabase lookup:
+#   <symbol>_SRAM         getSRAMAddress
+#   <symbol>_Options      getOptionsAddress
+#   <symbol>_PlayerData   getPlayerDataAddress
+#   <symbol>_MapData      getMapDataAddress
+#   <symbol>_PokemonData  getPokemonDataAddress
+# A constant that can't be computed (unknown symbol, wrong memory region) fails the build.
+
+SRAM_START_ADDRESS = 0xA000
+SRAM_BANK_SIZE = 0x2000
+WRAM0_START_ADDRESS = 0xC000
+ECHO_WRAM_START_ADDRESS = 0xE000
+
+# kind: (wram base symbol, sram base symbol)
+WRAM_KINDS = {
+    "Options": ("wOptions", "sOptions"),
+    "PlayerData": ("wPlayerData", "sPlayerData"),
+    "MapData": ("wCurMapData", "sMapData"),
+    "PokemonData": ("wPokemonData", "sPokemonData"),
+}
+
+def find_referenced_constants(version, cpp_dirs):
+    """Find every sym::v<version>::<symbol>_<kind> referenced by the .cpp and .h files under cpp_dirs."""
+    pattern = re.compile(r"\bsym::v%d::(\w+)_(SRAM|%s)\b" % (version, "|".join(WRAM_KINDS)))
+    constants = set()
+    for cpp_dir in cpp_dirs:
+        for root, _, files in os.walk(cpp_dir):
+            for file in files:
+                if file.endswith((".cpp", ".h")):
+                    with open(os.path.join(root, file), 'r', encoding='utf-8', errors='replace') as f:
+                        constants.update(pattern.findall(f.read()))
+    return constants
+
+def sram_address(symbols, name):
+    """Absolute SRAM address of name, or None if it isn't an SRAM symbol."""
+    if name not in symbols:
+        return None
+    bank, address = symbols[name]
+    if not SRAM_START_ADDRESS <= address < WRAM0_START_ADDRESS:
+        return None
+    return bank * SRAM_BANK_SIZE + address - SRAM_START_ADDRESS
+
+def wram_to_sram_address(symbols, name, kind):
+    """SRAM address of the WRAM symbol name within the block saved from the kind's base symbol."""
+    wram_base, sram_base = WRAM_KINDS[kind]
+    if name not in symbols or wram_base not in symbols:
+        return None
+    address = symbols[name][1]
+    if not WRAM0_START_ADDRESS <= address < ECHO_WRAM_START_ADDRESS:
+        return None
+    distance = address - symbols[wram_base][1]
+    base = sram_address(symbols, sram_base)
+    if distance < 0 or base is None:
+        return None
+    return base + distance
+
+def main():
+    """
+    Usage:
+        python gen_sym_headers.py <version> <input.sym> <output.h>
+    """
+    if len(sys.argv) != 4:
+        print("Usage: python gen_sym_headers.py <version> <input.sym> <output.h>")
+        sys.exit(1)
+
+    version = int(sys.argv[1])
+    input_sym = sys.argv[2]
+    output_header = sys.argv[3]
+
+    # Directories containing the sources that may reference the constants
+    cpp_dirs = ["src", "include"]
+
+    symbols = {name.decode(): value for name, value in parse_sym_file(input_sym).items()}
+    lines = []
+    errors = []
+    for name, kind in sorted(find_referenced_constants(version, cpp_dirs)):
+        if kind == "SRAM":
+            value = sram_address(symbols, name)
+        else:
+            value = wram_to_sram_address(symbols, name, kind)
+        if value is None:
+            errors.append(f"{input_sym}: can't compute sym::v{version}::{name}_{kind}")
+            continue
+        lines.append(f"\tconstexpr uint32_t {name}_{kind} = 0x{value:X};\n")
+
+    if errors:
+        for error in errors:
+            print(error, file=sys.stderr)
+        sys.exit(1)
+
+    guard = f"VERSION{version}SYMBOLS_H"
+    content = (
+        f"// generated by tools/gen_sym_headers.py from {input_sym}, do not edit\n"
+        f"#ifndef {guard}\n"
+        f"#define {guard}\n\n"
+        "#include <cstdint>\n\n"
+        f"namespace sym::v{version} {{\n"
+        + "".join(lines) +
+        "}\n\n"
+        "#endif\n"
+    )
+
+    # only touch the header when it changes so the sources including it aren't rebuilt
+    if os.path.exists(output_header):
+        with open(output_header, 'r', encoding='utf-8') as f_in:
+            if f_in.read() == content:
+                return
+    os.makedirs(os.path.dirname(output_header), exist_ok=True)
+    with open(output_header, 'w', encoding='utf-8') as f_out:
+        f_out.write(content)
+
+if __name__ == "__main__":
+    main()
@@ -70,16 +70,18 @@ def main(branch1, branch2, repo_url='https://github.com/Rangi42/polishedcrystal.
 			for index, event in sorted(diff, key=lambda x: x[0]):
 				print(f"{index}: {event}")
 		else:
-			# Print unordered map of matching events
+			# Print the index map of matching events
 			mapping = map_matching_events(events1, events2)
 			print("// Converts a version 7 event flag to a version 8 event flag")
 			print("uint16_t mapV7EventFlagToV8(uint16_t v7) {")
-			print("\tstd::unordered_map<uint16_t, uint16_t> indexMap = {")
+			print("\tstatic constexpr IndexMapEntry<uint16_t, uint16_t> entries[] = {")
 			for index1, index2, event_name in mapping:
 				print(f"\t\t{{{index1}, {index2}}},  // {event_name}")
 			print("\t};\n")
+			print("\tstatic_assert(hasUniqueIndexes(entries) && isInjective(entries, INVALID_EVENT_FLAG), \"version 7 event flags must convert one to one\");")
+			print("\tstatic constexpr IndexMap<uint16_t, uint16_t, indexMapSize(entries)> indexMap(entries, INVALID_EVENT_FLAG);\n")
 			print("\t// Return the corresponding version 8 event flag or INVALID_EVENT_FLAG if not found")
-			print("\treturn indexMap.find(v7) != indexMap.end() ? indexMap[v7] : INVALID_EVENT_FLAG;")
+			print("\treturn indexMap(v7);")
 			print("}")
 
 if __name__ == "__main__":
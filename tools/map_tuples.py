@@ -48,7 +48,7 @@ def print_matching_tuples(matching_tuples, output_format):
 		group_count1, map_count1, map_name1 = tuple1
 		group_count2, map_count2, map_name2 = tuple2
 		
-		if output_format == 'unordered_map':
+		if output_format == 'index_map':
 			print(f"{{{{{group_count1}, {map_count1}}}, {{{group_count2}, {map_count2}}}}},  // {map_name1}")
 		else:
 			print(f"Branch 1: {tuple1} | Branch 2: {tuple2}")
@@ -73,8 +73,8 @@ def main(branch1, branch2, output_format='default', repo_url='https://github.com
 if __name__ == "__main__":
 	import sys
 	if len(sys.argv) < 3 or len(sys.argv) > 4:
-		print("Usage: python map_tuples.py <branch1> <branch2> [unordered_map]")
+		print("Usage: python map_tuples.py <branch1> <branch2> [index_map]")
 	else:
 		# Determine the output format based on the third argument
-		output_format = 'unordered_map' if len(sys.argv) == 4 and sys.argv[3] == 'unordered_map' else 'default'
+		output_format = 'index_map' if len(sys.argv) == 4 and sys.argv[3] == 'index_map' else 'default'
 		main(sys.argv[1], sys.argv[2], output_format)